@@ -6,6 +6,7 @@ option(
   "Use shared (DLL) run-time lib even when Google Test is built as static lib."
   ON)
 
+if (EXISTS ${CMAKE_SOURCE_DIR}/3rdParty/gtest/CMakeLists.txt)
   add_subdirectory(${CMAKE_SOURCE_DIR}/3rdParty/gtest)
 
 
@@ -13,6 +14,12 @@ option(
   set_target_properties(gtest_main PROPERTIES FOLDER extern)
   set_target_properties(gmock PROPERTIES FOLDER extern)
   set_target_properties(gmock_main PROPERTIES FOLDER extern)
+  set(PHI_GTEST_LIBRARIES gmock_main gtest)
+else()
+  # Submodule not checked out: use an installed GoogleTest.
+  find_package(GTest CONFIG REQUIRED)
+  set(PHI_GTEST_LIBRARIES GTest::gmock_main GTest::gtest)
+endif()
 
 function(phi_add_gtest TEST_TARGET)
   cmake_parse_arguments(
@@ -25,8 +32,7 @@ function(phi_add_gtest TEST_TARGET)
   phi_add_executable(${TEST_TARGET} SOURCES ${PHI_SOURCES})
   target_link_libraries(${TEST_TARGET}  
                               PRIVATE
-                              gmock_main 
-                              gtest
+                              ${PHI_GTEST_LIBRARIES}
                             )
   add_custom_command(
         TARGET ${TEST_TARGET}
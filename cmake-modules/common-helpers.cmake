@@ -1,3 +1,6 @@
+# Formatting is skipped when clang-format is not installed.
+find_program(PHI_CLANG_FORMAT clang-format)
+
 function(phi_add_asset_to_target PHI_TARGET)
     cmake_parse_arguments(
         PHI
@@ -48,13 +51,15 @@ function(phi_add_executable PHI_TARGET)
     endif()
 
     # Run clang-format as pre-build event.    
-    add_custom_command(
-        TARGET ${PHI_TARGET}
-        PRE_BUILD
-        COMMAND clang-format -i -style=file ${PHI_SOURCES}
-        WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
-        COMMENT "Formatting target ${PHI_TARGET}"
-    )
+    if (PHI_CLANG_FORMAT)
+        add_custom_command(
+            TARGET ${PHI_TARGET}
+            PRE_BUILD
+            COMMAND ${PHI_CLANG_FORMAT} -i -style=file ${PHI_SOURCES}
+            WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+            COMMENT "Formatting target ${PHI_TARGET}"
+        )
+    endif()
 endfunction()
 
 ############################################
@@ -81,12 +86,14 @@ function(phi_add_library PHI_TARGET)
     endif()
 
     # Run clang-format as pre-build event.    
-    add_custom_command(
-        TARGET ${PHI_TARGET}
-        PRE_BUILD
-        COMMAND clang-format -i -style=file ${PHI_SOURCES}
-        WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
-        COMMENT "Formatting target ${PHI_TARGET}"
-    )
+    if (PHI_CLANG_FORMAT)
+        add_custom_command(
+            TARGET ${PHI_TARGET}
+            PRE_BUILD
+            COMMAND ${PHI_CLANG_FORMAT} -i -style=file ${PHI_SOURCES}
+            WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+            COMMENT "Formatting target ${PHI_TARGET}"
+        )
+    endif()
 endfunction()
 
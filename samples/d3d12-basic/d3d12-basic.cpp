@@ -6,6 +6,7 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "core/logger.h"
 #include "d3dcompiler.h"
@@ -364,17 +365,20 @@ void D3D12Basic::InitializeResources()
     renderer::MeshData meshData = renderer::CreateEquilateralTriangle(1);
 
     auto const vertexBufferSize = static_cast<uint32_t>(meshData.vertices.size() * meshData.PerVertexDataSize());
-    auto const indexBufferSize  = static_cast<uint32_t>(meshData.indices.size() * meshData.IndexDataSize());
+    auto const indexBufferSize  = static_cast<uint32_t>(meshData.IndexBufferSize());
+
+    std::vector<uint8_t> indexData(indexBufferSize);
+    meshData.WriteIndices(indexData.data());
 
     std::tie(mMeshBuffers->vertexBufferGPU, mMeshBuffers->vertexBufferUploadHeap) =
         graphics::CreateDefaultBuffer(mD3D12Device, mGraphicsCommandList, meshData.vertices.data(), vertexBufferSize);
 
     std::tie(mMeshBuffers->indexBufferGPU, mMeshBuffers->indexBufferUploadHeap) =
-        graphics::CreateDefaultBuffer(mD3D12Device, mGraphicsCommandList, meshData.indices.data(), indexBufferSize);
+        graphics::CreateDefaultBuffer(mD3D12Device, mGraphicsCommandList, indexData.data(), indexBufferSize);
 
     mMeshBuffers->vertexBufferByteSize = vertexBufferSize;
     mMeshBuffers->vertexByteStride     = static_cast<uint32_t>(meshData.PerVertexDataSize());
-    mMeshBuffers->indexFormat          = DXGI_FORMAT_R32_UINT;
+    mMeshBuffers->indexFormat          = meshData.IndexFormat();
     mMeshBuffers->indexBufferByteSize  = indexBufferSize;
 }
 
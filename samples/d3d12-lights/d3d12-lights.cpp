@@ -8,7 +8,10 @@
 #include <string>
 
 #include "core/logger.h"
+#include "core/memory-tracker.h"
+#include "core/profiler.h"
 #include "d3dcompiler.h"
+#include "renderer/mesh-optimizer.h"
 #include "renderer/primitive-generator.h"
 #include "renderer/types.h"
 
@@ -33,6 +36,9 @@ std::filesystem::path GetCurrentExeFullPath()
 
 std::string const& shaderHlsl = "lighting.hlsl";
 
+constexpr uint32_t kRenderCommandToggleCapture = 1u << 0;
+constexpr uint32_t kRenderCommandLogTimings    = 1u << 1;
+
 }  // namespace
 
 namespace sample {
@@ -41,7 +47,15 @@ namespace dx = DirectX;
 using namespace physika;
 using namespace physika::core;
 
-D3D12Lights::D3D12Lights(TCHAR const* const title, int width, int height) : Application(title, width, height)
+//! lighting.hlsl reads position, normal and color only.
+using SceneVertex   = renderer::PositionNormalColorVertex;
+using SceneMeshData = renderer::BasicMeshData<SceneVertex>;
+
+D3D12Lights::D3D12Lights(TCHAR const* const title, int width, int height)
+    : Application(title, width, height),
+      mFrameArena(2),
+      mFrameGraph(mJobs),
+      mRenderCommands{ 0 }
 {
     mSwapChainBufferCount = 2;
     mCurrentFrameIndex    = 0;
@@ -109,8 +123,16 @@ bool D3D12Lights::Initialize()
     mCommandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
     FlushCommandQueue();
 
+    //! The initial uploads have completed, so the staging buffers can go.
+    for (renderer::Mesh& mesh : mMeshBuffers) {
+        memory::TrackFree(memory::MemoryTag::kStaging, mesh.vertexBufferByteSize + mesh.indexBufferByteSize);
+        mesh.DisposeUploaders();
+    }
+
     ResizeViewportAndScissorRect();
+    InitializeFrameGraph();
     mTimer.Start();
+    mSimulationTimer.Start();
 
     return true;
 }
@@ -183,8 +205,8 @@ void D3D12Lights::InitializeCommandObjects()
 
 void D3D12Lights::InitializeFrameResources()
 {
-    uint32_t objectCount   = static_cast<uint32_t>(mSceneObjects.size());
-    uint32_t materialCount = static_cast<uint32_t>(mMaterials.size());
+    uint32_t objectCount   = static_cast<uint32_t>(mSceneObjects.Size());
+    uint32_t materialCount = static_cast<uint32_t>(mMaterials.Size());
     for (uint32_t ii = 0; ii < mSwapChainBufferCount; ++ii) {
         mFrameResources.emplace_back(std::make_shared<FrameResource>(mD3D12Device, objectCount, materialCount));
         mFrameResources[ii]->pCommandAllocator->Reset();
@@ -284,7 +306,7 @@ void D3D12Lights::CreateDescriptorHeaps()
      * | PerObjectCB | Material Data | perPassData | PerObjectCB | Material Data | perPassData |
      * -----------------------------------------------------------------------------------------
      */
-    UINT numDescriptors = static_cast<UINT>(mSceneObjects.size() + mMaterials.size() + 1) *
+    UINT numDescriptors = static_cast<UINT>(mSceneObjects.Size() + mMaterials.Size() + 1) *
                           mSwapChainBufferCount;  // Additional 1 descriptor is for per frame cb
 
     D3D12_DESCRIPTOR_HEAP_DESC cbvHeapDesc;
@@ -332,13 +354,13 @@ void D3D12Lights::CreateConstantBufferViews()
 
     auto cbvDescriptorSize = mD3D12Device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
-    mMaterialDescriptorOffset = (uint32_t)(mSceneObjects.size());
-    mPerPassDescriptorOffset  = (uint32_t)(mSceneObjects.size() + mMaterials.size());
-    mNumDescriptorsPerFrame   = (uint32_t)(mSceneObjects.size() + mMaterials.size() + 1);
+    mMaterialDescriptorOffset = (uint32_t)(mSceneObjects.Size());
+    mPerPassDescriptorOffset  = (uint32_t)(mSceneObjects.Size() + mMaterials.Size());
+    mNumDescriptorsPerFrame   = (uint32_t)(mSceneObjects.Size() + mMaterials.Size() + 1);
 
     // descriptors for object transforms
     for (uint32_t frameIndex = 0; frameIndex < mSwapChainBufferCount; ++frameIndex) {
-        for (uint32_t jj = 0; jj < (uint32_t)mSceneObjects.size(); ++jj) {
+        for (uint32_t jj = 0; jj < (uint32_t)mSceneObjects.Size(); ++jj) {
             uint32_t                  descriptorIndex = static_cast<uint32_t>(frameIndex * mNumDescriptorsPerFrame + jj);
             D3D12_GPU_VIRTUAL_ADDRESS cbGPUVA =
                 mFrameResources[frameIndex]->perObjectCBData->Resource()->GetGPUVirtualAddress();
@@ -352,11 +374,11 @@ void D3D12Lights::CreateConstantBufferViews()
         // descriptors for material data
         for (auto const& material : mMaterials) {
             uint32_t descriptorIndex = static_cast<uint32_t>(frameIndex * mNumDescriptorsPerFrame + mMaterialDescriptorOffset +
-                                                             material.second->cbHeapIndex);
+                                                             material.cbHeapIndex);
             D3D12_GPU_VIRTUAL_ADDRESS cbGPUVA =
                 mFrameResources[frameIndex]->perMaterialData->Resource()->GetGPUVirtualAddress();
             D3D12_CONSTANT_BUFFER_VIEW_DESC desc;
-            desc.BufferLocation   = cbGPUVA + material.second->cbHeapIndex * perMaterialBufferSize;
+            desc.BufferLocation   = cbGPUVA + material.cbHeapIndex * perMaterialBufferSize;
             desc.SizeInBytes      = static_cast<UINT>(perMaterialBufferSize);
             auto descriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(mCBVHeap->GetCPUDescriptorHandleForHeapStart(),
                                                                   descriptorIndex, cbvDescriptorSize);
@@ -399,28 +421,36 @@ void D3D12Lights::InitializeSceneCamera()
 
     mCamera.SetCameraProperties(n, f, fov, aspectRatio);
     mCamera.SetLookAt(target, up, position);
+    mSimulationCamera       = mCamera;
+    mCameraPosition         = mCamera.Position();
+    mPreviousCameraPosition = mCameraPosition;
 }
 
 void D3D12Lights::InitializeSceneGeometry()
 {
-    renderer::MeshData cubeMeshData = renderer::CreateCube(10);
-    renderer::MeshData gridMeshData = renderer::CreateUniformGrid(128, 2);
+    SceneMeshData cubeMeshData = renderer::CreateCube<SceneMeshData>(10);
+    SceneMeshData gridMeshData = renderer::CreateUniformGrid<SceneMeshData>(128, 2);
+    renderer::LogMeshOptimizationReport("grid", renderer::OptimizeMesh(gridMeshData));
 
     UINT cubeVertexOffset = 0;
-    UINT cubeIndexOffset  = 0;
+    UINT gridVertexOffset = static_cast<UINT>(cubeMeshData.VertexCount());
 
-    UINT gridVertexOffset = static_cast<UINT>(cubeMeshData.vertices.size());
-    UINT gridIndexOffset  = static_cast<UINT>(cubeMeshData.indices.size());
+    //! Each submesh keeps indices relative to its base vertex, so 16 bits suffice.
+    renderer::IndexBufferBuilder indexBuilder;
+    renderer::Submesh const      cubeSubmesh = indexBuilder.Add(cubeMeshData.indices, cubeVertexOffset);
+    renderer::Submesh const      gridSubmesh = indexBuilder.Add(gridMeshData.indices, gridVertexOffset);
 
     auto const vertexBufferSize = static_cast<uint32_t>(cubeMeshData.VertexBufferSize() + gridMeshData.VertexBufferSize());
-    auto const indexBufferSize  = static_cast<uint32_t>(cubeMeshData.IndexBufferSize() + gridMeshData.IndexBufferSize());
+    auto const indexBufferSize  = static_cast<uint32_t>(indexBuilder.ByteSize());
 
     //! Initialize Mesh - Vertex and Index Buffers;
-    auto shapesBuffer  = std::make_shared<renderer::Mesh>();
-    shapesBuffer->name = "primitives";
+    renderer::MeshHandle const shapesHandle = mMeshBuffers.Emplace();
+    renderer::Mesh*            shapesBuffer = &mMeshBuffers[shapesHandle];
+    shapesBuffer->name                      = "primitives";
 
     D3DCreateBlob(vertexBufferSize, &shapesBuffer->vertexBufferCPU);
     D3DCreateBlob(indexBufferSize, &shapesBuffer->indexBufferCPU);
+    memory::TrackAllocation(memory::MemoryTag::kMesh, vertexBufferSize + indexBufferSize);
 
     // Copy to system memory D3DBlobs
     uint8_t* dst = reinterpret_cast<uint8_t*>(shapesBuffer->vertexBufferCPU->GetBufferPointer());
@@ -429,37 +459,24 @@ void D3D12Lights::InitializeSceneGeometry()
     memcpy(dst + cubeMeshData.VertexBufferSize(), gridMeshData.vertices.data(),
            gridMeshData.VertexBufferSize());  // grid vertex data
 
-    dst = reinterpret_cast<uint8_t*>(shapesBuffer->indexBufferCPU->GetBufferPointer());
-    memcpy(dst, cubeMeshData.indices.data(),
-           cubeMeshData.IndexBufferSize());  // cube vertex data
-    memcpy(dst + cubeMeshData.IndexBufferSize(), gridMeshData.indices.data(),
-           gridMeshData.IndexBufferSize());  // grid vertex data
+    indexBuilder.Write(shapesBuffer->indexBufferCPU->GetBufferPointer());
 
     std::tie(shapesBuffer->vertexBufferGPU, shapesBuffer->vertexBufferUploadHeap) = graphics::CreateDefaultBuffer(
         mD3D12Device, mGraphicsCommandList, shapesBuffer->vertexBufferCPU->GetBufferPointer(), vertexBufferSize);
 
     std::tie(shapesBuffer->indexBufferGPU, shapesBuffer->indexBufferUploadHeap) = graphics::CreateDefaultBuffer(
         mD3D12Device, mGraphicsCommandList, shapesBuffer->indexBufferCPU->GetBufferPointer(), indexBufferSize);
-
-    renderer::Submesh cubeSubmesh;
-    cubeSubmesh.indexCount          = (uint32_t)cubeMeshData.indices.size();
-    cubeSubmesh.vertexStartLocation = cubeVertexOffset;
-    cubeSubmesh.indexStartLocation  = cubeIndexOffset;
-
-    renderer::Submesh gridSubmesh;
-    gridSubmesh.indexCount          = (uint32_t)gridMeshData.indices.size();
-    gridSubmesh.vertexStartLocation = gridVertexOffset;
-    gridSubmesh.indexStartLocation  = gridIndexOffset;
+    memory::TrackAllocation(memory::MemoryTag::kStaging, vertexBufferSize + indexBufferSize);
 
     shapesBuffer->submeshes["cube"] = cubeSubmesh;
     shapesBuffer->submeshes["grid"] = gridSubmesh;
 
     shapesBuffer->vertexBufferByteSize = vertexBufferSize;
     shapesBuffer->indexBufferByteSize  = indexBufferSize;
-    shapesBuffer->vertexByteStride     = static_cast<uint32_t>(renderer::MeshData::PerVertexDataSize());
-    shapesBuffer->indexFormat          = DXGI_FORMAT_R32_UINT;
+    shapesBuffer->vertexByteStride     = static_cast<uint32_t>(SceneMeshData::PerVertexDataSize());
+    shapesBuffer->indexFormat          = indexBuilder.Format();
 
-    mMeshBuffers[shapesBuffer->name] = shapesBuffer;
+    mMeshNames[StringId(shapesBuffer->name)] = shapesHandle;
 
     //! Scene Lights
     renderer::Light sunLight;
@@ -491,55 +508,58 @@ void D3D12Lights::InitializeSceneGeometry()
 
 void D3D12Lights::InitializeSceneMaterials()
 {
-    auto tileMaterial            = std::make_shared<renderer::Material>();
-    tileMaterial->name           = "tile";
-    tileMaterial->cbHeapIndex    = 0;
-    tileMaterial->diffuseAlbedo  = DirectX::XMFLOAT4(DirectX::Colors::LightGray);
-    tileMaterial->fresnel        = DirectX::XMFLOAT3(0.02f, 0.02f, 0.02f);
-    tileMaterial->roughness      = 0.8f;
-    tileMaterial->numFramesDirty = mSwapChainBufferCount;
-
-    auto steelMaterial            = std::make_shared<renderer::Material>();
-    steelMaterial->name           = "steel";
-    steelMaterial->cbHeapIndex    = 1;
-    steelMaterial->diffuseAlbedo  = DirectX::XMFLOAT4(DirectX::Colors::LightSteelBlue);
-    steelMaterial->fresnel        = DirectX::XMFLOAT3(0.05f, 0.05f, 0.05f);
-    steelMaterial->roughness      = 0.6f;
-    steelMaterial->numFramesDirty = mSwapChainBufferCount;
-
-    mMaterials["tile"]  = tileMaterial;
-    mMaterials["steel"] = steelMaterial;
+    renderer::Material tileMaterial;
+    tileMaterial.name           = "tile";
+    tileMaterial.cbHeapIndex    = 0;
+    tileMaterial.diffuseAlbedo  = DirectX::XMFLOAT4(DirectX::Colors::LightGray);
+    tileMaterial.fresnel        = DirectX::XMFLOAT3(0.02f, 0.02f, 0.02f);
+    tileMaterial.roughness      = 0.8f;
+    tileMaterial.numFramesDirty = mSwapChainBufferCount;
+
+    renderer::Material steelMaterial;
+    steelMaterial.name           = "steel";
+    steelMaterial.cbHeapIndex    = 1;
+    steelMaterial.diffuseAlbedo  = DirectX::XMFLOAT4(DirectX::Colors::LightSteelBlue);
+    steelMaterial.fresnel        = DirectX::XMFLOAT3(0.05f, 0.05f, 0.05f);
+    steelMaterial.roughness      = 0.6f;
+    steelMaterial.numFramesDirty = mSwapChainBufferCount;
+
+    mMaterialNames["tile"]  = mMaterials.Insert(std::move(tileMaterial));
+    mMaterialNames["steel"] = mMaterials.Insert(std::move(steelMaterial));
 }
 
 void D3D12Lights::InitializeRenderItems()
 {
     // Iterate the mesh buffers and create render items
-    std::shared_ptr<renderer::Mesh> geo            = mMeshBuffers["primitives"];
-    auto                            cubeRenderItem = std::make_shared<RenderItem>();
-    cubeRenderItem->geometryBuffer                 = geo.get();
-    cubeRenderItem->indexBufferStartLocation       = geo->submeshes["cube"].indexStartLocation;
-    cubeRenderItem->vertexBufferStartLocation      = geo->submeshes["cube"].vertexStartLocation;
-    cubeRenderItem->indexCount                     = geo->submeshes["cube"].indexCount;
-    cubeRenderItem->primitiveTopology              = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-    cubeRenderItem->worldMatrix                    = DirectX::SimpleMath::Matrix::CreateTranslation({ 0.0f, 10.0f, 0.0f });
-    cubeRenderItem->numFramesDirty                 = mSwapChainBufferCount;
-    cubeRenderItem->material                       = mMaterials["steel"].get();
-
-    auto gridRenderItem                       = std::make_shared<RenderItem>();
-    gridRenderItem->geometryBuffer            = geo.get();
-    gridRenderItem->indexBufferStartLocation  = geo->submeshes["grid"].indexStartLocation;
-    gridRenderItem->vertexBufferStartLocation = geo->submeshes["grid"].vertexStartLocation;
-    gridRenderItem->indexCount                = geo->submeshes["grid"].indexCount;
-    gridRenderItem->primitiveTopology         = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-    gridRenderItem->worldMatrix               = DirectX::SimpleMath::Matrix::CreateTranslation({ 0.0f, -10.0f, 0.0f });
-    gridRenderItem->numFramesDirty            = mSwapChainBufferCount;
-    gridRenderItem->material                  = mMaterials["tile"].get();
-
-    cubeRenderItem->objectIndex = (int)mSceneObjects.size();
-    mSceneObjects.push_back(cubeRenderItem);
-
-    gridRenderItem->objectIndex = (int)mSceneObjects.size();
-    mSceneObjects.push_back(gridRenderItem);
+    renderer::MeshHandle const geoHandle = mMeshNames["primitives"];
+    renderer::Mesh&            geo       = mMeshBuffers[geoHandle];
+
+    RenderItem cubeRenderItem;
+    cubeRenderItem.mesh                      = geoHandle;
+    cubeRenderItem.indexBufferStartLocation  = geo.submeshes["cube"].indexStartLocation;
+    cubeRenderItem.vertexBufferStartLocation = geo.submeshes["cube"].vertexStartLocation;
+    cubeRenderItem.indexCount                = geo.submeshes["cube"].indexCount;
+    cubeRenderItem.primitiveTopology         = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+    cubeRenderItem.worldMatrix               = DirectX::SimpleMath::Matrix::CreateTranslation({ 0.0f, 10.0f, 0.0f });
+    cubeRenderItem.numFramesDirty            = mSwapChainBufferCount;
+    cubeRenderItem.material                  = mMaterialNames["steel"];
+
+    RenderItem gridRenderItem;
+    gridRenderItem.mesh                      = geoHandle;
+    gridRenderItem.indexBufferStartLocation  = geo.submeshes["grid"].indexStartLocation;
+    gridRenderItem.vertexBufferStartLocation = geo.submeshes["grid"].vertexStartLocation;
+    gridRenderItem.indexCount                = geo.submeshes["grid"].indexCount;
+    gridRenderItem.primitiveTopology         = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+    gridRenderItem.worldMatrix               = DirectX::SimpleMath::Matrix::CreateTranslation({ 0.0f, -10.0f, 0.0f });
+    gridRenderItem.numFramesDirty            = mSwapChainBufferCount;
+    gridRenderItem.material                  = mMaterialNames["tile"];
+
+    //! Objects are never removed, so the dense position doubles as the constant buffer slot.
+    cubeRenderItem.objectIndex = (int)mSceneObjects.Size();
+    mSceneObjects.Insert(cubeRenderItem);
+
+    gridRenderItem.objectIndex = (int)mSceneObjects.Size();
+    mSceneObjects.Insert(gridRenderItem);
 }
 
 void D3D12Lights::CreateRootSignatures()
@@ -603,17 +623,12 @@ void D3D12Lights::InitializePSOs()
         OutputDebugStringA((char*)errors->GetBufferPointer());
     graphics::ThrowIfFailed(hr);
 
-    D3D12_INPUT_ELEMENT_DESC inputElementDescs[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 36, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 44, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-    };
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElementDescs;
+    renderer::AppendInputElements<SceneVertex>(inputElementDescs, 0);
 
     // Describe and create the graphics pipeline state object (PSO).
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
-    psoDesc.InputLayout                        = { inputElementDescs, _countof(inputElementDescs) };
+    psoDesc.InputLayout                        = { inputElementDescs.data(), static_cast<UINT>(inputElementDescs.size()) };
     psoDesc.pRootSignature                     = mRootSignature.Get();
     psoDesc.VS                                 = CD3DX12_SHADER_BYTECODE(vsByteCode.Get());
     psoDesc.PS                                 = CD3DX12_SHADER_BYTECODE(psByteCode.Get());
@@ -633,35 +648,99 @@ void D3D12Lights::InitializePSOs()
 bool D3D12Lights::Shutdown()
 {
     mTimer.Stop();
+    mSimulationTimer.Stop();
+    mFrameStatistics.LogSummary("d3d12-lights");
+    mFrameGraph.LogTimings("d3d12-lights");
+    memory::LogStats("d3d12-lights");
     FlushCommandQueue();
+    for (renderer::Mesh const& mesh : mMeshBuffers) {
+        memory::TrackFree(memory::MemoryTag::kMesh, mesh.vertexBufferByteSize + mesh.indexBufferByteSize);
+    }
+    mMeshBuffers.Clear();
     if (!Application::Shutdown()) {
         return false;
     }
     return true;
 }
 
-void D3D12Lights::OnUpdate()
+void D3D12Lights::OnSimulate()
 {
-    ProcessKeyStates();
-    Update();
-    Draw();
+    mSimulationTimer.Tick();
+    ProcessMouseLook();
+    uint32_t const steps = mSimulationClock.Advance(mSimulationTimer.DeltaSeconds());
+    for (uint32_t ii = 0; ii < steps; ++ii) {
+        ProcessKeyStates(static_cast<float>(mSimulationClock.StepSeconds()));
+    }
+
+    CameraSnapshot& snapshot = mCameraSnapshots.WriteBuffer();
+
+    snapshot.position  = DirectX::SimpleMath::Vector3::Lerp(mPreviousCameraPosition, mCameraPosition,
+                                                            static_cast<float>(mSimulationClock.Alpha()));
+    snapshot.rotationX = mSimulationCamera.XRotation();
+    snapshot.rotationY = mSimulationCamera.YRotation();
+    mCameraSnapshots.Publish();
 }
 
-void D3D12Lights::Update()
+void D3D12Lights::OnRender()
+{
+    //! Keep drawing the last snapshot when the simulation has not produced a new one.
+    if (mCameraSnapshots.Acquire()) {
+        CameraSnapshot const& snapshot = mCameraSnapshots.ReadBuffer();
+        mCamera.SetXRotation(snapshot.rotationX);
+        mCamera.SetYRotation(snapshot.rotationY);
+        mCamera.SetPosition(snapshot.position);
+    }
+    ProcessRenderCommands();
+    mFrameGraph.Execute();
+
+    mTimer.Tick();
+    mFrameStatistics.AddFrame(mTimer.DeltaSeconds());
+}
+
+void D3D12Lights::InitializeFrameGraph()
+{
+    //! Tasks are declared in serial order; the graph runs the constant buffer updates side by side.
+    auto const frameResource     = mFrameGraph.AddResource("FrameResource");
+    auto const passConstants     = mFrameGraph.AddResource("PassConstants");
+    auto const objectConstants   = mFrameGraph.AddResource("ObjectConstants");
+    auto const materialConstants = mFrameGraph.AddResource("MaterialConstants");
+    auto const commandList       = mFrameGraph.AddResource("CommandList");
+
+    mFrameGraph.AddTask("WaitForFrameResource", [this]() { WaitForFrameResource(); }, {}, { frameResource });
+    mFrameGraph.AddTask("UpdatePassConstants", [this]() { UpdatePassConstants(); }, { frameResource }, { passConstants });
+    mFrameGraph.AddTask("UpdateObjectConstants", [this]() { UpdateObjectConstants(); }, { frameResource },
+                        { objectConstants });
+    mFrameGraph.AddTask("UpdateMaterialConstants", [this]() { UpdateMaterialConstants(); }, { frameResource },
+                        { materialConstants });
+    mFrameGraph.AddTask("RecordCommands", [this]() { RecordCommands(); },
+                        { frameResource, passConstants, objectConstants, materialConstants }, { commandList });
+    mFrameGraph.AddTask("Submit", [this]() { Submit(); }, { commandList }, { frameResource });
+    mFrameGraph.Compile();
+}
+
+void D3D12Lights::WaitForFrameResource()
 {
     //! Wait for frame resources to be freed up
     auto resourceIndex    = mCurrentFrameIndex % mSwapChainBufferCount;
     mCurrentFrameResource = mFrameResources[resourceIndex];
     if (mCurrentFrameResource->fenceIndex != 0 && mFence->GetCompletedValue() < mCurrentFrameResource->fenceIndex) {
+        PHI_LOG_DEBUG_EVERY_MS(kApplication, 1000, "Waiting for frame resource %llu (fence %llu)", resourceIndex,
+                               mCurrentFrameResource->fenceIndex);
         HANDLE eventHandle = CreateEvent(nullptr, false, false, nullptr);
         assert(eventHandle && "Failed to create handle");
         graphics::ThrowIfFailed(mFence->SetEventOnCompletion(mFenceValue, eventHandle));
         WaitForSingleObject(eventHandle, INFINITE);
         CloseHandle(eventHandle);
     }
+    //! The GPU is done with this frame's resources, so its arena pages can be recycled too.
+    mFrameArena.BeginFrame(mCurrentFrameIndex);
+}
 
+void D3D12Lights::UpdatePassConstants()
+{
     //! Update Camera matrix
-    physika::PerPassCBData perPassCBData;
+    //! Built in the frame arena rather than on the stack; it only lives until the copy below.
+    physika::PerPassCBData& perPassCBData = *mFrameArena.New<physika::PerPassCBData>();
     perPassCBData.deltaTime      = mTimer.Delta();
     perPassCBData.totalTime      = mTimer.TotalRunningTime();
     perPassCBData.view           = mCamera.View().Transpose();
@@ -682,41 +761,48 @@ void D3D12Lights::Update()
         lightIndex++;
     }
     mCurrentFrameResource->perPassConstantBuffer->CopyData(0, perPassCBData);
+}
 
-    //! Update Object Data
-    for (int ii = 0; ii < (int)mSceneObjects.size(); ++ii) {
-        if (mSceneObjects[ii]->numFramesDirty <= 0) {
-            continue;
+void D3D12Lights::UpdateObjectConstants()
+{
+    RenderItem* const objects = mSceneObjects.Data();
+    mJobs.ParallelFor(static_cast<uint32_t>(mSceneObjects.Size()), [this, objects](uint32_t begin, uint32_t end) {
+        PROFILE_SCOPE("UpdateObjects");
+        for (uint32_t ii = begin; ii < end; ++ii) {
+            if (objects[ii].numFramesDirty <= 0) {
+                continue;
+            }
+            PerObjectCBData                    perObjectCBData = { objects[ii].worldMatrix.Transpose() };
+            DirectX::SimpleMath::Matrix const& m               = objects[ii].worldMatrix;
+            // normal matrix calculation TODO: calculate only once.
+            DirectX::XMFLOAT3X3 model3x3 =
+                DirectX::XMFLOAT3X3(m._11, m._12, m._13, m._21, m._22, m._23, m._31, m._32, m._33);
+            DirectX::XMMATRIX model3x3SIMD = DirectX::XMLoadFloat3x3(&model3x3);
+            model3x3SIMD                   = DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, model3x3SIMD));
+            DirectX::XMStoreFloat3x3(&perObjectCBData.normalMatrix, model3x3SIMD);
+            // copy to cb; every object owns its own slot so ranges never overlap
+            mCurrentFrameResource->perObjectCBData->CopyData(objects[ii].objectIndex, perObjectCBData);
+            objects[ii].numFramesDirty--;
         }
-        PerObjectCBData                    perObjectCBData = { mSceneObjects[ii]->worldMatrix.Transpose() };
-        DirectX::SimpleMath::Matrix const& m               = mSceneObjects[ii]->worldMatrix;
-        // normal matrix calculation TODO: calculate only once.
-        DirectX::XMFLOAT3X3 model3x3     = DirectX::XMFLOAT3X3(m._11, m._12, m._13, m._21, m._22, m._23, m._31, m._32, m._33);
-        DirectX::XMMATRIX   model3x3SIMD = DirectX::XMLoadFloat3x3(&model3x3);
-        model3x3SIMD                     = DirectX::XMMatrixTranspose(DirectX::XMMatrixInverse(nullptr, model3x3SIMD));
-        DirectX::XMStoreFloat3x3(&perObjectCBData.normalMatrix, model3x3SIMD);
-        // copy to cb
-        mCurrentFrameResource->perObjectCBData->CopyData(ii, perObjectCBData);
-        mSceneObjects[ii]->numFramesDirty--;
-    }
+    });
+}
 
-    //! Update Material Data
+void D3D12Lights::UpdateMaterialConstants()
+{
     for (auto& material : mMaterials) {
-        if (material.second->numFramesDirty <= 0) {
+        if (material.numFramesDirty <= 0) {
             continue;
         }
         renderer::MaterialCBData perMaterialData = {};
-        perMaterialData.diffuseAlbedo            = material.second->diffuseAlbedo;
-        perMaterialData.fresnel                  = material.second->fresnel;
-        perMaterialData.roughness                = material.second->roughness;
-        mCurrentFrameResource->perMaterialData->CopyData(material.second->cbHeapIndex, perMaterialData);
-        material.second->numFramesDirty--;
+        perMaterialData.diffuseAlbedo            = material.diffuseAlbedo;
+        perMaterialData.fresnel                  = material.fresnel;
+        perMaterialData.roughness                = material.roughness;
+        mCurrentFrameResource->perMaterialData->CopyData(material.cbHeapIndex, perMaterialData);
+        material.numFramesDirty--;
     }
-
-    mTimer.Tick();
 }
 
-void D3D12Lights::Draw()
+void D3D12Lights::RecordCommands()
 {
     auto& pCommandAllocator = mCurrentFrameResource->pCommandAllocator;
     graphics::ThrowIfFailed(pCommandAllocator->Reset());
@@ -762,10 +848,13 @@ void D3D12Lights::Draw()
     mGraphicsCommandList->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL, 1.0f, 0, 0, nullptr);
 
     // Setup mesh render
-    for (int ii = 0; ii < mSceneObjects.size(); ++ii) {
-        int objectIndex   = static_cast<int>(frameResourceIndex * mNumDescriptorsPerFrame + mSceneObjects[ii]->objectIndex);
+    for (RenderItem const& item : mSceneObjects) {
+        renderer::Mesh const&     mesh     = mMeshBuffers[item.mesh];
+        renderer::Material const& material = mMaterials[item.material];
+
+        int objectIndex   = static_cast<int>(frameResourceIndex * mNumDescriptorsPerFrame + item.objectIndex);
         int materialIndex = static_cast<int>(frameResourceIndex * mNumDescriptorsPerFrame + mMaterialDescriptorOffset +
-                                             mSceneObjects[ii]->material->cbHeapIndex);
+                                             material.cbHeapIndex);
 
         auto gpuPerObjectCBDescriptorHandle =
             CD3DX12_GPU_DESCRIPTOR_HANDLE(mCBVHeap->GetGPUDescriptorHandleForHeapStart(), objectIndex, cbvDescriptorSize);
@@ -775,14 +864,14 @@ void D3D12Lights::Draw()
             CD3DX12_GPU_DESCRIPTOR_HANDLE(mCBVHeap->GetGPUDescriptorHandleForHeapStart(), materialIndex, cbvDescriptorSize);
         mGraphicsCommandList->SetGraphicsRootDescriptorTable(2, materialCBDescriptorHandle);
 
-        auto const& ibView                    = mSceneObjects[ii]->geometryBuffer->IndexBufferView();
-        auto const& vbView                    = mSceneObjects[ii]->geometryBuffer->VertexBufferView();
-        uint32_t    indexCount                = mSceneObjects[ii]->indexCount;
-        uint32_t    vertexBufferStartLocation = mSceneObjects[ii]->vertexBufferStartLocation;
-        uint32_t    indexBufferStartLocation  = mSceneObjects[ii]->indexBufferStartLocation;
+        auto const& ibView                    = mesh.IndexBufferView();
+        auto const& vbView                    = mesh.VertexBufferView();
+        uint32_t    indexCount                = item.indexCount;
+        uint32_t    vertexBufferStartLocation = item.vertexBufferStartLocation;
+        uint32_t    indexBufferStartLocation  = item.indexBufferStartLocation;
         mGraphicsCommandList->IASetIndexBuffer(&ibView);
         mGraphicsCommandList->IASetVertexBuffers(0, 1, &vbView);
-        mGraphicsCommandList->IASetPrimitiveTopology(mSceneObjects[ii]->primitiveTopology);
+        mGraphicsCommandList->IASetPrimitiveTopology(item.primitiveTopology);
         mGraphicsCommandList->DrawIndexedInstanced(indexCount, 1, indexBufferStartLocation, vertexBufferStartLocation, 0);
     }
 
@@ -791,7 +880,10 @@ void D3D12Lights::Draw()
     mGraphicsCommandList->ResourceBarrier(1, &transitionToPresentState);
 
     graphics::ThrowIfFailed(mGraphicsCommandList->Close());
+}
 
+void D3D12Lights::Submit()
+{
     ID3D12CommandList* commandLists[] = { mGraphicsCommandList.Get() };
     mCommandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
 
@@ -806,13 +898,14 @@ void D3D12Lights::Draw()
 
 void D3D12Lights::FlushCommandQueue()
 {
+    PROFILE_SCOPE("FlushCommandQueue");
     mFenceValue++;
-    logger::LOG_DEBUG("Flushing command queue: %d", mFenceValue);
+    PHI_LOG_DEBUG_EVERY_MS(kApplication, 1000, "Flushing command queue: %llu", mFenceValue);
     graphics::ThrowIfFailed(mCommandQueue->Signal(mFence.Get(), mFenceValue));
 
     if (mFence->GetCompletedValue() < mFenceValue) {
         HANDLE fenceEventHandle = CreateEvent(nullptr, false, false, nullptr);
-        logger::LOG_DEBUG("Fence completed value: %d", mFence->GetCompletedValue());
+        PHI_LOG_DEBUG_EVERY_MS(kApplication, 1000, "Fence completed value: %llu", mFence->GetCompletedValue());
         graphics::ThrowIfFailed(mFence->SetEventOnCompletion(mFenceValue, fenceEventHandle));
         WaitForSingleObject(fenceEventHandle, INFINITE);
     }
@@ -864,71 +957,75 @@ void D3D12Lights::OnResize(int width, int height)
     ResizeViewportAndScissorRect();
 }
 
-void D3D12Lights::OnKeyUp(Keycode key)
-{
-    mInputStates.keyState[key] = false;
-}
-
 void D3D12Lights::OnKeyDown(Keycode key)
 {
-    mInputStates.keyState[key] = true;
-}
-
-void D3D12Lights::OnMouseUp(MouseButton /*button*/, int /*x*/, int /*y*/)
-{
-    mInputStates.isMouseDown = false;
+    //! F9 toggles a Chrome trace capture.
+    if (key == kF9) {
+        mRenderCommands.fetch_or(kRenderCommandToggleCapture, std::memory_order_release);
+    }
+    //! F8 logs the last frame's task timings and critical path.
+    if (key == kF8) {
+        mRenderCommands.fetch_or(kRenderCommandLogTimings, std::memory_order_release);
+    }
 }
 
-void D3D12Lights::OnMouseDown(MouseButton /*button*/, int /*x*/, int /*y*/)
+void D3D12Lights::ProcessRenderCommands()
 {
-    mInputStates.isMouseDown = true;
+    uint32_t const commands = mRenderCommands.exchange(0, std::memory_order_acquire);
+    if (commands & kRenderCommandToggleCapture) {
+        if (profiler::IsCapturing()) {
+            profiler::StopCapture("d3d12-lights-trace.json");
+        } else {
+            profiler::StartCapture();
+        }
+    }
+    if (commands & kRenderCommandLogTimings) {
+        mFrameGraph.LogTimings("d3d12-lights");
+    }
 }
 
-void D3D12Lights::OnMouseMove(int x, int y)
+void D3D12Lights::ProcessMouseLook()
 {
-    if (mInputStates.isMouseDown) {
-        float angularVelocity = 10.0f * mTimer.Delta();
-        float xRotDeg         = DirectX::XMConvertToDegrees(mCamera.XRotation());
-        float yRotDeg         = DirectX::XMConvertToDegrees(mCamera.YRotation());
-
-        float dx = static_cast<float>(x) - mInputStates.mouseX;
-        float dy = static_cast<float>(y) - mInputStates.mouseY;
+    physika::core::InputState const& input = Input();
+    if (input.mouseButtons == physika::core::kMouseNone) {
+        return;
+    }
+    float angularVelocity = 10.0f * mSimulationTimer.Delta();
+    float xRotDeg         = DirectX::XMConvertToDegrees(mSimulationCamera.XRotation());
+    float yRotDeg         = DirectX::XMConvertToDegrees(mSimulationCamera.YRotation());
 
-        xRotDeg += dy * angularVelocity;
-        yRotDeg += dx * angularVelocity;
+    xRotDeg += static_cast<float>(input.mouseDeltaY) * angularVelocity;
+    yRotDeg += static_cast<float>(input.mouseDeltaX) * angularVelocity;
 
-        mCamera.SetXRotation(DirectX::XMConvertToRadians(xRotDeg));
-        mCamera.SetYRotation(DirectX::XMConvertToRadians(yRotDeg));
-    }
-    mInputStates.mouseX = static_cast<float>(x);
-    mInputStates.mouseY = static_cast<float>(y);
+    mSimulationCamera.SetXRotation(DirectX::XMConvertToRadians(xRotDeg));
+    mSimulationCamera.SetYRotation(DirectX::XMConvertToRadians(yRotDeg));
 }
 
-void D3D12Lights::OnMouseWheel(int /*delta*/)
+void D3D12Lights::ProcessKeyStates(float stepSeconds)
 {
-}
+    PROFILE_SCOPE("ProcessKeyStates");
+    mPreviousCameraPosition               = mCameraPosition;
+    DirectX::SimpleMath::Vector3 offset   = mCameraPosition;
+    float                        velocity = 10.0f * stepSeconds;
 
-void D3D12Lights::ProcessKeyStates()
-{
-    DirectX::SimpleMath::Vector3 offset   = mCamera.Position();
-    float                        velocity = 10.0f * mTimer.Delta();
+    physika::core::InputState const& input = Input();
 
-    if (mInputStates.keyState[kA]) {
-        offset += -velocity * mCamera.Right();
+    if (input.keyDown[kA]) {
+        offset += -velocity * mSimulationCamera.Right();
     }
 
-    if (mInputStates.keyState[kD]) {
-        offset += velocity * mCamera.Right();
+    if (input.keyDown[kD]) {
+        offset += velocity * mSimulationCamera.Right();
     }
 
-    if (mInputStates.keyState[kS]) {
-        offset += velocity * mCamera.Forward();
+    if (input.keyDown[kS]) {
+        offset += velocity * mSimulationCamera.Forward();
     }
 
-    if (mInputStates.keyState[kW]) {
-        offset += -velocity * mCamera.Forward();
+    if (input.keyDown[kW]) {
+        offset += -velocity * mSimulationCamera.Forward();
     }
-    mCamera.SetPosition(offset);
+    mCameraPosition = offset;
 }
 
 }  // namespace sample
\ No newline at end of file
@@ -4,12 +4,21 @@
 #include <dxgi1_3.h>
 #include <stdint.h>  // uint32_t
 
+#include <atomic>
 #include <memory>  // unique_ptr
 #include <vector>
 
 #include "core/application.h"
+#include "core/fixed-timestep.h"
+#include "core/flat-map.h"
+#include "core/frame-arena.h"
+#include "core/frame-statistics.h"
 #include "core/input.h"
+#include "core/job-system.h"
+#include "core/string-id.h"
+#include "core/task-graph.h"
 #include "core/timer.h"
+#include "core/triple-buffer.h"
 #include "frame-resource.h"
 #include "graphics/helpers.h"
 #include "graphics/types.h"
@@ -18,14 +27,13 @@
 namespace sample {
 
 using physika::core::Keycode;
-using physika::core::MouseButton;
 
-struct InputStates
+//! What the simulation thread hands to rendering each tick.
+struct CameraSnapshot
 {
-    bool  isMouseDown                            = {};
-    bool  keyState[physika::core::kKeyCodeCount] = {};
-    float mouseX                                 = {};
-    float mouseY                                 = {};
+    DirectX::SimpleMath::Vector3 position;
+    float                        rotationX = 0.0f;
+    float                        rotationY = 0.0f;
 };
 
 class D3D12Lights : public physika::core::Application
@@ -37,14 +45,10 @@ public:
     bool Initialize();
     bool Shutdown();
 
-    void OnUpdate() override;
+    void OnSimulate() override;
+    void OnRender() override;
     void OnResize(int width, int height) override;
-    void OnKeyUp(Keycode key) override;
     void OnKeyDown(Keycode key) override;
-    void OnMouseUp(MouseButton button, int x, int y) override;
-    void OnMouseDown(MouseButton button, int x, int y) override;
-    void OnMouseMove(int x, int y) override;
-    void OnMouseWheel(int delta) override;
 
 private:
     void InitializeDeviceObjects();
@@ -69,10 +73,20 @@ private:
     void InitializePSOs();
 
     void FlushCommandQueue();
-    void Update();
-    void Draw();
 
-    void ProcessKeyStates();
+    //! Frame tasks, run by mFrameGraph.
+    void InitializeFrameGraph();
+    void WaitForFrameResource();
+    void UpdatePassConstants();
+    void UpdateObjectConstants();
+    void UpdateMaterialConstants();
+    void RecordCommands();
+    void Submit();
+
+    void ProcessMouseLook();
+    void ProcessKeyStates(float stepSeconds);
+    //! Run the commands OnKeyDown posted; called by OnRender before the frame graph executes.
+    void ProcessRenderCommands();
 
     uint32_t    mSwapChainBufferCount;
     uint32_t    mCurrentBackBuffer;
@@ -100,6 +114,15 @@ private:
 
     //! Sync Variables
     physika::core::Timer              mTimer;
+    physika::core::FrameStatistics    mFrameStatistics;
+    //! Camera movement runs at a fixed rate and is interpolated for rendering.
+    //! In split update mode the simulation members belong to the simulation thread.
+    physika::core::Timer                        mSimulationTimer;
+    physika::core::FixedTimestep                mSimulationClock;
+    physika::renderer::Camera                   mSimulationCamera;
+    DirectX::SimpleMath::Vector3                mCameraPosition;
+    DirectX::SimpleMath::Vector3                mPreviousCameraPosition;
+    physika::core::TripleBuffer<CameraSnapshot> mCameraSnapshots;
     uint64_t                          mCurrentFrameIndex;
     uint64_t                          mFenceValue;
     physika::graphics::ID3D12FencePtr mFence;
@@ -111,20 +134,29 @@ private:
     std::shared_ptr<physika::FrameResource>              mCurrentFrameResource;
 
     //! Scene resources
-    uint32_t                                                                      mNumDescriptorsPerFrame;
-    uint32_t                                                                      mPerPassDescriptorOffset;
-    uint32_t                                                                      mMaterialDescriptorOffset;
-    std::unordered_map<std::string, std::shared_ptr<physika::renderer::Mesh>>     mMeshBuffers;
-    std::unordered_map<std::string, std::shared_ptr<physika::renderer::Material>> mMaterials;
-    std::vector<std::shared_ptr<physika::RenderItem>>                             mSceneObjects;
-    std::vector<physika::renderer::Light>                                         mDirectionalLights;
-    std::vector<physika::renderer::Light>                                         mPointLights;
-    std::vector<physika::renderer::Light>                                         mSpotLights;
+    uint32_t                                                                           mNumDescriptorsPerFrame;
+    uint32_t                                                                           mPerPassDescriptorOffset;
+    uint32_t                                                                           mMaterialDescriptorOffset;
+    physika::renderer::MeshPool                                                        mMeshBuffers;
+    physika::renderer::MaterialPool                                                    mMaterials;
+    physika::RenderItemPool                                                            mSceneObjects;
+    physika::core::FlatMap<physika::core::StringId, physika::renderer::MeshHandle>     mMeshNames;
+    physika::core::FlatMap<physika::core::StringId, physika::renderer::MaterialHandle> mMaterialNames;
+    std::vector<physika::renderer::Light>                                              mDirectionalLights;
+    std::vector<physika::renderer::Light>                                              mPointLights;
+    std::vector<physika::renderer::Light>                                              mSpotLights;
 
     physika::renderer::Camera mCamera;
 
-    //! Input
-    InputStates mInputStates;
+    //! Per-frame temporaries; one set of pages per frame resource.
+    physika::core::FrameArena mFrameArena;
+    //! Spreads per-object constant buffer updates over all cores.
+    physika::core::JobSystem mJobs;
+    //! Per-frame CPU work; built once in Initialize.
+    physika::core::TaskGraph mFrameGraph;
+    //! kRenderCommand* bits set by OnKeyDown. Input runs on the simulation thread in split
+    //! update mode, so commands that touch the frame graph or the profiler wait for OnRender.
+    std::atomic<uint32_t> mRenderCommands;
 };
 
 }  // namespace sample
@@ -2,6 +2,7 @@
 
 #include "frame-resource.h"
 
+#include "core/memory-tracker.h"
 #include "graphics/helpers.h"
 
 namespace physika {
@@ -16,6 +17,14 @@ FrameResource::FrameResource(ID3D12DevicePtr pDevice, uint32_t const objectCount
     perPassConstantBuffer = std::make_unique<UploadBuffer<PerPassCBData>>(pDevice, 1, true);
     perObjectCBData       = std::make_unique<UploadBuffer<PerObjectCBData>>(pDevice, objectCount, true);
     perMaterialData       = std::make_unique<UploadBuffer<renderer::MaterialCBData>>(pDevice, materialCount, true);
+
+    materialBufferBytes = GetSizeWithAlignment(sizeof(renderer::MaterialCBData), 256) * materialCount;
+    core::memory::TrackAllocation(core::memory::MemoryTag::kMaterial, materialBufferBytes);
+}
+
+FrameResource::~FrameResource()
+{
+    core::memory::TrackFree(core::memory::MemoryTag::kMaterial, materialBufferBytes);
 }
 
 }  // namespace physika
@@ -5,6 +5,7 @@
 #include "graphics/helpers.h"
 #include "graphics/upload-buffer.h"
 #include "renderer/constant-data.h"
+#include "renderer/scene-pools.h"
 #include "renderer/types.h"
 
 namespace physika {
@@ -45,15 +46,19 @@ struct RenderItem
     uint32_t                    indexCount                = 0;
     uint32_t                    vertexBufferStartLocation = 0;
     uint32_t                    indexBufferStartLocation  = 0;
-    renderer::Mesh*             geometryBuffer            = nullptr;
-    renderer::Material*         material                  = nullptr;
+    renderer::MeshHandle        mesh;
+    renderer::MaterialHandle    material;
     DirectX::SimpleMath::Matrix worldMatrix;
 };
 
+using RenderItemHandle = core::Handle<RenderItem>;
+using RenderItemPool   = core::SlotMap<RenderItem>;
+
 struct FrameResource
 {
 public:
     FrameResource(graphics::ID3D12DevicePtr pDevice, uint32_t const objectCount, uint32_t const materialCount);
+    ~FrameResource();
     FrameResource()                           = delete;
     FrameResource(FrameResource const& other) = delete;
     FrameResource& operator=(FrameResource const& other) = delete;
@@ -63,5 +68,7 @@ public:
     UploadBufferPtr<PerPassCBData>            perPassConstantBuffer = nullptr;
     UploadBufferPtr<PerObjectCBData>          perObjectCBData       = nullptr;
     UploadBufferPtr<renderer::MaterialCBData> perMaterialData       = nullptr;
+    //! Size of perMaterialData, accounted to the material memory tag.
+    size_t materialBufferBytes = 0;
 };
 }  // namespace physika
\ No newline at end of file
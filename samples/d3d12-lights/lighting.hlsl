@@ -26,8 +26,6 @@ struct VertexInput
 {
     float3 position : POSITION;
     float3 normal : NORMAL;
-    float3 tangent : TANGENT;
-    float2 texcoord : TEXCOORD;
     float4 color : COLOR;
 };
 
@@ -1,21 +1,50 @@
-
 #include <stdio.h>
+#include <string.h>
 
 #include "d3d12-lights.h"
 
-int main()
+int main(int argc, char** argv)
 {
     float               aspectRatio43 = 4.0f / 3.0f;
     int                 windowWidth   = 1024;
     int                 windowHeight  = static_cast<int>(windowWidth / aspectRatio43);
     sample::D3D12Lights app(_T("D3D12 Shapes"), windowWidth, windowHeight);
 
+    //! --record <file> saves the session's input, --replay <file> plays it back.
+    //! --threaded-update runs frames off the message pump thread, --split-update
+    //! runs the simulation and rendering on separate threads.
+    char const*                  recordPath = nullptr;
+    physika::core::InputRecorder recorder;
+    physika::core::InputReplay   replay;
+    for (int ii = 1; ii < argc; ++ii) {
+        if (strcmp(argv[ii], "--threaded-update") == 0) {
+            app.SetThreadedUpdate(true);
+        } else if (strcmp(argv[ii], "--split-update") == 0) {
+            app.SetSplitUpdate(true);
+        } else if (ii + 1 == argc) {
+            break;
+        } else if (strcmp(argv[ii], "--record") == 0) {
+            recordPath = argv[++ii];
+            app.SetInputRecorder(&recorder);
+        } else if (strcmp(argv[ii], "--replay") == 0) {
+            if (!replay.Load(argv[++ii])) {
+                printf("Could not load input recording %s. Exiting", argv[ii]);
+                return 1;
+            }
+            app.SetInputReplay(&replay);
+        }
+    }
+
     if (!app.Initialize()) {
         printf("Could not initialize app. Exiting");
         return 1;
     }
+    app.SetTargetFrameRate(60.0);
     app.Run();
 
+    if (recordPath && !recorder.Save(recordPath)) {
+        printf("Could not save input recording to %s.", recordPath);
+    }
     if (!app.Shutdown()) {
         printf("Shutdown sequence failed.");
         return 1;
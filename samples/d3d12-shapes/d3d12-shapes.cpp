@@ -385,13 +385,15 @@ void D3D12Shapes::InitializeSceneGeometry()
     renderer::MeshData gridMeshData = renderer::CreateUniformGrid(128, 2);
 
     UINT cubeVertexOffset = 0;
-    UINT cubeIndexOffset  = 0;
+    UINT gridVertexOffset = static_cast<UINT>(cubeMeshData.VertexCount());
 
-    UINT gridVertexOffset = static_cast<UINT>(cubeMeshData.vertices.size());
-    UINT gridIndexOffset  = static_cast<UINT>(cubeMeshData.indices.size());
+    //! Each submesh keeps indices relative to its base vertex, so 16 bits suffice.
+    renderer::IndexBufferBuilder indexBuilder;
+    renderer::Submesh const      cubeSubmesh = indexBuilder.Add(cubeMeshData.indices, cubeVertexOffset);
+    renderer::Submesh const      gridSubmesh = indexBuilder.Add(gridMeshData.indices, gridVertexOffset);
 
     auto const vertexBufferSize = static_cast<uint32_t>(cubeMeshData.VertexBufferSize() + gridMeshData.VertexBufferSize());
-    auto const indexBufferSize  = static_cast<uint32_t>(cubeMeshData.IndexBufferSize() + gridMeshData.IndexBufferSize());
+    auto const indexBufferSize  = static_cast<uint32_t>(indexBuilder.ByteSize());
 
     //! Initialize Mesh - Vertex and Index Buffers;
     auto shapesBuffer  = std::make_shared<renderer::Mesh>();
@@ -407,11 +409,7 @@ void D3D12Shapes::InitializeSceneGeometry()
     memcpy(dst + cubeMeshData.VertexBufferSize(), gridMeshData.vertices.data(),
            gridMeshData.VertexBufferSize());  // grid vertex data
 
-    dst = reinterpret_cast<uint8_t*>(shapesBuffer->indexBufferCPU->GetBufferPointer());
-    memcpy(dst, cubeMeshData.indices.data(),
-           cubeMeshData.IndexBufferSize());  // cube vertex data
-    memcpy(dst + cubeMeshData.IndexBufferSize(), gridMeshData.indices.data(),
-           gridMeshData.IndexBufferSize());  // grid vertex data
+    indexBuilder.Write(shapesBuffer->indexBufferCPU->GetBufferPointer());
 
     std::tie(shapesBuffer->vertexBufferGPU, shapesBuffer->vertexBufferUploadHeap) = graphics::CreateDefaultBuffer(
         mD3D12Device, mGraphicsCommandList, shapesBuffer->vertexBufferCPU->GetBufferPointer(), vertexBufferSize);
@@ -419,25 +417,15 @@ void D3D12Shapes::InitializeSceneGeometry()
     std::tie(shapesBuffer->indexBufferGPU, shapesBuffer->indexBufferUploadHeap) = graphics::CreateDefaultBuffer(
         mD3D12Device, mGraphicsCommandList, shapesBuffer->indexBufferCPU->GetBufferPointer(), indexBufferSize);
 
-    renderer::Submesh cubeSubmesh;
-    cubeSubmesh.indexCount          = (uint32_t)cubeMeshData.indices.size();
-    cubeSubmesh.vertexStartLocation = cubeVertexOffset;
-    cubeSubmesh.indexStartLocation  = cubeIndexOffset;
-
-    renderer::Submesh gridSubmesh;
-    gridSubmesh.indexCount          = (uint32_t)gridMeshData.indices.size();
-    gridSubmesh.vertexStartLocation = gridVertexOffset;
-    gridSubmesh.indexStartLocation  = gridIndexOffset;
-
     shapesBuffer->submeshes["cube"] = cubeSubmesh;
     shapesBuffer->submeshes["grid"] = gridSubmesh;
 
     shapesBuffer->vertexBufferByteSize = vertexBufferSize;
     shapesBuffer->indexBufferByteSize  = indexBufferSize;
     shapesBuffer->vertexByteStride     = static_cast<uint32_t>(renderer::MeshData::PerVertexDataSize());
-    shapesBuffer->indexFormat          = DXGI_FORMAT_R32_UINT;
+    shapesBuffer->indexFormat          = indexBuilder.Format();
 
-    mMeshBuffers[shapesBuffer->name] = shapesBuffer;
+    mMeshBuffers[core::StringId(shapesBuffer->name)] = shapesBuffer;
 }
 
 void D3D12Shapes::InitializeRenderItems()
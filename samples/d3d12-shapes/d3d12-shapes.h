@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "core/application.h"
+#include "core/flat-map.h"
 #include "core/input.h"
+#include "core/string-id.h"
 #include "core/timer.h"
 #include "frame-resource.h"
 #include "graphics/helpers.h"
@@ -111,11 +113,11 @@ private:
     std::shared_ptr<physika::FrameResource>              mCurrentFrameResource;
 
     //! Scene resources
-    uint32_t                                                                  mPerPassDescriptorIndexOffset;
-    physika::PerPassCBData                                                    mPerPassCBData;
-    std::unordered_map<std::string, std::shared_ptr<physika::renderer::Mesh>> mMeshBuffers;
-    std::vector<std::shared_ptr<physika::RenderItem>>                         mSceneObjects;
-    physika::renderer::Camera                                                 mCamera;
+    uint32_t                                                                                  mPerPassDescriptorIndexOffset;
+    physika::PerPassCBData                                                                    mPerPassCBData;
+    physika::core::FlatMap<physika::core::StringId, std::shared_ptr<physika::renderer::Mesh>> mMeshBuffers;
+    std::vector<std::shared_ptr<physika::RenderItem>>                                         mSceneObjects;
+    physika::renderer::Camera                                                                 mCamera;
 
     //! Input
     InputStates mInputStates;
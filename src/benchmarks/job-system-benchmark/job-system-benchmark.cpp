@@ -0,0 +1,77 @@
+// Measures how JobSystem::ParallelFor scales from one thread to every
+// hardware thread, for a compute bound loop and for near-empty jobs
+// where scheduling overhead dominates. Pass a thread count to go past
+// the hardware thread count.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>  // atoi
+
+#include <chrono>
+#include <vector>
+
+#include "core/job-system.h"
+
+namespace {
+
+using namespace physika::core;
+using Clock = std::chrono::steady_clock;
+
+uint32_t const kElements  = 1u << 22;
+uint32_t const kEmptyJobs = 1u << 18;
+int const      kRepeats   = 5;
+
+double ComputeBound(JobSystem& jobs, std::vector<float>& data)
+{
+    double best = 1e30;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        auto const start = Clock::now();
+        jobs.ParallelFor(kElements, [&data](uint32_t begin, uint32_t end) {
+            for (uint32_t ii = begin; ii < end; ++ii) {
+                float const x = static_cast<float>(ii) * 0.001f;
+                data[ii]      = sqrtf(x) * sinf(x) + cosf(x * 0.5f);
+            }
+        });
+        double const ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        best            = ms < best ? ms : best;
+    }
+    return best;
+}
+
+double EmptyJobs(JobSystem& jobs)
+{
+    double best = 1e30;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        JobCounter counter;
+        auto const start = Clock::now();
+        for (uint32_t ii = 0; ii < kEmptyJobs; ++ii) {
+            jobs.Run([]() {}, &counter);
+        }
+        jobs.Wait(counter);
+        double const ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kEmptyJobs;
+        best            = ns < best ? ns : best;
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t const maxThreads = argc > 1 ? static_cast<uint32_t>(atoi(argv[1])) : JobSystem::DefaultWorkerThreads() + 1;
+
+    std::vector<float> data(kElements);
+
+    printf("%8s %14s %10s %14s %10s\n", "threads", "parallel-for", "speedup", "ns/empty-job", "stolen");
+    double baseline = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; ++threads) {
+        JobSystem    jobs(threads - 1);
+        double const ms = ComputeBound(jobs, data);
+        double const ns = EmptyJobs(jobs);
+        baseline        = threads == 1 ? ms : baseline;
+        printf("%8u %11.2f ms %9.2fx %14.1f %10llu\n", threads, ms, baseline / ms, ns,
+               static_cast<unsigned long long>(jobs.Stats().stolen));
+    }
+    return 0;
+}
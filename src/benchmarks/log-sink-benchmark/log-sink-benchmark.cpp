@@ -0,0 +1,142 @@
+// Measures logger throughput (records/s and bytes/s) when writing to a file
+// through plain stdio compared with the memory-mapped rotating sink.
+//
+// The report goes to stderr. Log files are written to the working directory
+// and removed afterwards.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <memory>  // make_shared
+#include <string>
+
+#include "core/log-sinks.h"
+#include "core/logger.h"
+
+namespace {
+
+using namespace physika::core;
+using Clock = std::chrono::steady_clock;
+
+int const      kRecords     = 1000000;
+size_t const   kSegmentSize = size_t(16) << 20;
+uint32_t const kMaxSegments = 4;
+char const*    kStdioPath   = "log-sink-benchmark.txt";
+char const*    kMappedPath  = "log-sink-benchmark";
+
+//! Forwards to another sink and counts the bytes written.
+class CountingSink : public logger::LogSink
+{
+public:
+    explicit CountingSink(logger::LogSinkPtr sink) : mSink(std::move(sink))
+    {
+    }
+
+    void Write(logger::LogLevel level, char const* line, size_t length) override
+    {
+        mBytes += length;
+        mSink->Write(level, line, length);
+    }
+
+    void Flush() override
+    {
+        mSink->Flush();
+    }
+
+    uint64_t Bytes() const
+    {
+        return mBytes;
+    }
+
+private:
+    logger::LogSinkPtr mSink;
+    uint64_t           mBytes = 0;
+};
+
+void Report(char const* mode, double seconds, uint64_t bytes)
+{
+    fprintf(stderr, "%-24s %12.0f records/s %10.1f MB/s\n", mode, kRecords / seconds, bytes / seconds / (1024.0 * 1024.0));
+}
+
+void RunPlainStdio()
+{
+    FILE* file = fopen(kStdioPath, "wb");
+    if (!file) {
+        fprintf(stderr, "Could not open %s\n", kStdioPath);
+        return;
+    }
+    uint64_t   bytes = 0;
+    auto const start = Clock::now();
+    for (int ii = 0; ii < kRecords; ++ii) {
+        int const length = fprintf(file, "[%s] [%s]: record %d value %f\n", logger::ApplicationName(),
+                                   logger::StringifyLogLevel(logger::LogLevel::kInfo), ii, ii * 0.5);
+        bytes += length > 0 ? length : 0;
+    }
+    fflush(file);
+    auto const end = Clock::now();
+    fclose(file);
+    remove(kStdioPath);
+    Report("fprintf", std::chrono::duration<double>(end - start).count(), bytes);
+}
+
+void RunSink(char const* mode, logger::LogSinkPtr sink, bool async)
+{
+    auto counting = std::make_shared<CountingSink>(std::move(sink));
+    logger::ClearSinks();
+    logger::AddSink(counting);
+    if (async) {
+        logger::AsyncOptions options;
+        options.overflowPolicy = logger::OverflowPolicy::kBlock;
+        options.flushTimeoutMs = 10000;
+        logger::EnableAsyncLogging(options);
+    }
+
+    auto const start = Clock::now();
+    for (int ii = 0; ii < kRecords; ++ii) {
+        logger::LOG_INFO("record %d value %f", ii, ii * 0.5);
+    }
+    if (async) {
+        logger::DisableAsyncLogging();
+    }
+    logger::FlushSinks();
+    auto const end = Clock::now();
+
+    logger::ClearSinks();
+    Report(mode, std::chrono::duration<double>(end - start).count(), counting->Bytes());
+}
+
+logger::LogSinkPtr MakeMappedSink()
+{
+    logger::MappedFileSinkOptions options;
+    options.basePath    = kMappedPath;
+    options.segmentSize = kSegmentSize;
+    options.maxSegments = kMaxSegments;
+    return std::make_shared<logger::MappedFileSink>(options);
+}
+
+void RemoveMappedSegments()
+{
+    for (uint32_t ii = 0; ii < 64; ++ii) {
+        remove((std::string(kMappedPath) + "." + std::to_string(ii) + ".log").c_str());
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    logger::SetApplicationName("log-sink-benchmark");
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+
+    RunPlainStdio();
+    RunSink("logger + stdio file", std::make_shared<logger::FileSink>(kStdioPath), false);
+    remove(kStdioPath);
+    RunSink("logger + mapped file", MakeMappedSink(), false);
+    RemoveMappedSegments();
+    RunSink("async + stdio file", std::make_shared<logger::FileSink>(kStdioPath), true);
+    remove(kStdioPath);
+    RunSink("async + mapped file", MakeMappedSink(), true);
+    RemoveMappedSegments();
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Measures the latency of a single LOG_INFO call as seen by the caller
+// for the synchronous, asynchronous and binary logger backends.
+//
+// Log output goes to stdout and the report goes to stderr, so run with
+// stdout redirected to keep the terminal out of the measurement:
+//     logger-benchmark > /dev/null    (or > NUL on Windows)
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // sort
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/logger.h"
+
+namespace {
+
+using namespace physika::core;
+using Clock = std::chrono::steady_clock;
+
+int const kMessagesPerThread = 20000;
+int const kThreadCounts[]    = { 1, 4, 16 };
+
+struct Result
+{
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+};
+
+Result RunProducers(int threadCount)
+{
+    std::vector<std::vector<int64_t>> latencies(threadCount);
+    std::vector<std::thread>          threads;
+    threads.reserve(threadCount);
+
+    for (int tt = 0; tt < threadCount; ++tt) {
+        threads.emplace_back([tt, &latencies]() {
+            auto& samples = latencies[tt];
+            samples.reserve(kMessagesPerThread);
+            for (int ii = 0; ii < kMessagesPerThread; ++ii) {
+                auto const start = Clock::now();
+                logger::LOG_INFO("producer %d message %d value %f", tt, ii, ii * 0.5);
+                auto const end = Clock::now();
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<int64_t> all;
+    all.reserve(static_cast<size_t>(threadCount) * kMessagesPerThread);
+    for (auto const& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    Result result;
+    result.p50Ns = static_cast<double>(all[all.size() * 50 / 100]);
+    result.p99Ns = static_cast<double>(all[all.size() * 99 / 100]);
+    return result;
+}
+
+void Report(char const* mode, int threadCount, Result const& result)
+{
+    fprintf(stderr, "%-24s threads=%-3d p50=%10.1f ns  p99=%10.1f ns\n", mode, threadCount, result.p50Ns, result.p99Ns);
+}
+
+}  // namespace
+
+int main()
+{
+    logger::SetApplicationName("logger-benchmark");
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+
+    for (int threadCount : kThreadCounts) {
+        Report("sync", threadCount, RunProducers(threadCount));
+    }
+
+    logger::AsyncOptions dropOptions;
+    dropOptions.overflowPolicy = logger::OverflowPolicy::kDrop;
+    for (int threadCount : kThreadCounts) {
+        logger::EnableAsyncLogging(dropOptions);
+        Report("async (drop)", threadCount, RunProducers(threadCount));
+        logger::DisableAsyncLogging();
+    }
+
+    logger::AsyncOptions blockOptions;
+    blockOptions.overflowPolicy = logger::OverflowPolicy::kBlock;
+    blockOptions.flushTimeoutMs = 1000;
+    for (int threadCount : kThreadCounts) {
+        logger::EnableAsyncLogging(blockOptions);
+        Report("async (block)", threadCount, RunProducers(threadCount));
+        logger::DisableAsyncLogging();
+    }
+
+    size_t const kBinaryLogSize = size_t(256) << 20;
+    for (int threadCount : kThreadCounts) {
+        if (!logger::EnableBinaryLogging("logger-benchmark.binlog", kBinaryLogSize)) {
+            fprintf(stderr, "Could not create logger-benchmark.binlog\n");
+            return 1;
+        }
+        Report("binary", threadCount, RunProducers(threadCount));
+        logger::DisableBinaryLogging();
+    }
+    return 0;
+}
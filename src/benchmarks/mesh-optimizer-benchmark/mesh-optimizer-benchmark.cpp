@@ -0,0 +1,141 @@
+// Measures post-transform cache efficiency of uniform grids as generated,
+// with their triangles shuffled the way an unoptimized import looks, and
+// after OptimizeVertexCache, together with the time the optimizer takes.
+// ACMR and ATVR are reported for 16 and 32 entry FIFO caches.
+//
+// Then runs the whole OptimizeMesh pass on the shuffled grids and on a
+// cloud of overlapping cubes, where draw order decides the overdraw.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>  // move
+#include <vector>
+
+#include "renderer/mesh-optimizer.h"
+#include "renderer/primitive-generator.h"
+
+namespace {
+
+using namespace physika::renderer;
+using Clock    = std::chrono::steady_clock;
+using GridMesh = BasicMeshData<PositionVertex>;
+
+int const kGridSides[] = { 128, 2048 };
+int const kCubeCount   = 512;
+
+void ShuffleTriangles(GridMesh& mesh)
+{
+    std::vector<uint32_t> order(mesh.indices.size() / 3);
+    for (uint32_t ii = 0; ii < order.size(); ++ii) {
+        order[ii] = ii;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(12345));
+
+    std::vector<uint32_t> shuffled(mesh.indices.size());
+    for (size_t ii = 0; ii < order.size(); ++ii) {
+        std::copy_n(mesh.indices.data() + size_t(order[ii]) * 3, 3, shuffled.data() + ii * 3);
+    }
+    std::copy(shuffled.begin(), shuffled.end(), mesh.indices.begin());
+}
+
+//! Unit cubes scattered and turned through a box a few cubes wide, so most of them hide others.
+GridMesh CreateCubeCloud()
+{
+    GridMesh                              cloud;
+    GridMesh const                        cube = CreateCube<GridMesh>(1.0f);
+    std::mt19937                          random(6789);
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    for (int ii = 0; ii < kCubeCount; ++ii) {
+        uint32_t const base = static_cast<uint32_t>(cloud.VertexCount());
+        float const    x    = offset(random);
+        float const    y    = offset(random);
+        float const    z    = offset(random);
+        float const    yaw  = angle(random);
+        float const    cosA = cosf(yaw);
+        float const    sinA = sinf(yaw);
+        for (PositionVertex const& vertex : cube.vertices) {
+            DirectX::XMFLOAT3 const& p = vertex.position;
+            cloud.vertices.push_back({ { p.x * cosA - p.z * sinA + x, p.y + y, p.x * sinA + p.z * cosA + z } });
+        }
+        for (uint32_t index : cube.indices) {
+            cloud.indices.push_back(base + index);
+        }
+    }
+    ShuffleTriangles(cloud);
+    return cloud;
+}
+
+void PrintRow(char const* label, GridMesh const& mesh, double optimizeMs)
+{
+    VertexCacheStats const fifo16 = AnalyzeVertexCache(mesh, 16);
+    VertexCacheStats const fifo32 = AnalyzeVertexCache(mesh, 32);
+    printf("%-12s %8.3f %8.3f %8.3f %8.3f", label, fifo16.acmr, fifo16.atvr, fifo32.acmr, fifo32.atvr);
+    if (optimizeMs > 0.0) {
+        printf(" %10.1f ms", optimizeMs);
+    }
+    printf("\n");
+}
+
+void PrintStats(char const* label, MeshOptimizationStats const& stats)
+{
+    printf("%-12s %8.3f %8.3f %10.3f %9.3f\n", label, stats.vertexCache.acmr, stats.vertexCache.atvr,
+           stats.vertexFetch.overfetch, stats.overdraw.overdraw);
+}
+
+double Optimize(GridMesh& mesh)
+{
+    auto const start = Clock::now();
+    OptimizeVertexCache(mesh);
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void OptimizeWholeMesh(char const* name, GridMesh mesh)
+{
+    auto const                   start  = Clock::now();
+    MeshOptimizationReport const report = OptimizeMesh(mesh);
+    double const                 ms     = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    printf("\n%s: OptimizeMesh with analysis %.1f ms\n", name, ms);
+    printf("%-12s %8s %8s %10s %9s\n", "", "acmr16", "atvr16", "overfetch", "overdraw");
+    PrintStats("before", report.before);
+    PrintStats("after", report.after);
+}
+
+}  // namespace
+
+int main()
+{
+    std::vector<GridMesh> shuffledGrids;
+    for (int const side : kGridSides) {
+        GridMesh generated = CreateUniformGrid<GridMesh>(side, 1);
+        printf("\n%dx%d grid: %zu vertices, %zu triangles\n", side, side, generated.VertexCount(),
+               generated.indices.size() / 3);
+        printf("%-12s %8s %8s %8s %8s %13s\n", "order", "acmr16", "atvr16", "acmr32", "atvr32", "optimize");
+
+        GridMesh shuffled = generated;
+        ShuffleTriangles(shuffled);
+        shuffledGrids.push_back(shuffled);
+
+        PrintRow("generated", generated, 0.0);
+        PrintRow("shuffled", shuffled, 0.0);
+        double const fromGeneratedMs = Optimize(generated);
+        PrintRow("optimized", generated, fromGeneratedMs);
+        double const fromShuffledMs = Optimize(shuffled);
+        PrintRow("opt-shuffled", shuffled, fromShuffledMs);
+    }
+
+    char name[64];
+    for (size_t ii = 0; ii < shuffledGrids.size(); ++ii) {
+        snprintf(name, sizeof(name), "shuffled %dx%d grid", kGridSides[ii], kGridSides[ii]);
+        OptimizeWholeMesh(name, std::move(shuffledGrids[ii]));
+    }
+    snprintf(name, sizeof(name), "%d shuffled cubes", kCubeCount);
+    OptimizeWholeMesh(name, CreateCubeCloud());
+    return 0;
+}
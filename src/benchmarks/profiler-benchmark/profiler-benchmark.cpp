@@ -0,0 +1,75 @@
+// Measures the cost of a PROFILE_SCOPE, including recording the event,
+// for flat and nested scopes. Build with PHYSIKA_ENABLE_PROFILER=OFF to
+// confirm the compiled-out cost is zero.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#include "core/profiler.h"
+
+namespace {
+
+using namespace physika::core;
+using Clock = std::chrono::steady_clock;
+
+//! Stays below the per-thread buffer size so no scope is dropped.
+int const kScopesPerFrame = 8192;
+int const kFrames         = 200;
+
+//! Keeps the loops from being optimised away when the profiler is compiled out.
+volatile uint64_t sSink = 0;
+
+double RunFlat()
+{
+    double totalNs = 0.0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        auto const start = Clock::now();
+        for (int ii = 0; ii < kScopesPerFrame; ++ii) {
+            PROFILE_SCOPE("Flat");
+            sSink = sSink + 1;
+        }
+        totalNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        profiler::EndFrame();
+    }
+    return totalNs / (static_cast<double>(kFrames) * kScopesPerFrame);
+}
+
+double RunNested()
+{
+    double totalNs = 0.0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        auto const start = Clock::now();
+        for (int ii = 0; ii < kScopesPerFrame / 4; ++ii) {
+            PROFILE_SCOPE("Outer");
+            {
+                PROFILE_SCOPE("Middle");
+                {
+                    PROFILE_SCOPE("Inner");
+                    sSink = sSink + 1;
+                }
+                PROFILE_SCOPE("Tail");
+                sSink = sSink + 1;
+            }
+        }
+        totalNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        profiler::EndFrame();
+    }
+    return totalNs / (static_cast<double>(kFrames) * kScopesPerFrame);
+}
+
+}  // namespace
+
+int main()
+{
+    //! Warm up the clock calibration and the thread buffer.
+    RunFlat();
+
+    fprintf(stderr, "profiler enabled: %d\n", PHYSIKA_PROFILER_ENABLED);
+    fprintf(stderr, "flat scope    %8.1f ns/scope\n", RunFlat());
+    fprintf(stderr, "nested scopes %8.1f ns/scope\n", RunNested());
+    fprintf(stderr, "dropped scopes in last frame: %llu\n",
+            static_cast<unsigned long long>(profiler::LastFrame().droppedScopes));
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "core/application-headless.h"
+
+#include <thread>
+
+#include "core/logger.h"
+#include "core/profiler.h"
+
+using namespace physika::core;
+
+ApplicationHeadless::ApplicationHeadless(char const* const title, int width, int height)
+    : mWindowWidth(width),
+      mWindowHeight(height),
+      mWindowTitle(title),
+      mFrameLimit{ 0 },
+      mDurationLimit{ 0.0 },
+      mFrameCount{ 0 },
+      mSimulationRate{ 0.0 },
+      mSplitUpdate{ false },
+      mQuitRequested{ false },
+      mSimulationFinished{ false }
+{
+}
+
+bool ApplicationHeadless::Initialize()
+{
+    //! A window reports its initial size while it is created; do the same.
+    OnResize(mWindowWidth, mWindowHeight);
+    return true;
+}
+
+bool ApplicationHeadless::Shutdown()
+{
+    LogRunStatistics(mFramePacer.Stats(), mInput.Latency());
+    return true;
+}
+
+void* ApplicationHeadless::ApplicationHandle()
+{
+    return nullptr;
+}
+
+void* ApplicationHeadless::WindowHandle()
+{
+    return nullptr;
+}
+
+void ApplicationHeadless::SetTargetFrameRate(double framesPerSecond)
+{
+    mFramePacer.SetTargetPeriod(framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0);
+}
+
+void ApplicationHeadless::SetFrameLimit(uint64_t frames)
+{
+    mFrameLimit = frames;
+}
+
+void ApplicationHeadless::SetDurationLimit(double seconds)
+{
+    mDurationLimit = seconds > 0.0 ? seconds : 0.0;
+}
+
+void ApplicationHeadless::RequestQuit()
+{
+    mQuitRequested.store(true, std::memory_order_release);
+}
+
+void ApplicationHeadless::SetSplitUpdate(bool split)
+{
+    mSplitUpdate = split;
+}
+
+void ApplicationHeadless::SetSimulationRate(double ticksPerSecond)
+{
+    mSimulationRate = ticksPerSecond > 0.0 ? ticksPerSecond : 0.0;
+}
+
+uint64_t ApplicationHeadless::SimulationCount() const
+{
+    return mInput.FrameCount();
+}
+
+void ApplicationHeadless::DispatchInputEvent(InputEvent const& event)
+{
+    mInput.Dispatch(*this, event);
+}
+
+void ApplicationHeadless::PostInputEvent(InputEvent const& event)
+{
+    mInput.Post(event);
+}
+
+InputState const& ApplicationHeadless::Input() const
+{
+    return mInput.State();
+}
+
+InputLatencyStats ApplicationHeadless::InputLatency() const
+{
+    return mInput.Latency();
+}
+
+void ApplicationHeadless::SetInputRecorder(InputRecorder* recorder)
+{
+    mInput.SetRecorder(recorder);
+}
+
+void ApplicationHeadless::SetInputReplay(InputReplay* replay)
+{
+    mInput.SetReplay(replay);
+}
+
+bool ApplicationHeadless::IsReplayingInput() const
+{
+    return mInput.IsReplaying();
+}
+
+uint64_t ApplicationHeadless::FrameCount() const
+{
+    return mFrameCount;
+}
+
+void ApplicationHeadless::Run()
+{
+    mQuitRequested.store(false, std::memory_order_relaxed);
+    mSimulationFinished.store(false, std::memory_order_relaxed);
+    mFrameCount = 0;
+    mInput.BeginRun();
+    mRunTimer.Reset();
+    mRunTimer.Start();
+
+    //! In split mode input is consumed with the simulation ticks, not the rendered frames.
+    std::thread simulation;
+    if (mSplitUpdate) {
+        simulation = std::thread([this]() {
+            double const tickPeriod = mSimulationRate > 0.0 ? 1.0 / mSimulationRate : mFramePacer.TargetPeriod();
+            RunSimulationLoop(*this, mInput, tickPeriod, mQuitRequested);
+            mSimulationFinished.store(true, std::memory_order_release);
+        });
+    }
+
+    while (!mQuitRequested.load(std::memory_order_acquire)) {
+        logger::UpdateLogClock();
+        if (mSplitUpdate ? mSimulationFinished.load(std::memory_order_acquire) : !mInput.Consume(*this)) {
+            break;
+        }
+        {
+            PROFILE_SCOPE("Frame");
+            if (mSplitUpdate) {
+                OnRender();
+            } else {
+                OnUpdate();
+            }
+        }
+        PROFILE_END_FRAME();
+        mFramePacer.WaitForNextFrame();
+        mFrameCount += 1;
+        if (!mSplitUpdate) {
+            mInput.EndFrame();
+        }
+
+        mRunTimer.Tick();
+        if (mFrameLimit > 0 && mFrameCount >= mFrameLimit) {
+            break;
+        }
+        if (mDurationLimit > 0.0 && mRunTimer.TotalRunningTimeSeconds() >= mDurationLimit) {
+            break;
+        }
+    }
+
+    if (simulation.joinable()) {
+        mQuitRequested.store(true, std::memory_order_release);
+        simulation.join();
+    }
+    mRunTimer.Stop();
+    logger::ResetLogClock();
+    mInput.EndRun();
+}
+
+void ApplicationHeadless::OnUpdate()
+{
+    OnSimulate();
+    OnRender();
+}
+
+void ApplicationHeadless::OnSimulate()
+{
+}
+
+void ApplicationHeadless::OnRender()
+{
+}
+
+void ApplicationHeadless::OnResize(int /*width*/, int /*height*/)
+{
+}
+
+void ApplicationHeadless::OnKeyUp(Keycode /*key*/)
+{
+}
+
+void ApplicationHeadless::OnKeyDown(Keycode /*key*/)
+{
+}
+
+void ApplicationHeadless::OnMouseUp(MouseButton /*button*/, int /*x*/, int /*y*/)
+{
+}
+
+void ApplicationHeadless::OnMouseDown(MouseButton /*button*/, int /*x*/, int /*y*/)
+{
+}
+
+void ApplicationHeadless::OnMouseMove(int /*x*/, int /*y*/)
+{
+}
+
+void ApplicationHeadless::OnMouseWheel(int /*delta*/)
+{
+}
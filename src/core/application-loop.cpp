@@ -0,0 +1,90 @@
+#include "core/application-loop.h"
+
+#include "core/logger.h"
+
+namespace physika::core {
+
+ApplicationInput::ApplicationInput()
+    : mRecorder{ nullptr },
+      mReplay{ nullptr },
+      mFrame{ 0 }
+{
+}
+
+void ApplicationInput::EndFrame()
+{
+    mFrame += 1;
+}
+
+void ApplicationInput::Post(InputEvent const& event)
+{
+    if (!mQueue.Post(event)) {
+        PHI_LOG_WARN_EVERY_MS(kApplication, 1000, "Input queue full; dropping input events");
+    }
+}
+
+void ApplicationInput::BeginRun()
+{
+    mFrame = 0;
+}
+
+void ApplicationInput::EndRun()
+{
+    if (mRecorder) {
+        mRecorder->Finish(mFrame);
+    }
+}
+
+void ApplicationInput::SetRecorder(InputRecorder* recorder)
+{
+    if (mRecorder && mRecorder != recorder) {
+        mRecorder->Finish(mFrame);
+    }
+    mRecorder = recorder;
+}
+
+void ApplicationInput::SetReplay(InputReplay* replay)
+{
+    mReplay = replay;
+    if (mReplay) {
+        mReplay->Restart();
+    }
+}
+
+bool ApplicationInput::IsReplaying() const
+{
+    return mReplay != nullptr;
+}
+
+InputState const& ApplicationInput::State() const
+{
+    return mState;
+}
+
+InputLatencyStats ApplicationInput::Latency() const
+{
+    return mQueue.Latency();
+}
+
+uint64_t ApplicationInput::FrameCount() const
+{
+    return mFrame;
+}
+
+void LogRunStatistics(FramePacerStats const& pacing, InputLatencyStats const& latency)
+{
+    if (pacing.frames > 0) {
+        logger::LOG_INFO("Frame pacing over %llu frames: mean error %.3f ms, max %.3f ms, %llu missed, "
+                         "spin margin %.3f ms, %.0f%% of waiting asleep",
+                         static_cast<unsigned long long>(pacing.frames), pacing.meanAbsErrorMs, pacing.maxErrorMs,
+                         static_cast<unsigned long long>(pacing.missedFrames), pacing.sleepSlackMs,
+                         pacing.sleepFraction * 100.0);
+    }
+    if (latency.events > 0) {
+        logger::LOG_INFO("Input latency over %llu events: mean %.3f ms, max %.3f ms, %llu dropped",
+                         static_cast<unsigned long long>(latency.events), latency.meanMs, latency.maxMs,
+                         static_cast<unsigned long long>(latency.dropped));
+    }
+}
+
+}  // namespace physika::core
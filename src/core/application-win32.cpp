@@ -5,6 +5,13 @@
 #include <crtdbg.h>
 #include <stdio.h>
 #include <windows.h>
+// after windows.h
+#include <timeapi.h>
+
+#include <thread>
+
+#include "core/logger.h"
+#include "core/profiler.h"
 
 namespace {
 using namespace physika::core;
@@ -182,6 +189,20 @@ Keycode MapKeyWin32ToPhi(WPARAM wParam)
     }
 }
 
+//! Live input is dropped while a replay drives the application.
+void DeliverInput(InputEventType type, int code, int x, int y)
+{
+    if (sApp->IsReplayingInput()) {
+        return;
+    }
+    InputEvent event;
+    event.type = type;
+    event.code = code;
+    event.x    = x;
+    event.y    = y;
+    sApp->PostInputEvent(event);
+}
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 {
     int x      = 0;
@@ -195,10 +216,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
     case WM_PAINT:
         break;
     case WM_KEYUP:
-        sApp->OnKeyUp(MapKeyWin32ToPhi(wParam));
+        DeliverInput(InputEventType::kKeyUp, MapKeyWin32ToPhi(wParam), 0, 0);
         break;
     case WM_KEYDOWN:
-        sApp->OnKeyDown(MapKeyWin32ToPhi(wParam));
+        DeliverInput(InputEventType::kKeyDown, MapKeyWin32ToPhi(wParam), 0, 0);
         break;
     case WM_CHAR:
         break;
@@ -207,56 +228,56 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
         y = HIWORD(lParam);
         mouseButton |= kMouseLeft;
         mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseDown(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseDown, mouseButton, x, y);
         break;
     case WM_MBUTTONDOWN:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
         mouseButton |= kMouseMiddle;
         mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseDown(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseDown, mouseButton, x, y);
         break;
     case WM_RBUTTONDOWN:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
         mouseButton |= kMouseRight;
         mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseDown(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseDown, mouseButton, x, y);
         break;
     case WM_LBUTTONUP:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
+        //! wParam lists the buttons still held; the event names only the released one.
         mouseButton |= kMouseLeft;
-        mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseUp(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseUp, mouseButton, x, y);
         break;
     case WM_MBUTTONUP:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
+        //! wParam lists the buttons still held; the event names only the released one.
         mouseButton |= kMouseMiddle;
-        mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseUp(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseUp, mouseButton, x, y);
         break;
     case WM_RBUTTONUP:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
+        //! wParam lists the buttons still held; the event names only the released one.
         mouseButton |= kMouseRight;
-        mouseButton |= MapMouseWin32ToPhi(wParam);
-        sApp->OnMouseUp(mouseButton, x, y);
+        DeliverInput(InputEventType::kMouseUp, mouseButton, x, y);
         break;
     case WM_MOUSEMOVE:
         x = LOWORD(lParam);
         y = HIWORD(lParam);
-        sApp->OnMouseMove(x, y);
+        DeliverInput(InputEventType::kMouseMove, 0, x, y);
         break;
     case WM_MOUSEWHEEL:
         delta = GET_WHEEL_DELTA_WPARAM(wParam);
-        sApp->OnMouseWheel(delta);
+        DeliverInput(InputEventType::kMouseWheel, delta, 0, 0);
         break;
     case WM_SIZE:
         width  = LOWORD(lParam);
         height = HIWORD(lParam);
-        sApp->OnResize(width, height);
+        sApp->PostResize(width, height);
         break;
     case WM_DESTROY: {
         assert(DestroyWindow(hWnd) && "Failed to destroy window successfully");
@@ -275,7 +296,19 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 using namespace physika::core;
 
 ApplicationWin32::ApplicationWin32(TCHAR const* const title, int width, int height)
-    : mWindowTitle(title), mWindowWidth(width), mWindowHeight(height), mHinstance{ nullptr }, mHwnd{ nullptr }
+    : mWindowTitle(title),
+      mWindowWidth(width),
+      mWindowHeight(height),
+      mHinstance{ nullptr },
+      mHwnd{ nullptr },
+      mFrameCount{ 0 },
+      mSimulationRate{ 0.0 },
+      mThreadedUpdate{ false },
+      mSplitUpdate{ false },
+      mSimulationFinished{ false },
+      mUpdateThreadRunning{ false },
+      mQuitUpdate{ false },
+      mPendingResize{ kNoPendingResize }
 {
 }
 
@@ -324,6 +357,7 @@ bool ApplicationWin32::Initialize()
 
 bool ApplicationWin32::Shutdown()
 {
+    LogRunStatistics(mFramePacer.Stats(), mInput.Latency());
     //! Derived classes can add logic to control game shutdown sequence
     return true;
 }
@@ -338,24 +372,187 @@ void* ApplicationWin32::WindowHandle()
     return mHwnd;
 }
 
+void ApplicationWin32::DispatchInputEvent(InputEvent const& event)
+{
+    mInput.Dispatch(*this, event);
+}
+
+void ApplicationWin32::PostInputEvent(InputEvent const& event)
+{
+    mInput.Post(event);
+}
+
+void ApplicationWin32::PostResize(int width, int height)
+{
+    if (!mUpdateThreadRunning.load(std::memory_order_acquire)) {
+        OnResize(width, height);
+        return;
+    }
+    //! Only the latest size matters; the update thread applies it before its next frame.
+    mPendingResize.store((static_cast<int64_t>(width) << 32) | static_cast<uint32_t>(height), std::memory_order_release);
+}
+
+void ApplicationWin32::SetThreadedUpdate(bool threaded)
+{
+    mThreadedUpdate = threaded;
+}
+
+InputState const& ApplicationWin32::Input() const
+{
+    return mInput.State();
+}
+
+InputLatencyStats ApplicationWin32::InputLatency() const
+{
+    return mInput.Latency();
+}
+
+void ApplicationWin32::SetInputRecorder(InputRecorder* recorder)
+{
+    mInput.SetRecorder(recorder);
+}
+
+void ApplicationWin32::SetInputReplay(InputReplay* replay)
+{
+    mInput.SetReplay(replay);
+}
+
+bool ApplicationWin32::IsReplayingInput() const
+{
+    return mInput.IsReplaying();
+}
+
+void ApplicationWin32::SetTargetFrameRate(double framesPerSecond)
+{
+    mFramePacer.SetTargetPeriod(framesPerSecond > 0.0 ? 1.0 / framesPerSecond : 0.0);
+}
+
+void ApplicationWin32::SetSplitUpdate(bool split)
+{
+    mSplitUpdate = split;
+}
+
+void ApplicationWin32::SetSimulationRate(double ticksPerSecond)
+{
+    mSimulationRate = ticksPerSecond > 0.0 ? ticksPerSecond : 0.0;
+}
+
+uint64_t ApplicationWin32::FrameCount() const
+{
+    return mFrameCount;
+}
+
+uint64_t ApplicationWin32::SimulationCount() const
+{
+    return mInput.FrameCount();
+}
+
+bool ApplicationWin32::RunFrame()
+{
+    logger::UpdateLogClock();
+    int64_t const resize = mPendingResize.exchange(kNoPendingResize, std::memory_order_acquire);
+    if (resize != kNoPendingResize) {
+        OnResize(static_cast<int>(resize >> 32), static_cast<int>(resize & 0xFFFFFFFF));
+    }
+
+    if (mSplitUpdate ? mSimulationFinished.load(std::memory_order_acquire) : !mInput.Consume(*this)) {
+        return false;
+    }
+    {
+        PROFILE_SCOPE("Frame");
+        if (mSplitUpdate) {
+            OnRender();
+        } else {
+            OnUpdate();
+        }
+    }
+    PROFILE_END_FRAME();
+    mFramePacer.WaitForNextFrame();
+    mFrameCount += 1;
+    if (!mSplitUpdate) {
+        mInput.EndFrame();
+    }
+    return true;
+}
+
 void ApplicationWin32::Run()
 {
+    //! Sleep() rounds up to the 15.6 ms system tick unless the resolution is raised.
+    bool const paced = mFramePacer.TargetPeriod() > 0.0 || mSimulationRate > 0.0;
+    if (paced) {
+        timeBeginPeriod(1);
+    }
+
+    mQuitUpdate.store(false, std::memory_order_relaxed);
+    mSimulationFinished.store(false, std::memory_order_relaxed);
+    mInput.BeginRun();
+
+    //! In split mode input is consumed with the simulation ticks, not the rendered frames.
+    std::thread simulation;
+    if (mSplitUpdate) {
+        simulation = std::thread([this]() {
+            double const tickPeriod = mSimulationRate > 0.0 ? 1.0 / mSimulationRate : mFramePacer.TargetPeriod();
+            RunSimulationLoop(*this, mInput, tickPeriod, mQuitUpdate);
+            mSimulationFinished.store(true, std::memory_order_release);
+        });
+    }
+
     MSG msg;
     ZeroMemory(&msg, sizeof(msg));
-    while (1) {
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+    if (mThreadedUpdate) {
+        //! Frames run on their own thread; this thread only pumps messages and never waits on a frame.
+        mUpdateThreadRunning.store(true, std::memory_order_release);
+        std::thread update([this]() {
+            while (!mQuitUpdate.load(std::memory_order_acquire)) {
+                if (!RunFrame()) {
+                    PostMessage(mHwnd, WM_CLOSE, 0, 0);
+                    break;
+                }
+            }
+        });
+        while (GetMessage(&msg, nullptr, 0, 0) > 0) {
             TranslateMessage(&msg);
             DispatchMessage(&msg);
         }
-        if (msg.message == WM_QUIT) {
-            break;
-        } else {
-            OnUpdate();
+        mQuitUpdate.store(true, std::memory_order_release);
+        update.join();
+        mUpdateThreadRunning.store(false, std::memory_order_release);
+    } else {
+        while (1) {
+            //! Drain every pending message; a paced frame may have queued several.
+            while (msg.message != WM_QUIT && PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+            }
+            if (msg.message == WM_QUIT || !RunFrame()) {
+                break;
+            }
         }
     }
+
+    if (simulation.joinable()) {
+        mQuitUpdate.store(true, std::memory_order_release);
+        simulation.join();
+    }
+    logger::ResetLogClock();
+    mInput.EndRun();
+
+    if (paced) {
+        timeEndPeriod(1);
+    }
 }
 
 void ApplicationWin32::OnUpdate()
+{
+    OnSimulate();
+    OnRender();
+}
+
+void ApplicationWin32::OnSimulate()
+{
+}
+
+void ApplicationWin32::OnRender()
 {
 }
 
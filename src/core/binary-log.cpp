@@ -0,0 +1,534 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>  // min
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/logger.h"
+#include "core/mapped-file.h"
+
+/*
+    Binary log file layout. All integers are stored in native byte order.
+
+    FileHeader
+    Record 0
+    Record 1
+    ...
+    Zero filled tail (a record size of zero terminates the stream)
+
+    Every record starts with a 16 byte RecordHeader. Format records carry
+    the null terminated format string and are written the first time a
+    format string pointer is seen. Message records carry the arguments,
+    each encoded as a one byte tag followed by its payload:
+
+        kSigned/kUnsigned   value in (tag & 0xF) bytes
+        kFloat              double
+        kString             uint16_t length followed by the characters
+        kPointer            uint64_t address
+*/
+
+namespace {
+
+using namespace physika::core;
+using namespace physika::core::logger;
+
+char const     kMagic[8]          = { 'P', 'H', 'X', 'B', 'L', 'O', 'G', '\0' };
+uint32_t const kFormatVersion     = 1;
+size_t const   kFormatTableSize   = 4096;
+size_t const   kMaxRecordSize     = UINT16_MAX;
+uint8_t const  kFormatRecordType  = 1;
+uint8_t const  kMessageRecordType = 2;
+
+//! Format of messages LogBinaryFormatted stores as text, and their size limit.
+char const   kPreformatted[]   = "%s";
+size_t const kPreformattedSize = 2048;
+
+struct FileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t startTimestamp;
+    char     applicationName[232];
+};
+
+struct RecordHeader
+{
+    uint16_t size;
+    uint8_t  type;
+    uint8_t  level;
+    uint32_t formatId;
+    uint64_t timestamp;
+};
+
+static_assert(sizeof(FileHeader) == 256, "Binary log header layout changed");
+static_assert(sizeof(RecordHeader) == 16, "Binary log record layout changed");
+
+//! Maps format string pointers to the ids written in the file.
+struct FormatSlot
+{
+    std::atomic<char const*> format{ nullptr };
+    std::atomic<uint32_t>    id{ 0 };
+};
+
+MappedFile            sFile;
+std::atomic<size_t>   sWriteOffset{ 0 };
+std::atomic<uint64_t> sDroppedRecords{ 0 };
+std::atomic<uint32_t> sNextFormatId{ 1 };
+FormatSlot            sFormatTable[kFormatTableSize];
+
+uint64_t TimestampNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint8_t* Reserve(size_t size)
+{
+    size_t const offset = sWriteOffset.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > sFile.Size()) {
+        sDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return sFile.Data() + offset;
+}
+
+void WriteFormatRecord(uint32_t id, char const* format)
+{
+    size_t const length = strlen(format) + 1;
+    size_t const size   = sizeof(RecordHeader) + length;
+    if (size > kMaxRecordSize) {
+        return;
+    }
+    uint8_t* dst = Reserve(size);
+    if (!dst) {
+        return;
+    }
+    RecordHeader header = { static_cast<uint16_t>(size), kFormatRecordType, 0, id, 0 };
+    memcpy(dst + sizeof(RecordHeader), format, length);
+    memcpy(dst, &header, sizeof(RecordHeader));
+}
+
+//! Returns the id for a format string, registering it on first use.
+//! Returns zero if the table is full.
+uint32_t FormatId(char const* format)
+{
+    size_t const hash = (reinterpret_cast<uintptr_t>(format) >> 3) * 0x9E3779B97F4A7C15ull;
+    for (size_t probe = 0; probe < kFormatTableSize; ++probe) {
+        FormatSlot& slot = sFormatTable[(hash + probe) & (kFormatTableSize - 1)];
+
+        char const* key = slot.format.load(std::memory_order_acquire);
+        if (!key && slot.format.compare_exchange_strong(key, format, std::memory_order_acq_rel)) {
+            uint32_t const id = sNextFormatId.fetch_add(1, std::memory_order_relaxed);
+            WriteFormatRecord(id, format);
+            slot.id.store(id, std::memory_order_release);
+            return id;
+        }
+        if (key == format) {
+            //! Another thread may still be publishing this entry.
+            uint32_t id = slot.id.load(std::memory_order_acquire);
+            while (id == 0) {
+                id = slot.id.load(std::memory_order_acquire);
+            }
+            return id;
+        }
+    }
+    return 0;
+}
+
+//! Decoding
+
+struct DecodedArg
+{
+    detail::ArgType type          = detail::ArgType::kSigned;
+    int64_t         signedValue   = 0;
+    uint64_t        unsignedValue = 0;
+    double          floatValue    = 0.0;
+    std::string     stringValue;
+};
+
+bool ReadArg(uint8_t const*& cursor, uint8_t const* end, DecodedArg& arg)
+{
+    if (cursor >= end) {
+        return false;
+    }
+    uint8_t const tag  = *cursor++;
+    size_t const  size = tag & 0xF;
+    arg.type           = static_cast<detail::ArgType>(tag >> 4);
+
+    switch (arg.type) {
+    case detail::ArgType::kSigned: {
+        if (size > sizeof(int64_t) || cursor + size > end) {
+            return false;
+        }
+        //! Sign extend from the stored width.
+        uint64_t raw = 0;
+        memcpy(&raw, cursor, size);
+        int const shift = static_cast<int>(64 - size * 8);
+        arg.signedValue = shift == 64 ? 0 : static_cast<int64_t>(raw << shift) >> shift;
+        break;
+    }
+    case detail::ArgType::kUnsigned:
+    case detail::ArgType::kPointer:
+        if (size > sizeof(uint64_t) || cursor + size > end) {
+            return false;
+        }
+        arg.unsignedValue = 0;
+        memcpy(&arg.unsignedValue, cursor, size);
+        break;
+    case detail::ArgType::kFloat:
+        if (size != sizeof(double) || cursor + size > end) {
+            return false;
+        }
+        memcpy(&arg.floatValue, cursor, size);
+        break;
+    case detail::ArgType::kString: {
+        uint16_t length = 0;
+        if (cursor + sizeof(length) > end) {
+            return false;
+        }
+        memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        if (cursor + length > end) {
+            return false;
+        }
+        arg.stringValue.assign(reinterpret_cast<char const*>(cursor), length);
+        cursor += length;
+        return true;
+    }
+    default:
+        return false;
+    }
+    cursor += size;
+    return true;
+}
+
+int64_t AsSigned(DecodedArg const& arg)
+{
+    switch (arg.type) {
+    case detail::ArgType::kSigned:
+        return arg.signedValue;
+    case detail::ArgType::kFloat:
+        return static_cast<int64_t>(arg.floatValue);
+    default:
+        return static_cast<int64_t>(arg.unsignedValue);
+    }
+}
+
+uint64_t AsUnsigned(DecodedArg const& arg)
+{
+    return arg.type == detail::ArgType::kSigned ? static_cast<uint64_t>(arg.signedValue)
+                                                : static_cast<uint64_t>(AsSigned(arg));
+}
+
+double AsDouble(DecodedArg const& arg)
+{
+    switch (arg.type) {
+    case detail::ArgType::kFloat:
+        return arg.floatValue;
+    case detail::ArgType::kSigned:
+        return static_cast<double>(arg.signedValue);
+    default:
+        return static_cast<double>(arg.unsignedValue);
+    }
+}
+
+template <typename T>
+void AppendFormatted(std::string& output, std::string const& spec, T value)
+{
+    char buffer[512];
+    int  length = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    if (length > 0) {
+        output.append(buffer, std::min<size_t>(length, sizeof(buffer) - 1));
+    }
+}
+
+//! Re-applies a printf style format string to decoded arguments. Length
+//! modifiers in the format are replaced with ones that match the stored
+//! argument width, so mismatched specifiers still print sensibly.
+std::string FormatMessage(char const* format, std::vector<DecodedArg> const& args)
+{
+    std::string output;
+    size_t      argIndex = 0;
+    auto        nextArg  = [&args, &argIndex]() -> DecodedArg const* {
+        return argIndex < args.size() ? &args[argIndex++] : nullptr;
+    };
+
+    for (char const* cursor = format; *cursor; ++cursor) {
+        if (*cursor != '%') {
+            output.push_back(*cursor);
+            continue;
+        }
+        if (cursor[1] == '%') {
+            output.push_back('%');
+            ++cursor;
+            continue;
+        }
+
+        std::string spec = "%";
+        ++cursor;
+        while (*cursor && strchr("-+ #0", *cursor)) {
+            spec.push_back(*cursor++);
+        }
+        for (int part = 0; part < 2; ++part) {
+            if (part == 1) {
+                if (*cursor != '.') {
+                    break;
+                }
+                spec.push_back(*cursor++);
+            }
+            if (*cursor == '*') {
+                DecodedArg const* star = nextArg();
+                spec += std::to_string(star ? AsSigned(*star) : 0);
+                ++cursor;
+            }
+            while (*cursor >= '0' && *cursor <= '9') {
+                spec.push_back(*cursor++);
+            }
+        }
+        while (*cursor && strchr("hljztLq", *cursor)) {
+            ++cursor;
+        }
+        char const conversion = *cursor;
+        if (!conversion) {
+            break;
+        }
+
+        DecodedArg const* arg = nextArg();
+        if (!arg) {
+            output += "<missing>";
+            continue;
+        }
+        switch (conversion) {
+        case 'd':
+        case 'i':
+            AppendFormatted(output, spec + "lld", static_cast<long long>(AsSigned(*arg)));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            AppendFormatted(output, spec + "ll" + conversion, static_cast<unsigned long long>(AsUnsigned(*arg)));
+            break;
+        case 'c':
+            AppendFormatted(output, spec + "c", static_cast<int>(AsSigned(*arg)));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            AppendFormatted(output, spec + conversion, AsDouble(*arg));
+            break;
+        case 's':
+            if (arg->type == detail::ArgType::kString) {
+                AppendFormatted(output, spec + "s", arg->stringValue.c_str());
+            } else {
+                output += "<non-string>";
+            }
+            break;
+        case 'p':
+            AppendFormatted(output, spec + "p", reinterpret_cast<void*>(static_cast<uintptr_t>(AsUnsigned(*arg))));
+            break;
+        default:
+            output.push_back('%');
+            output.push_back(conversion);
+            break;
+        }
+    }
+    return output;
+}
+
+}  // namespace
+
+namespace physika::core::logger {
+
+namespace detail {
+
+uint8_t* BeginBinaryRecord(LogLevel level, char const* format, size_t argBytes)
+{
+    size_t const size = sizeof(RecordHeader) + argBytes;
+    if (size > kMaxRecordSize) {
+        sDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    uint32_t const formatId = FormatId(format);
+    if (formatId == 0) {
+        sDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    uint8_t* dst = Reserve(size);
+    if (!dst) {
+        return nullptr;
+    }
+    RecordHeader header = { static_cast<uint16_t>(size), kMessageRecordType, static_cast<uint8_t>(level), formatId,
+                            TimestampNs() };
+    memcpy(dst, &header, sizeof(RecordHeader));
+    return dst + sizeof(RecordHeader);
+}
+
+void LogBinaryFormatted(LogLevel level, char const* format, ...)
+{
+    char    text[kPreformattedSize];
+    va_list args;
+    va_start(args, format);
+    int const length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    uint16_t const textLength = static_cast<uint16_t>(std::min<size_t>(length < 0 ? 0 : length, sizeof(text) - 1));
+    uint8_t*       dst        = BeginBinaryRecord(level, kPreformatted, 1 + sizeof(textLength) + textLength);
+    if (!dst) {
+        return;
+    }
+    *dst++ = MakeArgTag(ArgType::kString, 0);
+    memcpy(dst, &textLength, sizeof(textLength));
+    memcpy(dst + sizeof(textLength), text, textLength);
+}
+
+size_t FormatEncodedMessage(char* buffer, size_t bufferSize, char const* format, uint8_t const* args, size_t argBytes)
+{
+    if (bufferSize == 0) {
+        return 0;
+    }
+    std::vector<DecodedArg> decoded;
+    DecodedArg              arg;
+    uint8_t const*          cursor = args;
+    while (cursor < args + argBytes && ReadArg(cursor, args + argBytes, arg)) {
+        decoded.push_back(arg);
+    }
+
+    std::string const message = FormatMessage(format, decoded);
+    size_t const      length  = std::min(message.size(), bufferSize - 1);
+    memcpy(buffer, message.data(), length);
+    buffer[length] = '\0';
+    return length;
+}
+
+}  // namespace detail
+
+bool EnableBinaryLogging(char const* path, size_t capacityBytes)
+{
+    if (IsBinaryLoggingEnabled() || capacityBytes <= sizeof(FileHeader)) {
+        return false;
+    }
+    if (!sFile.Create(path, capacityBytes)) {
+        LOG_ERROR("Failed to create binary log file %s", path);
+        return false;
+    }
+
+    for (auto& slot : sFormatTable) {
+        slot.format.store(nullptr, std::memory_order_relaxed);
+        slot.id.store(0, std::memory_order_relaxed);
+    }
+    sNextFormatId.store(1, std::memory_order_relaxed);
+    sDroppedRecords.store(0, std::memory_order_relaxed);
+
+    FileHeader header = {};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version        = kFormatVersion;
+    header.headerSize     = sizeof(FileHeader);
+    header.startTimestamp = TimestampNs();
+    snprintf(header.applicationName, sizeof(header.applicationName), "%s", ApplicationName());
+    memcpy(sFile.Data(), &header, sizeof(header));
+
+    sWriteOffset.store(sizeof(FileHeader), std::memory_order_relaxed);
+    detail::sBinaryLoggingEnabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void DisableBinaryLogging()
+{
+    if (!IsBinaryLoggingEnabled()) {
+        return;
+    }
+    detail::sBinaryLoggingEnabled.store(false, std::memory_order_release);
+
+    size_t const usedBytes = std::min(sWriteOffset.load(std::memory_order_acquire), sFile.Size());
+    sFile.Close(usedBytes);
+
+    uint64_t const dropped = sDroppedRecords.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        LOG_WARN("Binary logger dropped %llu records", static_cast<unsigned long long>(dropped));
+    }
+}
+
+bool IsBinaryLoggingEnabled()
+{
+    return detail::sBinaryLoggingEnabled.load(std::memory_order_acquire);
+}
+
+bool DecodeBinaryLog(char const* path, FILE* output, bool printTimestamps)
+{
+    MappedFile file;
+    if (!output || !file.OpenReadOnly(path) || file.Size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    memcpy(&header, file.Data(), sizeof(header));
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion ||
+        header.headerSize < sizeof(FileHeader) || header.headerSize > file.Size()) {
+        return false;
+    }
+    header.applicationName[sizeof(header.applicationName) - 1] = '\0';
+
+    uint8_t const* const begin = file.Data() + header.headerSize;
+    uint8_t const* const end   = file.Data() + file.Size();
+
+    //! First pass collects format strings so records can be decoded
+    //! regardless of the order in which concurrent writers finished.
+    std::unordered_map<uint32_t, char const*> formats;
+    for (uint8_t const* cursor = begin; cursor + sizeof(RecordHeader) <= end;) {
+        RecordHeader record;
+        memcpy(&record, cursor, sizeof(record));
+        if (record.size < sizeof(RecordHeader) || cursor + record.size > end) {
+            break;
+        }
+        if (record.type == kFormatRecordType && cursor[record.size - 1] == '\0') {
+            formats[record.formatId] = reinterpret_cast<char const*>(cursor + sizeof(RecordHeader));
+        }
+        cursor += record.size;
+    }
+
+    std::vector<DecodedArg> args;
+    for (uint8_t const* cursor = begin; cursor + sizeof(RecordHeader) <= end;) {
+        RecordHeader record;
+        memcpy(&record, cursor, sizeof(record));
+        if (record.size < sizeof(RecordHeader) || cursor + record.size > end) {
+            break;
+        }
+        uint8_t const* payload    = cursor + sizeof(RecordHeader);
+        uint8_t const* payloadEnd = cursor + record.size;
+        cursor                    = payloadEnd;
+        if (record.type != kMessageRecordType) {
+            continue;
+        }
+
+        args.clear();
+        DecodedArg arg;
+        while (payload < payloadEnd && ReadArg(payload, payloadEnd, arg)) {
+            args.push_back(arg);
+        }
+
+        auto const  format  = formats.find(record.formatId);
+        std::string message = format != formats.end() ? FormatMessage(format->second, args)
+                                                      : "<unknown format " + std::to_string(record.formatId) + ">";
+        if (printTimestamps) {
+            double const seconds = static_cast<double>(record.timestamp - header.startTimestamp) * 1e-9;
+            fprintf(output, "[%12.6f] ", seconds);
+        }
+        fprintf(output, "[%s] [%s]: %s\n", header.applicationName, StringifyLogLevel(static_cast<LogLevel>(record.level)),
+                message.c_str());
+    }
+    return true;
+}
+
+}  // namespace physika::core::logger
@@ -0,0 +1,68 @@
+#include "core/fixed-timestep.h"
+
+#include <math.h>  // llround
+
+#include <algorithm>  // max
+
+namespace {
+
+double const kNanosecondsPerSecond = 1e9;
+
+}  // namespace
+
+namespace physika::core {
+
+FixedTimestep::FixedTimestep(double stepSeconds, uint32_t maxSubsteps)
+    : mStepNs{ std::max<int64_t>(llround(stepSeconds * kNanosecondsPerSecond), 1) },
+      mMaxSubsteps{ std::max(maxSubsteps, 1u) },
+      mAccumulatorNs{ 0 },
+      mTotalSteps{ 0 },
+      mDroppedSteps{ 0 }
+{
+}
+
+uint32_t FixedTimestep::Advance(double frameSeconds)
+{
+    if (frameSeconds > 0.0) {
+        mAccumulatorNs += llround(frameSeconds * kNanosecondsPerSecond);
+    }
+
+    int64_t steps = mAccumulatorNs / mStepNs;
+    mAccumulatorNs -= steps * mStepNs;
+    if (steps > mMaxSubsteps) {
+        //! Give up on the backlog but keep the fraction so Alpha stays smooth.
+        mDroppedSteps += static_cast<uint64_t>(steps - mMaxSubsteps);
+        steps = mMaxSubsteps;
+    }
+    mTotalSteps += static_cast<uint64_t>(steps);
+    return static_cast<uint32_t>(steps);
+}
+
+double FixedTimestep::Alpha() const
+{
+    return static_cast<double>(mAccumulatorNs) / static_cast<double>(mStepNs);
+}
+
+double FixedTimestep::StepSeconds() const
+{
+    return static_cast<double>(mStepNs) / kNanosecondsPerSecond;
+}
+
+uint64_t FixedTimestep::TotalSteps() const
+{
+    return mTotalSteps;
+}
+
+uint64_t FixedTimestep::DroppedSteps() const
+{
+    return mDroppedSteps;
+}
+
+void FixedTimestep::Reset()
+{
+    mAccumulatorNs = 0;
+    mTotalSteps    = 0;
+    mDroppedSteps  = 0;
+}
+
+}  // namespace physika::core
@@ -0,0 +1,174 @@
+#include "core/frame-arena.h"
+
+#include <assert.h>
+
+#include <algorithm>  // max
+
+#include "core/memory-tracker.h"
+
+namespace physika::core {
+
+namespace {
+
+//! Tells arenas apart even when one is created at the address of a destroyed one.
+std::atomic<uint64_t> sNextSerial{ 1 };
+
+//! Arenas a thread looks up without the lock; misses fall back to searching the arena.
+constexpr size_t kLocalCacheSize = 8;
+
+struct LocalCache
+{
+    struct Entry
+    {
+        uint64_t serial = 0;
+        void*    pages  = nullptr;
+    };
+
+    Entry  entries[kLocalCacheSize];
+    size_t next = 0;
+};
+
+thread_local LocalCache tCache;
+
+uintptr_t AlignUp(uintptr_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+}  // namespace
+
+FrameArena::FrameArena(uint32_t framesInFlight, size_t pageSize)
+    : mFramesInFlight{ std::max(framesInFlight, 1u) },
+      mPageSize{ std::max(pageSize, sizeof(max_align_t)) },
+      mSerial{ sNextSerial.fetch_add(1, std::memory_order_relaxed) },
+      mCurrentFrame{ 0 },
+      mPeakFrameBytes{ 0 },
+      mPageAllocations{ 0 }
+{
+}
+
+FrameArena::~FrameArena()
+{
+    for (auto const& thread : mThreads) {
+        for (FramePages const& frame : thread->frames) {
+            for (Page const& page : frame.pages) {
+                memory::TrackFree(memory::MemoryTag::kFrame, page.size);
+            }
+        }
+    }
+}
+
+FrameArena::ThreadPages& FrameArena::LocalPages()
+{
+    for (LocalCache::Entry const& entry : tCache.entries) {
+        if (entry.serial == mSerial) {
+            return *static_cast<ThreadPages*>(entry.pages);
+        }
+    }
+
+    //! Evicted or first use: the thread may still own pages from before it was evicted.
+    std::thread::id const self  = std::this_thread::get_id();
+    ThreadPages*          local = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mThreadsLock);
+        for (auto const& thread : mThreads) {
+            if (thread->owner == self) {
+                local = thread.get();
+                break;
+            }
+        }
+        if (!local) {
+            auto pages   = std::make_unique<ThreadPages>();
+            pages->owner = self;
+            pages->frames.resize(mFramesInFlight);
+            local = pages.get();
+            mThreads.push_back(std::move(pages));
+        }
+    }
+    tCache.entries[tCache.next] = LocalCache::Entry{ mSerial, local };
+    tCache.next                 = (tCache.next + 1) % kLocalCacheSize;
+    return *local;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of two");
+    FramePages& frame = LocalPages().frames[mCurrentFrame.load(std::memory_order_relaxed)];
+    if (frame.page < frame.pages.size()) {
+        Page const&     page    = frame.pages[frame.page];
+        uintptr_t const base    = reinterpret_cast<uintptr_t>(page.memory.get());
+        uintptr_t const address = AlignUp(base + frame.offset, alignment);
+        if (address + size <= base + page.size) {
+            frame.offset = address + size - base;
+            frame.used += size;
+            return reinterpret_cast<void*>(address);
+        }
+    }
+    return AllocateSlow(frame, size, alignment);
+}
+
+void* FrameArena::AllocateSlow(FramePages& frame, size_t size, size_t alignment)
+{
+    //! Pages after the current one are left over from earlier frames; reuse one if it fits.
+    size_t const needed = size + (alignment > alignof(max_align_t) ? alignment : 0);
+    size_t       next   = frame.pages.empty() ? 0 : frame.page + 1;
+    if (next >= frame.pages.size() || frame.pages[next].size < needed) {
+        Page page;
+        page.size   = std::max(mPageSize, needed);
+        page.memory = std::make_unique<max_align_t[]>((page.size + sizeof(max_align_t) - 1) / sizeof(max_align_t));
+        memory::TrackAllocation(memory::MemoryTag::kFrame, page.size);
+        frame.pages.insert(frame.pages.begin() + static_cast<ptrdiff_t>(next), std::move(page));
+        mPageAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    frame.page   = next;
+    frame.offset = 0;
+
+    uintptr_t const base    = reinterpret_cast<uintptr_t>(frame.pages[next].memory.get());
+    uintptr_t const address = AlignUp(base, alignment);
+    frame.offset            = address + size - base;
+    frame.used += size;
+    return reinterpret_cast<void*>(address);
+}
+
+void FrameArena::BeginFrame(uint64_t frame)
+{
+    uint32_t const index = static_cast<uint32_t>(frame % mFramesInFlight);
+
+    std::lock_guard<std::mutex> lock(mThreadsLock);
+    uint64_t                    finished = 0;
+    for (auto const& thread : mThreads) {
+        FramePages& pages = thread->frames[index];
+        finished += pages.used;
+        pages.page   = 0;
+        pages.offset = 0;
+        pages.used   = 0;
+    }
+    mPeakFrameBytes = std::max(mPeakFrameBytes, finished);
+    mCurrentFrame.store(index, std::memory_order_relaxed);
+}
+
+uint32_t FrameArena::FramesInFlight() const
+{
+    return mFramesInFlight;
+}
+
+FrameArenaStats FrameArena::Stats() const
+{
+    FrameArenaStats stats;
+    uint32_t const  current = mCurrentFrame.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mThreadsLock);
+    for (auto const& thread : mThreads) {
+        for (FramePages const& frame : thread->frames) {
+            for (Page const& page : frame.pages) {
+                stats.reservedBytes += page.size;
+            }
+        }
+        stats.frameBytes += thread->frames[current].used;
+    }
+    stats.peakFrameBytes  = std::max(mPeakFrameBytes, stats.frameBytes);
+    stats.pageAllocations = mPageAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace physika::core
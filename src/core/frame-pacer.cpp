@@ -0,0 +1,121 @@
+#include "core/frame-pacer.h"
+
+#include <math.h>  // fabs
+
+#include <algorithm>  // max, min
+#include <chrono>
+#include <thread>
+
+namespace {
+
+//! Weight of a new sample in the oversleep estimate.
+double const kOversleepSmoothing = 0.1;
+//! Standard deviations of oversleep kept as spin margin.
+double const kOversleepMargin = 3.0;
+//! Starting guess for the scheduler's oversleep before any sample.
+double const kInitialOversleepSeconds = 0.001;
+
+}  // namespace
+
+namespace physika::core {
+
+FramePacer::FramePacer(double targetPeriodSeconds)
+    : mBackend{ ResolveTimerBackend(TimerBackend::kDefault) },
+      mTicksPerSecond{ static_cast<double>(TicksPerSecond(mBackend)) },
+      mOversleepMean{ kInitialOversleepSeconds * mTicksPerSecond },
+      mOversleepDeviation{ 0.0 }
+{
+    SetTargetPeriod(targetPeriodSeconds);
+}
+
+void FramePacer::SetTargetPeriod(double seconds)
+{
+    mPeriodTicks  = seconds > 0.0 ? static_cast<int64_t>(seconds * mTicksPerSecond) : 0;
+    mNextDeadline = 0;
+    mFrames       = 0;
+    mMissedFrames = 0;
+    mLastError    = 0;
+    mSumAbsError  = 0.0;
+    mMaxError     = 0;
+    mSleptTicks   = 0;
+    mSpunTicks    = 0;
+}
+
+double FramePacer::TargetPeriod() const
+{
+    return static_cast<double>(mPeriodTicks) / mTicksPerSecond;
+}
+
+void FramePacer::SleepUntil(int64_t deadline)
+{
+    double const slack = mOversleepMean + kOversleepMargin * mOversleepDeviation;
+    int64_t      now   = ReadTicks(mBackend);
+
+    //! Coarse sleep while the remaining time exceeds the expected oversleep.
+    int64_t const sleepTicks = deadline - now - static_cast<int64_t>(slack);
+    if (sleepTicks > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(static_cast<int64_t>(sleepTicks * 1e9 / mTicksPerSecond)));
+        int64_t const woke = ReadTicks(mBackend);
+
+        double const oversleep = static_cast<double>(woke - now - sleepTicks);
+        double const deviation = fabs(oversleep - mOversleepMean);
+        mOversleepMean += kOversleepSmoothing * (oversleep - mOversleepMean);
+        mOversleepDeviation += kOversleepSmoothing * (deviation - mOversleepDeviation);
+        mSleptTicks += woke - now;
+        now = woke;
+    }
+
+    //! Spin out the remainder.
+    int64_t const spinStart = now;
+    while (now < deadline) {
+        now = ReadTicks(mBackend);
+    }
+    mSpunTicks += now - spinStart;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if (mPeriodTicks == 0) {
+        return;
+    }
+
+    int64_t const now = ReadTicks(mBackend);
+    if (mNextDeadline == 0) {
+        mNextDeadline = now + mPeriodTicks;
+        return;
+    }
+
+    if (now > mNextDeadline + mPeriodTicks) {
+        //! More than a frame behind; do not try to catch up.
+        mMissedFrames += 1;
+        mNextDeadline = now;
+    } else {
+        SleepUntil(mNextDeadline);
+    }
+
+    int64_t const start = ReadTicks(mBackend);
+    mLastError          = start - mNextDeadline;
+    mSumAbsError += fabs(static_cast<double>(mLastError));
+    mMaxError = std::max(mMaxError, mLastError);
+    mFrames += 1;
+    mNextDeadline += mPeriodTicks;
+}
+
+FramePacerStats FramePacer::Stats() const
+{
+    double const msPerTick = 1000.0 / mTicksPerSecond;
+
+    FramePacerStats stats;
+    stats.frames         = mFrames;
+    stats.missedFrames   = mMissedFrames;
+    stats.lastErrorMs    = static_cast<double>(mLastError) * msPerTick;
+    stats.meanAbsErrorMs = mFrames > 0 ? mSumAbsError / mFrames * msPerTick : 0.0;
+    stats.maxErrorMs     = static_cast<double>(mMaxError) * msPerTick;
+    stats.sleepSlackMs   = (mOversleepMean + kOversleepMargin * mOversleepDeviation) * msPerTick;
+
+    int64_t const waited = mSleptTicks + mSpunTicks;
+    stats.sleepFraction  = waited > 0 ? static_cast<double>(mSleptTicks) / static_cast<double>(waited) : 0.0;
+    return stats;
+}
+
+}  // namespace physika::core
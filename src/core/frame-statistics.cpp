@@ -0,0 +1,179 @@
+#include "core/frame-statistics.h"
+
+#include <math.h>    // llround
+#include <string.h>  // memset
+
+#include <algorithm>  // max, min
+
+#include "core/logger.h"
+
+namespace {
+
+//! Values below kSubBucketCount us get one bucket each. Every power of two
+//! above that is split into kSubBucketHalf linear buckets (< 1% error).
+uint32_t const kSubBucketBits  = 7;
+uint32_t const kSubBucketCount = 1u << kSubBucketBits;
+uint32_t const kSubBucketHalf  = kSubBucketCount / 2;
+uint32_t const kMaxValueBits   = 27;
+uint64_t const kMaxValueUs     = (uint64_t(1) << kMaxValueBits) - 1;
+uint32_t const kBucketCount    = kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalf;
+
+uint32_t BucketIndex(uint64_t valueUs)
+{
+    if (valueUs < kSubBucketCount) {
+        return static_cast<uint32_t>(valueUs);
+    }
+    uint32_t shift = 0;
+    while ((valueUs >> shift) >= kSubBucketCount) {
+        ++shift;
+    }
+    uint32_t const sub = static_cast<uint32_t>(valueUs >> shift);
+    return kSubBucketCount + (shift - 1) * kSubBucketHalf + (sub - kSubBucketHalf);
+}
+
+//! Midpoint of the range of values that map to a bucket.
+double BucketValueUs(uint32_t index)
+{
+    if (index < kSubBucketCount) {
+        return static_cast<double>(index);
+    }
+    uint32_t const shift = (index - kSubBucketCount) / kSubBucketHalf + 1;
+    uint64_t const sub   = (index - kSubBucketCount) % kSubBucketHalf + kSubBucketHalf;
+    uint64_t const low   = sub << shift;
+    return static_cast<double>(low) + static_cast<double>((uint64_t(1) << shift) - 1) * 0.5;
+}
+
+double UsToMs(double us)
+{
+    return us * 0.001;
+}
+
+}  // namespace
+
+namespace physika::core {
+
+struct FrameStatistics::Histogram
+{
+    uint64_t counts[kBucketCount];
+};
+
+FrameStatistics::FrameStatistics(uint32_t windowFrames)
+    : mWindowFrames(std::max(windowFrames, 1u)),
+      mWindow(std::make_unique<Histogram>()),
+      mLifetime(std::make_unique<Histogram>()),
+      mSamples(std::make_unique<uint32_t[]>(mWindowFrames)),
+      mDeltas(std::make_unique<uint32_t[]>(mWindowFrames))
+{
+    Reset();
+}
+
+FrameStatistics::~FrameStatistics() = default;
+
+void FrameStatistics::Reset()
+{
+    memset(mWindow->counts, 0, sizeof(mWindow->counts));
+    memset(mLifetime->counts, 0, sizeof(mLifetime->counts));
+    mFrames           = 0;
+    mNext             = 0;
+    mPreviousUs       = 0;
+    mWindowSumUs      = 0;
+    mWindowJitterUs   = 0;
+    mLifetimeSumUs    = 0;
+    mLifetimeJitterUs = 0;
+    mLifetimeMaxUs    = 0;
+}
+
+uint32_t FrameStatistics::WindowFrames() const
+{
+    return mWindowFrames;
+}
+
+void FrameStatistics::AddFrame(double deltaSeconds)
+{
+    long long const rounded = llround(deltaSeconds * 1e6);
+    uint32_t const  valueUs = static_cast<uint32_t>(std::min<uint64_t>(rounded < 0 ? 0 : rounded, kMaxValueUs));
+    uint32_t const  deltaUs = mFrames > 0 ? (valueUs > mPreviousUs ? valueUs - mPreviousUs : mPreviousUs - valueUs) : 0;
+
+    //! Evict the oldest frame once the window is full.
+    if (mFrames >= mWindowFrames) {
+        mWindow->counts[BucketIndex(mSamples[mNext])] -= 1;
+        mWindowSumUs -= mSamples[mNext];
+        mWindowJitterUs -= mDeltas[mNext];
+    }
+    mSamples[mNext] = valueUs;
+    mDeltas[mNext]  = deltaUs;
+    mNext           = mNext + 1 == mWindowFrames ? 0 : mNext + 1;
+
+    uint32_t const bucket = BucketIndex(valueUs);
+    mWindow->counts[bucket] += 1;
+    mLifetime->counts[bucket] += 1;
+    mWindowSumUs += valueUs;
+    mWindowJitterUs += deltaUs;
+    mLifetimeSumUs += valueUs;
+    mLifetimeJitterUs += deltaUs;
+    mLifetimeMaxUs = std::max<uint64_t>(mLifetimeMaxUs, valueUs);
+    mPreviousUs    = valueUs;
+    mFrames += 1;
+}
+
+FrameTimeSummary FrameStatistics::Window() const
+{
+    uint64_t const frames = std::min<uint64_t>(mFrames, mWindowFrames);
+    uint64_t       maxUs  = 0;
+    for (uint64_t ii = 0; ii < frames; ++ii) {
+        maxUs = std::max<uint64_t>(maxUs, mSamples[ii]);
+    }
+    //! The first frame ever recorded has no predecessor to differ from.
+    uint64_t const   jitterPairs = mFrames > mWindowFrames ? frames : (frames > 0 ? frames - 1 : 0);
+    FrameTimeSummary summary     = Summarize(*mWindow, frames, mWindowSumUs, maxUs);
+    summary.jitterMs = jitterPairs > 0 ? UsToMs(static_cast<double>(mWindowJitterUs) / jitterPairs) : 0.0;
+    return summary;
+}
+
+FrameTimeSummary FrameStatistics::Lifetime() const
+{
+    FrameTimeSummary summary = Summarize(*mLifetime, mFrames, mLifetimeSumUs, mLifetimeMaxUs);
+    summary.jitterMs = mFrames > 1 ? UsToMs(static_cast<double>(mLifetimeJitterUs) / (mFrames - 1)) : 0.0;
+    return summary;
+}
+
+FrameTimeSummary FrameStatistics::Summarize(Histogram const& histogram, uint64_t frames, uint64_t sumUs, uint64_t maxUs)
+{
+    FrameTimeSummary summary;
+    summary.frames = frames;
+    if (frames == 0) {
+        return summary;
+    }
+    summary.meanMs = UsToMs(static_cast<double>(sumUs) / frames);
+    summary.maxMs  = UsToMs(static_cast<double>(maxUs));
+
+    double const quantiles[]  = { 0.5, 0.9, 0.99, 0.999 };
+    double*      results[]    = { &summary.p50Ms, &summary.p90Ms, &summary.p99Ms, &summary.p999Ms };
+    size_t       nextQuantile = 0;
+    uint64_t     seen         = 0;
+    for (uint32_t bucket = 0; bucket < kBucketCount && nextQuantile < 4; ++bucket) {
+        seen += histogram.counts[bucket];
+        while (nextQuantile < 4 && seen >= static_cast<uint64_t>(ceil(quantiles[nextQuantile] * frames))) {
+            //! Never report more than the exact maximum.
+            *results[nextQuantile] = std::min(summary.maxMs, UsToMs(BucketValueUs(bucket)));
+            ++nextQuantile;
+        }
+    }
+    return summary;
+}
+
+void FrameStatistics::LogSummary(char const* label) const
+{
+    FrameTimeSummary const window   = Window();
+    FrameTimeSummary const lifetime = Lifetime();
+    logger::LOG_INFO("%s frame times over the last %llu frames: mean %.3f ms, p50 %.3f, p90 %.3f, p99 %.3f, "
+                     "p99.9 %.3f, max %.3f, jitter %.3f ms",
+                     label, static_cast<unsigned long long>(window.frames), window.meanMs, window.p50Ms, window.p90Ms,
+                     window.p99Ms, window.p999Ms, window.maxMs, window.jitterMs);
+    logger::LOG_INFO("%s frame times over all %llu frames: mean %.3f ms, p50 %.3f, p90 %.3f, p99 %.3f, "
+                     "p99.9 %.3f, max %.3f, jitter %.3f ms",
+                     label, static_cast<unsigned long long>(lifetime.frames), lifetime.meanMs, lifetime.p50Ms,
+                     lifetime.p90Ms, lifetime.p99Ms, lifetime.p999Ms, lifetime.maxMs, lifetime.jitterMs);
+}
+
+}  // namespace physika::core
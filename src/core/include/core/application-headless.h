@@ -0,0 +1,151 @@
+#pragma once
+
+#include <stdint.h>  // uint64_t
+
+#include <atomic>
+
+#include "core/application-loop.h"
+#include "core/frame-pacer.h"
+#include "core/input-queue.h"
+#include "core/input-recorder.h"
+#include "core/input.h"
+#include "core/timer.h"
+
+namespace physika::core {
+
+//! @brief  An application class without a window or OS message loop.
+//!         Runs the same Initialize/Run/OnUpdate/Shutdown lifecycle as
+//!         ApplicationWin32 so per-frame CPU work can be benchmarked and
+//!         profiled on machines without a display. Run returns after a
+//!         frame limit, a duration limit or RequestQuit.
+class ApplicationHeadless
+{
+public:
+    ApplicationHeadless(char const* const title, int width, int height);
+    virtual ~ApplicationHeadless() = default;
+
+    //! @brief Call this to initialize application.
+    //! @return Bool value indicating success or failure
+    bool Initialize();
+
+    //! @brief Call this to shutdown application.
+    //! @return Bool value indicating success or failure
+    bool Shutdown();
+
+    //! @brief Call this to begin event loop.
+    void Run();
+
+    //! @brief Pace the event loop to a frame rate instead of running flat out.
+    //!        Pass 0 to disable pacing, which is the default.
+    void SetTargetFrameRate(double framesPerSecond);
+
+    //! @brief Make Run return after this many frames. 0 means no limit.
+    void SetFrameLimit(uint64_t frames);
+
+    //! @brief Make Run return after this many seconds. 0 means no limit.
+    void SetDurationLimit(double seconds);
+
+    //! @brief Make Run return after the current frame.
+    void RequestQuit();
+
+    //! @brief Returns the number of frames Run has completed.
+    uint64_t FrameCount() const;
+
+    //! @brief Run OnSimulate on its own thread and OnRender on the frame
+    //!        thread instead of OnUpdate. Set before Run. Input is then
+    //!        consumed by the simulation thread, once per tick.
+    void SetSplitUpdate(bool split);
+
+    //! @brief Pace the simulation thread in split mode. 0, the default,
+    //!        uses the target frame rate.
+    void SetSimulationRate(double ticksPerSecond);
+
+    //! @brief Returns the number of simulation ticks Run has completed.
+    //!        Equal to FrameCount unless split mode is on. Read it after Run returns.
+    uint64_t SimulationCount() const;
+
+    //! @brief Deliver an input event to the matching On* callback, the
+    //!        Input snapshot and the attached recorder immediately.
+    void DispatchInputEvent(InputEvent const& event);
+
+    //! @brief Queue an input event for the next frame. May be called from
+    //!        one other thread while Run is active; never blocks.
+    void PostInputEvent(InputEvent const& event);
+
+    //! @brief Returns the input snapshot for the current frame.
+    InputState const& Input() const;
+
+    //! @brief Returns how long input waited in the queue before a frame used it.
+    InputLatencyStats InputLatency() const;
+
+    //! @brief Record every delivered input event. The recorder is finished
+    //!        when Run returns or when it is detached with nullptr.
+    void SetInputRecorder(InputRecorder* recorder);
+
+    //! @brief Feed recorded input back at the start of each frame instead of
+    //!        live input. Run returns when the replay reaches its end.
+    void SetInputReplay(InputReplay* replay);
+
+    //! @brief Returns true while a replay drives the input.
+    bool IsReplayingInput() const;
+
+    //! @brief Override this callback to handle frame updates. The default
+    //!        calls OnSimulate then OnRender.
+    virtual void OnUpdate();
+
+    //! @brief Override this to advance the simulation and publish a snapshot
+    //!        of it, e.g. through a TripleBuffer.
+    virtual void OnSimulate();
+
+    //! @brief Override this to prepare and submit a frame from the newest
+    //!        published snapshot.
+    virtual void OnRender();
+
+    //! @brief Override this to handle window resizing.
+    virtual void OnResize(int width, int height);
+
+    //! @brief Override this to handle key up event.
+    virtual void OnKeyUp(Keycode key);
+
+    //! @brief Override this to handle key down event.
+    virtual void OnKeyDown(Keycode key);
+
+    //! @brief Override this to handle mouse up event.
+    virtual void OnMouseUp(MouseButton button, int x, int y);
+
+    //! @brief Override this to handle mouse down event.
+    virtual void OnMouseDown(MouseButton button, int x, int y);
+
+    //! @brief Override this to handle mouse movement event.
+    virtual void OnMouseMove(int x, int y);
+
+    //! @brief Override this to handle mouse wheel rotation event.
+    virtual void OnMouseWheel(int delta);
+
+    //! @brief Always nullptr; there is no OS application object.
+    void* ApplicationHandle();
+
+    //! @brief Always nullptr; there is no window.
+    void* WindowHandle();
+
+protected:
+    int         mWindowWidth;
+    int         mWindowHeight;
+    char const* mWindowTitle;
+
+private:
+    FramePacer mFramePacer;
+    Timer      mRunTimer;
+    //! Consumed once per frame, or once per tick in split mode.
+    ApplicationInput mInput;
+    uint64_t         mFrameLimit;
+    double           mDurationLimit;
+    uint64_t         mFrameCount;
+    double           mSimulationRate;
+    bool             mSplitUpdate;
+
+    std::atomic<bool> mQuitRequested;
+    std::atomic<bool> mSimulationFinished;
+};
+
+}  // namespace physika::core
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <stdint.h>  // uint64_t
+
+#include <atomic>
+
+#include "core/frame-pacer.h"
+#include "core/input-queue.h"
+#include "core/input-recorder.h"
+#include "core/input.h"
+#include "core/profiler.h"
+
+namespace physika::core {
+
+/**
+ * @brief The input side of the frame loop shared by ApplicationWin32 and
+ *        ApplicationHeadless.
+ *
+ *        Owns the queue live input is posted to, the per-frame snapshot and
+ *        the optional recorder and replay. Post may be called from one other
+ *        thread; everything else belongs to the thread that consumes input,
+ *        which is the simulation thread in split update mode.
+ */
+class ApplicationInput
+{
+public:
+    ApplicationInput();
+
+    /**
+     * @brief Record event, fold it into the snapshot and call the matching
+     *        On* callback of handler.
+     */
+    template <typename Handler>
+    void Dispatch(Handler& handler, InputEvent const& event)
+    {
+        if (mRecorder) {
+            mRecorder->Record(mFrame, event);
+        }
+        mState.Apply(event);
+        DispatchInputEvent(handler, event);
+    }
+
+    /**
+     * @brief Start an input frame: dispatch the queued events, or the
+     *        replayed ones while a replay is attached.
+     * @return false when the replay has ended.
+     */
+    template <typename Handler>
+    bool Consume(Handler& handler)
+    {
+        mState.BeginFrame();
+        if (!mReplay) {
+            mQueue.Drain([this, &handler](InputEvent const& event) { Dispatch(handler, event); });
+            return true;
+        }
+        if (mReplay->Finished(mFrame)) {
+            return false;
+        }
+        //! Drop live input so it cannot pile up while the replay runs.
+        mQueue.Drain([](InputEvent const&) {});
+        RecordedInputEvent recorded;
+        while (mReplay->NextEvent(mFrame, &recorded)) {
+            Dispatch(handler, recorded.event);
+        }
+        return true;
+    }
+
+    //! Finish the input frame Consume started.
+    void EndFrame();
+
+    //! Queue an event for the next Consume; warns, rate limited, when the queue is full.
+    void Post(InputEvent const& event);
+
+    //! Restart the frame count; call when Run starts.
+    void BeginRun();
+
+    //! Finish the attached recorder; call when Run returns.
+    void EndRun();
+
+    void SetRecorder(InputRecorder* recorder);
+    void SetReplay(InputReplay* replay);
+    bool IsReplaying() const;
+
+    InputState const& State() const;
+    InputLatencyStats Latency() const;
+
+    //! Input frames finished since BeginRun; indexes recordings and replays.
+    uint64_t FrameCount() const;
+
+private:
+    InputQueue     mQueue;
+    InputState     mState;
+    InputRecorder* mRecorder;
+    InputReplay*   mReplay;
+    uint64_t       mFrame;
+};
+
+/**
+ * @brief The simulation thread of split update mode: consume input, call
+ *        OnSimulate and pace each tick until quit is set or a replay ends.
+ */
+template <typename App>
+void RunSimulationLoop(App& app, ApplicationInput& input, double tickPeriodSeconds, std::atomic<bool> const& quit)
+{
+    profiler::SetThreadName("Simulation");
+    FramePacer pacer(tickPeriodSeconds);
+    while (!quit.load(std::memory_order_acquire)) {
+        if (!input.Consume(app)) {
+            break;
+        }
+        {
+            PROFILE_SCOPE("Simulate");
+            app.OnSimulate();
+        }
+        input.EndFrame();
+        pacer.WaitForNextFrame();
+    }
+}
+
+/**
+ * @brief Log how well a run held its frame rate and how long input waited.
+ *        Logs nothing for statistics that saw no frames or events.
+ */
+void LogRunStatistics(FramePacerStats const& pacing, InputLatencyStats const& latency);
+
+}  // namespace physika::core
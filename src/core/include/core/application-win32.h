@@ -1,8 +1,15 @@
 #pragma once
 
 #include <Windows.h>
+#include <stdint.h>  // int64_t
 #include <tchar.h>
 
+#include <atomic>
+
+#include "core/application-loop.h"
+#include "core/frame-pacer.h"
+#include "core/input-queue.h"
+#include "core/input-recorder.h"
 #include "core/input.h"
 
 namespace physika::core {
@@ -26,9 +33,74 @@ public:
     //! @brief Call this to begin event loop.
     void Run();
 
-    //! @brief Override this callback to handle frame updates.
+    //! @brief Pace the event loop to a frame rate instead of running flat out.
+    //!        Pass 0 to disable pacing, which is the default.
+    void SetTargetFrameRate(double framesPerSecond);
+
+    //! @brief Deliver an input event to the matching On* callback, the
+    //!        Input snapshot and the attached recorder. Runs on the update
+    //!        thread for every event drained from the input queue.
+    void DispatchInputEvent(InputEvent const& event);
+
+    //! @brief Queue an input event for the next frame. Called by the window
+    //!        procedure on the thread that pumps messages; never blocks.
+    void PostInputEvent(InputEvent const& event);
+
+    //! @brief Report a new client size. Calls OnResize directly unless the
+    //!        update thread is running, in which case it is applied before
+    //!        the next frame.
+    void PostResize(int width, int height);
+
+    //! @brief Run frames on a separate thread while Run pumps messages on the
+    //!        calling thread. Set before Run. OnUpdate, OnResize and the input
+    //!        callbacks then all run on the update thread.
+    void SetThreadedUpdate(bool threaded);
+
+    //! @brief Run OnSimulate on its own thread and OnRender on the frame
+    //!        thread instead of OnUpdate. Set before Run. Input is then
+    //!        consumed by the simulation thread, once per tick.
+    void SetSplitUpdate(bool split);
+
+    //! @brief Pace the simulation thread in split mode. 0, the default,
+    //!        uses the target frame rate.
+    void SetSimulationRate(double ticksPerSecond);
+
+    //! @brief Returns the number of frames Run has completed.
+    uint64_t FrameCount() const;
+
+    //! @brief Returns the number of simulation ticks Run has completed.
+    //!        Equal to FrameCount unless split mode is on. Read it after Run returns.
+    uint64_t SimulationCount() const;
+
+    //! @brief Returns the input snapshot for the current frame.
+    InputState const& Input() const;
+
+    //! @brief Returns how long input waited in the queue before a frame used it.
+    InputLatencyStats InputLatency() const;
+
+    //! @brief Record every delivered input event. The recorder is finished
+    //!        when Run returns or when it is detached with nullptr.
+    void SetInputRecorder(InputRecorder* recorder);
+
+    //! @brief Feed recorded input back at the start of each frame and ignore
+    //!        live input. Run returns when the replay reaches its end.
+    void SetInputReplay(InputReplay* replay);
+
+    //! @brief Returns true while a replay drives the input.
+    bool IsReplayingInput() const;
+
+    //! @brief Override this callback to handle frame updates. The default
+    //!        calls OnSimulate then OnRender.
     virtual void OnUpdate();
 
+    //! @brief Override this to advance the simulation and publish a snapshot
+    //!        of it, e.g. through a TripleBuffer.
+    virtual void OnSimulate();
+
+    //! @brief Override this to prepare and submit a frame from the newest
+    //!        published snapshot.
+    virtual void OnRender();
+
     //! @brief Override this to handle window resizing.
     virtual void OnResize(int width, int height);
 
@@ -63,7 +135,24 @@ protected:
     TCHAR const* mWindowTitle;
 
 private:
-    HINSTANCE mHinstance;
+    static constexpr int64_t kNoPendingResize = -1;
+
+    //! Update and pace one frame. Returns false when a replay has ended.
+    bool RunFrame();
+
+    HINSTANCE  mHinstance;
+    FramePacer mFramePacer;
+    uint64_t   mFrameCount;
+    //! Consumed once per frame, or once per tick in split mode.
+    ApplicationInput mInput;
+    double           mSimulationRate;
+    bool             mThreadedUpdate;
+    bool             mSplitUpdate;
+
+    std::atomic<bool>    mSimulationFinished;
+    std::atomic<bool>    mUpdateThreadRunning;
+    std::atomic<bool>    mQuitUpdate;
+    std::atomic<int64_t> mPendingResize;
 };
 
 }  // namespace physika::core
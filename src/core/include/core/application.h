@@ -8,4 +8,12 @@ namespace physika::core {
 typedef ApplicationWin32 Application;
 }
 
-#endif
\ No newline at end of file
+#else
+
+#include "core/application-headless.h"
+
+namespace physika::core {
+typedef ApplicationHeadless Application;
+}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdint.h>  // int64_t
+
+namespace physika::core {
+
+/**
+ * @brief Runs simulation at a fixed rate independent of the frame rate.
+ *
+ *        Frame time is added to an accumulator kept in integer
+ *        nanoseconds, and whole steps are consumed from it. The leftover
+ *        fraction of a step is exposed as Alpha so rendering can blend the
+ *        previous and current simulation states.
+ *
+ *        Usage:
+ *            uint32_t const steps = clock.Advance(timer.DeltaSeconds());
+ *            for (uint32_t ii = 0; ii < steps; ++ii) {
+ *                Simulate(clock.StepSeconds());
+ *            }
+ *            Render(Lerp(previous, current, clock.Alpha()));
+ */
+class FixedTimestep
+{
+public:
+    /**
+     * @brief Construct a new FixedTimestep object
+     *
+     * @param stepSeconds Simulated time per step
+     * @param maxSubsteps Upper bound on steps per frame. Time beyond
+     *                    it is discarded so a slow frame cannot make
+     *                    the next one slower (spiral of death).
+     */
+    explicit FixedTimestep(double stepSeconds = 1.0 / 60.0, uint32_t maxSubsteps = 8);
+
+    /**
+     * @brief Add a frame's elapsed time.
+     *
+     * @param frameSeconds Time since the previous frame, e.g. Timer::DeltaSeconds
+     * @return Number of steps to simulate this frame
+     */
+    uint32_t Advance(double frameSeconds);
+
+    /**
+     * @brief Returns the fraction of a step left in the accumulator,
+     *        in [0, 1). Blend factor between the last two states.
+     */
+    double Alpha() const;
+
+    /**
+     * @brief Returns the simulated time per step in seconds.
+     */
+    double StepSeconds() const;
+
+    /**
+     * @brief Returns the number of steps run since construction or Reset.
+     */
+    uint64_t TotalSteps() const;
+
+    /**
+     * @brief Returns the number of steps discarded by the substep cap.
+     */
+    uint64_t DroppedSteps() const;
+
+    /**
+     * @brief Empty the accumulator and clear the counters.
+     */
+    void Reset();
+
+private:
+    int64_t  mStepNs;
+    uint32_t mMaxSubsteps;
+    int64_t  mAccumulatorNs;
+    uint64_t mTotalSteps;
+    uint64_t mDroppedSteps;
+};
+
+}  // namespace physika::core
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+#include <functional>  // hash
+#include <iterator>
+#include <type_traits>  // conditional_t
+#include <utility>  // pair, move
+#include <vector>
+
+namespace physika::core {
+
+/**
+ * @brief Hash map with open addressing and linear probing.
+ *
+ *        Entries live in one flat array, so a lookup touches a few
+ *        neighbouring slots instead of chasing a bucket list. The table
+ *        doubles past 3/4 load and Erase shifts the following entries
+ *        back, so there are no tombstones.
+ *
+ * @note  Key and Value must be default constructible. Pointers to values
+ *        are invalidated when the map grows or an entry is erased.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatMap
+{
+public:
+    using value_type = std::pair<Key, Value>;
+
+    template <bool kConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = FlatMap::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = std::conditional_t<kConst, value_type const*, value_type*>;
+        using reference         = std::conditional_t<kConst, value_type const&, value_type&>;
+        using MapPointer        = std::conditional_t<kConst, FlatMap const*, FlatMap*>;
+
+        Iterator(MapPointer map, size_t slot) : mMap(map), mSlot(slot)
+        {
+            SkipEmpty();
+        }
+
+        reference operator*() const
+        {
+            return mMap->mEntries[mSlot];
+        }
+
+        pointer operator->() const
+        {
+            return &mMap->mEntries[mSlot];
+        }
+
+        Iterator& operator++()
+        {
+            ++mSlot;
+            SkipEmpty();
+            return *this;
+        }
+
+        bool operator==(Iterator const& other) const
+        {
+            return mSlot == other.mSlot;
+        }
+
+        bool operator!=(Iterator const& other) const
+        {
+            return mSlot != other.mSlot;
+        }
+
+    private:
+        void SkipEmpty()
+        {
+            while (mSlot < mMap->mUsed.size() && !mMap->mUsed[mSlot]) {
+                ++mSlot;
+            }
+        }
+
+        MapPointer mMap;
+        size_t     mSlot;
+    };
+
+    using iterator       = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(size_t capacity)
+    {
+        Reserve(capacity);
+    }
+
+    /**
+     * @brief Make room for count entries without growing.
+     */
+    void Reserve(size_t count)
+    {
+        size_t capacity = 8;
+        while (capacity * 3 < count * 4) {
+            capacity <<= 1;
+        }
+        if (capacity > mEntries.size()) {
+            Rehash(capacity);
+        }
+    }
+
+    Value* Find(Key const& key)
+    {
+        size_t const slot = FindSlot(key);
+        return slot != kNotFound ? &mEntries[slot].second : nullptr;
+    }
+
+    Value const* Find(Key const& key) const
+    {
+        size_t const slot = FindSlot(key);
+        return slot != kNotFound ? &mEntries[slot].second : nullptr;
+    }
+
+    bool Contains(Key const& key) const
+    {
+        return FindSlot(key) != kNotFound;
+    }
+
+    /**
+     * @brief Insert key with a value built from args unless it is present.
+     *        Returns the value and whether it was inserted.
+     */
+    template <typename... Args>
+    std::pair<Value*, bool> TryEmplace(Key const& key, Args&&... args)
+    {
+        size_t const found = FindSlot(key);
+        if (found != kNotFound) {
+            return { &mEntries[found].second, false };
+        }
+        if ((mSize + 1) * 4 > mEntries.size() * 3) {
+            Rehash(mEntries.empty() ? 8 : mEntries.size() * 2);
+        }
+        size_t slot = Home(key);
+        while (mUsed[slot]) {
+            slot = (slot + 1) & mMask;
+        }
+        mEntries[slot] = value_type(key, Value(std::forward<Args>(args)...));
+        mUsed[slot]    = 1;
+        mSize += 1;
+        return { &mEntries[slot].second, true };
+    }
+
+    Value& operator[](Key const& key)
+    {
+        return *TryEmplace(key).first;
+    }
+
+    bool Erase(Key const& key)
+    {
+        size_t hole = FindSlot(key);
+        if (hole == kNotFound) {
+            return false;
+        }
+        //! Pull later entries of the probe run back so lookups never stop early.
+        size_t next = (hole + 1) & mMask;
+        while (mUsed[next]) {
+            size_t const home = Home(mEntries[next].first);
+            if (((next - home) & mMask) >= ((next - hole) & mMask)) {
+                mEntries[hole] = std::move(mEntries[next]);
+                hole           = next;
+            }
+            next = (next + 1) & mMask;
+        }
+        mEntries[hole] = value_type();
+        mUsed[hole]    = 0;
+        mSize -= 1;
+        return true;
+    }
+
+    void Clear()
+    {
+        for (size_t ii = 0; ii < mEntries.size(); ++ii) {
+            if (mUsed[ii]) {
+                mEntries[ii] = value_type();
+                mUsed[ii]    = 0;
+            }
+        }
+        mSize = 0;
+    }
+
+    size_t Size() const
+    {
+        return mSize;
+    }
+
+    bool Empty() const
+    {
+        return mSize == 0;
+    }
+
+    size_t Capacity() const
+    {
+        return mEntries.size();
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, mEntries.size());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, mEntries.size());
+    }
+
+private:
+    static size_t const kNotFound = ~static_cast<size_t>(0);
+
+    size_t Home(Key const& key) const
+    {
+        return Hash{}(key) & mMask;
+    }
+
+    size_t FindSlot(Key const& key) const
+    {
+        if (mSize == 0) {
+            return kNotFound;
+        }
+        for (size_t slot = Home(key); mUsed[slot]; slot = (slot + 1) & mMask) {
+            if (mEntries[slot].first == key) {
+                return slot;
+            }
+        }
+        return kNotFound;
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<value_type> entries(capacity);
+        std::vector<uint8_t>    used(capacity, 0);
+        mEntries.swap(entries);
+        mUsed.swap(used);
+        mMask = capacity - 1;
+
+        for (size_t ii = 0; ii < entries.size(); ++ii) {
+            if (!used[ii]) {
+                continue;
+            }
+            size_t slot = Home(entries[ii].first);
+            while (mUsed[slot]) {
+                slot = (slot + 1) & mMask;
+            }
+            mEntries[slot] = std::move(entries[ii]);
+            mUsed[slot]    = 1;
+        }
+    }
+
+    std::vector<value_type> mEntries;
+    std::vector<uint8_t>    mUsed;
+    size_t                  mSize = 0;
+    size_t                  mMask = 0;
+};
+
+}  // namespace physika::core
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <stddef.h>  // size_t, max_align_t
+#include <stdint.h>  // uint32_t, uint64_t
+
+#include <atomic>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <new>     // placement new
+#include <thread>  // thread::id
+#include <type_traits>
+#include <utility>  // forward
+#include <vector>
+
+namespace physika::core {
+
+/**
+ * @brief Memory held and handed out by a FrameArena, in bytes.
+ */
+struct FrameArenaStats
+{
+    //! Page memory owned by the arena across all threads and frames.
+    uint64_t reservedBytes = 0;
+    //! Bytes handed out since the current frame began.
+    uint64_t frameBytes = 0;
+    //! Largest frameBytes of any finished frame.
+    uint64_t peakFrameBytes = 0;
+    //! Pages taken from the heap; stays flat once the arena has warmed up.
+    uint64_t pageAllocations = 0;
+};
+
+/**
+ * @brief Bump allocator for data that lives until the end of a frame.
+ *
+ *        Every thread allocates from its own pages, so allocation is a
+ *        pointer bump without locks. Memory is never freed one block at a
+ *        time: each of the frames in flight has its own set of pages, and
+ *        BeginFrame rewinds a frame's pages wholesale once the GPU fence of
+ *        the frame that last used them has completed. Pages are kept, so a
+ *        warmed-up arena does not touch the heap.
+ *
+ * @note  Destructors of arena objects never run. BeginFrame and Stats must
+ *        not overlap allocation on other threads.
+ */
+class FrameArena
+{
+public:
+    static size_t const kDefaultPageSize = 64 * 1024;
+
+    /**
+     * @brief Construct a new FrameArena object
+     *
+     * @param framesInFlight Frames whose allocations are alive at the same time.
+     * @param pageSize Size of each page; larger allocations get a page of their own.
+     */
+    explicit FrameArena(uint32_t framesInFlight = 2, size_t pageSize = kDefaultPageSize);
+    ~FrameArena();
+
+    FrameArena(FrameArena const& other)            = delete;
+    FrameArena& operator=(FrameArena const& other) = delete;
+
+    /**
+     * @brief Make frame the current frame and release everything allocated
+     *        the last time it was current.
+     */
+    void BeginFrame(uint64_t frame);
+
+    /**
+     * @brief Returns size bytes from the current frame, aligned to alignment
+     *        (a power of two).
+     */
+    void* Allocate(size_t size, size_t alignment = alignof(max_align_t));
+
+    /**
+     * @brief Construct a T in the current frame.
+     */
+    template <typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame arena objects are never destroyed");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns uninitialized storage for count Ts in the current frame.
+     */
+    template <typename T>
+    T* NewArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Frame arena objects are never destroyed");
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    uint32_t        FramesInFlight() const;
+    FrameArenaStats Stats() const;
+
+private:
+    struct Page
+    {
+        std::unique_ptr<max_align_t[]> memory;
+        size_t                         size = 0;
+    };
+
+    struct FramePages
+    {
+        std::vector<Page> pages;
+        size_t            page   = 0;
+        size_t            offset = 0;
+        uint64_t          used   = 0;
+    };
+
+    //! One per thread that allocated from the arena.
+    struct ThreadPages
+    {
+        std::thread::id         owner;
+        std::vector<FramePages> frames;
+    };
+
+    ThreadPages& LocalPages();
+    void*        AllocateSlow(FramePages& frame, size_t size, size_t alignment);
+
+    uint32_t const        mFramesInFlight;
+    size_t const          mPageSize;
+    uint64_t const        mSerial;
+    std::atomic<uint32_t> mCurrentFrame;
+
+    mutable std::mutex                        mThreadsLock;
+    std::vector<std::unique_ptr<ThreadPages>> mThreads;
+    uint64_t                                  mPeakFrameBytes;
+    std::atomic<uint64_t>                     mPageAllocations;
+};
+
+/**
+ * @brief STL allocator that takes memory from a FrameArena. Deallocation is
+ *        a no-op; the memory comes back when the frame is recycled.
+ */
+template <typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    explicit FrameAllocator(FrameArena& arena) noexcept : mArena(&arena)
+    {
+    }
+
+    template <typename U>
+    FrameAllocator(FrameAllocator<U> const& other) noexcept : mArena(other.Arena())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(mArena->Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void deallocate(T* /*pointer*/, size_t /*count*/) noexcept
+    {
+    }
+
+    FrameArena* Arena() const noexcept
+    {
+        return mArena;
+    }
+
+    template <typename U>
+    bool operator==(FrameAllocator<U> const& other) const noexcept
+    {
+        return mArena == other.Arena();
+    }
+
+    template <typename U>
+    bool operator!=(FrameAllocator<U> const& other) const noexcept
+    {
+        return mArena != other.Arena();
+    }
+
+private:
+    FrameArena* mArena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+}  // namespace physika::core
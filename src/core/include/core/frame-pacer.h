@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>  // int64_t
+
+#include "core/timer.h"
+
+namespace physika::core {
+
+/**
+ * @brief How closely frames followed the target period, in milliseconds.
+ *        Error is the time a frame started after its deadline.
+ */
+struct FramePacerStats
+{
+    uint64_t frames         = 0;
+    //! Frames that started more than one period late; the schedule restarts after them.
+    uint64_t missedFrames   = 0;
+    double   lastErrorMs    = 0.0;
+    double   meanAbsErrorMs = 0.0;
+    double   maxErrorMs     = 0.0;
+    //! Time before a deadline at which sleeping stops and spinning starts.
+    double sleepSlackMs = 0.0;
+    //! Share of the waiting time spent sleeping rather than spinning.
+    double sleepFraction = 0.0;
+};
+
+/**
+ * @brief Holds each frame to a target period without burning a core.
+ *
+ *        WaitForNextFrame sleeps until shortly before the next deadline
+ *        and spins for the rest. The margin left for spinning follows
+ *        the measured oversleep of the OS scheduler, so spinning stays
+ *        short on systems with precise sleeps and grows where sleeps
+ *        are coarse.
+ */
+class FramePacer
+{
+public:
+    /**
+     * @brief Construct a new FramePacer object
+     *
+     * @param targetPeriodSeconds Frame period. Zero disables pacing.
+     */
+    explicit FramePacer(double targetPeriodSeconds = 0.0);
+
+    /**
+     * @brief Change the frame period. Zero disables pacing.
+     *        Restarts the schedule.
+     */
+    void SetTargetPeriod(double seconds);
+
+    /**
+     * @brief Returns the frame period in seconds.
+     */
+    double TargetPeriod() const;
+
+    /**
+     * @brief Block until the next frame should start. Call once per frame,
+     *        after the frame's work. Returns at once when pacing is off.
+     */
+    void WaitForNextFrame();
+
+    /**
+     * @brief Returns the pacing statistics since the period was set.
+     */
+    FramePacerStats Stats() const;
+
+private:
+    void SleepUntil(int64_t deadline);
+
+    TimerBackend mBackend;
+    double       mTicksPerSecond;
+    int64_t      mPeriodTicks;
+    int64_t      mNextDeadline;
+
+    //! Running estimate of how far sleeps overshoot, in ticks.
+    double mOversleepMean;
+    double mOversleepDeviation;
+
+    uint64_t mFrames;
+    uint64_t mMissedFrames;
+    int64_t  mLastError;
+    double   mSumAbsError;
+    int64_t  mMaxError;
+    int64_t  mSleptTicks;
+    int64_t  mSpunTicks;
+};
+
+}  // namespace physika::core
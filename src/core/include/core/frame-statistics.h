@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>  // uint32_t
+
+#include <memory>  // unique_ptr
+
+namespace physika::core {
+
+/**
+ * @brief Frame time percentiles in milliseconds.
+ */
+struct FrameTimeSummary
+{
+    uint64_t frames = 0;
+    double   meanMs = 0.0;
+    double   p50Ms  = 0.0;
+    double   p90Ms  = 0.0;
+    double   p99Ms  = 0.0;
+    double   p999Ms = 0.0;
+    double   maxMs  = 0.0;
+    //! Mean absolute change between consecutive frame times.
+    double jitterMs = 0.0;
+};
+
+/**
+ * @brief Collects frame times into log-linear (HDR style) histograms with
+ *        roughly 1% relative precision from 1 us up to two minutes.
+ *
+ *        Keeps one histogram over the last windowFrames frames and one
+ *        over the whole run. Everything is allocated in the constructor;
+ *        AddFrame only updates counters.
+ */
+class FrameStatistics
+{
+public:
+    /**
+     * @brief Construct a new FrameStatistics object
+     *
+     * @param windowFrames Number of recent frames the rolling statistics cover
+     */
+    explicit FrameStatistics(uint32_t windowFrames = 1024);
+    ~FrameStatistics();
+
+    /**
+     * @brief Record one frame. Feed it Timer::DeltaSeconds after Tick.
+     */
+    void AddFrame(double deltaSeconds);
+
+    /**
+     * @brief Returns statistics over the last windowFrames frames.
+     */
+    FrameTimeSummary Window() const;
+
+    /**
+     * @brief Returns statistics over every frame since construction or Reset.
+     */
+    FrameTimeSummary Lifetime() const;
+
+    /**
+     * @brief Returns the rolling window size in frames.
+     */
+    uint32_t WindowFrames() const;
+
+    /**
+     * @brief Drop every recorded frame.
+     */
+    void Reset();
+
+    /**
+     * @brief Write the window and lifetime statistics to the log.
+     *
+     * @param label Prefix for the log lines, e.g. the application name
+     */
+    void LogSummary(char const* label) const;
+
+private:
+    struct Histogram;
+
+    static FrameTimeSummary Summarize(Histogram const& histogram, uint64_t frames, uint64_t sumUs, uint64_t maxUs);
+
+    uint32_t mWindowFrames;
+
+    std::unique_ptr<Histogram> mWindow;
+    std::unique_ptr<Histogram> mLifetime;
+    //! Ring of the last windowFrames frame times in microseconds.
+    std::unique_ptr<uint32_t[]> mSamples;
+    //! Ring of |frame - previous frame| in microseconds, parallel to mSamples.
+    std::unique_ptr<uint32_t[]> mDeltas;
+
+    uint64_t mFrames;
+    uint32_t mNext;
+    uint32_t mPreviousUs;
+    uint64_t mWindowSumUs;
+    uint64_t mWindowJitterUs;
+    uint64_t mLifetimeSumUs;
+    uint64_t mLifetimeJitterUs;
+    uint64_t mLifetimeMaxUs;
+};
+
+}  // namespace physika::core
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // int64_t, uint64_t
+
+#include <atomic>
+
+#include "core/input.h"
+#include "core/spsc-queue.h"
+#include "core/timer.h"
+
+namespace physika::core {
+
+/**
+ * @brief Input as seen by one frame.
+ *
+ *        Held state (keys, buttons, cursor) carries over between frames;
+ *        edges and deltas only cover the events applied since BeginFrame.
+ */
+struct InputState
+{
+    bool        keyDown[kKeyCodeCount]     = {};
+    bool        keyPressed[kKeyCodeCount]  = {};
+    bool        keyReleased[kKeyCodeCount] = {};
+    MouseButton mouseButtons               = kMouseNone;
+    int         mouseX                     = 0;
+    int         mouseY                     = 0;
+    int         mouseDeltaX                = 0;
+    int         mouseDeltaY                = 0;
+    int         wheelDelta                 = 0;
+    //! Events applied this frame.
+    uint32_t events = 0;
+
+    /**
+     * @brief Clear the per-frame edges and deltas.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Fold one event into the state.
+     */
+    void Apply(InputEvent const& event);
+};
+
+/**
+ * @brief Time from an event being posted to being consumed, in milliseconds.
+ */
+struct InputLatencyStats
+{
+    uint64_t events = 0;
+    //! Events lost because the queue was full.
+    uint64_t dropped = 0;
+    double   meanMs  = 0.0;
+    double   maxMs   = 0.0;
+    //! Worst latency among the events of the last Drain.
+    double lastDrainMaxMs = 0.0;
+};
+
+/**
+ * @brief Hands input events from the thread that pumps OS messages to the
+ *        update thread without locks.
+ *
+ *        The producer Posts events as they arrive, the consumer Drains
+ *        them once per frame. Each event carries the time it was posted
+ *        so Drain can measure how long input waited for a frame. Post
+ *        never blocks: when the queue is full the event is dropped and
+ *        counted.
+ */
+class InputQueue
+{
+public:
+    struct Entry
+    {
+        InputEvent event;
+        int64_t    postedTicks = 0;
+    };
+
+    explicit InputQueue(size_t capacity = 1024);
+
+    /**
+     * @brief Producer: stamp and enqueue an event.
+     * @return false if the queue was full and the event was dropped.
+     */
+    bool Post(InputEvent const& event);
+
+    /**
+     * @brief Consumer: call onEvent for every queued event in order and
+     *        update the latency statistics.
+     * @return Number of events drained.
+     */
+    template <typename Callback>
+    size_t Drain(Callback&& onEvent)
+    {
+        size_t        count   = 0;
+        int64_t const now     = ReadTicks(mBackend);
+        int64_t       longest = 0;
+        while (Entry* entry = mQueue.Front()) {
+            int64_t const waited = now > entry->postedTicks ? now - entry->postedTicks : 0;
+            longest              = waited > longest ? waited : longest;
+            mLatencySum += waited;
+            onEvent(entry->event);
+            mQueue.Pop();
+            ++count;
+        }
+        mLatencyMax   = longest > mLatencyMax ? longest : mLatencyMax;
+        mLastDrainMax = longest;
+        mDrainedEvents += count;
+        return count;
+    }
+
+    /**
+     * @brief Consumer: returns latency statistics over everything drained.
+     */
+    InputLatencyStats Latency() const;
+
+private:
+    SpscQueue<Entry>      mQueue;
+    TimerBackend          mBackend;
+    double                mMsPerTick;
+    std::atomic<uint64_t> mDropped;
+    uint64_t              mDrainedEvents;
+    int64_t               mLatencySum;
+    int64_t               mLatencyMax;
+    int64_t               mLastDrainMax;
+};
+
+}  // namespace physika::core
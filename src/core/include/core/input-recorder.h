@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint64_t, uint8_t
+
+#include <vector>
+
+#include "core/input.h"
+#include "core/timer.h"
+
+namespace physika::core {
+
+/**
+ * @brief An input event together with when it was delivered.
+ */
+struct RecordedInputEvent
+{
+    //! Index of the frame whose update saw the event.
+    uint64_t frame = 0;
+    //! Microseconds since the recording started.
+    uint64_t   timeUs = 0;
+    InputEvent event;
+};
+
+/**
+ * @brief Records input events into a compact binary stream.
+ *
+ *        Each record is a type byte followed by varint deltas of the
+ *        frame index, the timestamp and the payload, so a typical
+ *        mouse move takes four to six bytes. The application calls
+ *        Record for every event it delivers and Finish with the frame
+ *        count when recording stops.
+ */
+class InputRecorder
+{
+public:
+    InputRecorder();
+
+    /**
+     * @brief Drop anything recorded and restart the clock.
+     */
+    void Reset();
+
+    /**
+     * @brief Append one event delivered during the given frame.
+     */
+    void Record(uint64_t frame, InputEvent const& event);
+
+    /**
+     * @brief Mark the end of the recording. Replays finish at this frame.
+     */
+    void Finish(uint64_t frame);
+
+    /**
+     * @brief Returns the number of events recorded.
+     */
+    size_t EventCount() const;
+
+    /**
+     * @brief Returns the encoded stream.
+     */
+    std::vector<uint8_t> const& Data() const;
+
+    /**
+     * @brief Write the encoded stream to a file.
+     * @return false when the file could not be written
+     */
+    bool Save(char const* path) const;
+
+private:
+    void Append(uint8_t type, uint64_t frame, uint64_t timeUs);
+
+    std::vector<uint8_t> mData;
+    TimerBackend         mBackend;
+    double               mTicksPerUs;
+    int64_t              mStartTicks;
+    uint64_t             mLastFrame;
+    uint64_t             mLastTimeUs;
+    int32_t              mLastX;
+    int32_t              mLastY;
+    size_t               mEventCount;
+    bool                 mFinished;
+};
+
+/**
+ * @brief Plays a recorded stream back frame by frame.
+ *
+ *        Call NextEvent in a loop at the start of every frame with the
+ *        application's frame index; it yields the events recorded for
+ *        that frame in their original order.
+ */
+class InputReplay
+{
+public:
+    /**
+     * @brief Decode a stream produced by InputRecorder.
+     * @return false when the data is not a valid recording
+     */
+    bool Load(std::vector<uint8_t> const& data);
+
+    /**
+     * @brief Read and decode a recording file.
+     * @return false when the file is missing or not a valid recording
+     */
+    bool Load(char const* path);
+
+    /**
+     * @brief Returns the next event recorded for frame, or false once
+     *        the events for that frame are used up.
+     */
+    bool NextEvent(uint64_t frame, RecordedInputEvent* event);
+
+    /**
+     * @brief Returns true when frame is at or past the recorded end.
+     */
+    bool Finished(uint64_t frame) const;
+
+    /**
+     * @brief Rewind to the first event.
+     */
+    void Restart();
+
+    /**
+     * @brief Returns all decoded events.
+     */
+    std::vector<RecordedInputEvent> const& Events() const;
+
+    /**
+     * @brief Returns the frame count stored by InputRecorder::Finish.
+     */
+    uint64_t EndFrame() const;
+
+private:
+    std::vector<RecordedInputEvent> mEvents;
+    size_t                          mNext     = 0;
+    uint64_t                        mEndFrame = 0;
+};
+
+}  // namespace physika::core
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>  // uint8_t, int32_t
+
 namespace physika::core {
 
 enum MouseButton : int {
@@ -121,4 +123,57 @@ inline MouseButton& operator|=(MouseButton& leftSide, MouseButton const& rightSi
     return leftSide;
 }
 
-}  // namespace physika::core
\ No newline at end of file
+enum class InputEventType : uint8_t {
+    kKeyDown,
+    kKeyUp,
+    kMouseDown,
+    kMouseUp,
+    kMouseMove,
+    kMouseWheel,
+};
+
+/**
+ * @brief One input event as delivered to the application callbacks.
+ *
+ *        code is the Keycode for key events, the MouseButton mask for
+ *        button events and the wheel delta for kMouseWheel. x and y are
+ *        only meaningful for button and move events.
+ */
+struct InputEvent
+{
+    InputEventType type = InputEventType::kKeyDown;
+    int32_t        code = 0;
+    int32_t        x    = 0;
+    int32_t        y    = 0;
+};
+
+/**
+ * @brief Call the On* callback of handler that matches event.
+ *        Works with any class that has the application callbacks.
+ */
+template <typename Handler>
+void DispatchInputEvent(Handler& handler, InputEvent const& event)
+{
+    switch (event.type) {
+    case InputEventType::kKeyDown:
+        handler.OnKeyDown(static_cast<Keycode>(event.code));
+        break;
+    case InputEventType::kKeyUp:
+        handler.OnKeyUp(static_cast<Keycode>(event.code));
+        break;
+    case InputEventType::kMouseDown:
+        handler.OnMouseDown(static_cast<MouseButton>(event.code), event.x, event.y);
+        break;
+    case InputEventType::kMouseUp:
+        handler.OnMouseUp(static_cast<MouseButton>(event.code), event.x, event.y);
+        break;
+    case InputEventType::kMouseMove:
+        handler.OnMouseMove(event.x, event.y);
+        break;
+    case InputEventType::kMouseWheel:
+        handler.OnMouseWheel(event.code);
+        break;
+    }
+}
+
+}  // namespace physika::core
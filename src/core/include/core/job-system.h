@@ -0,0 +1,219 @@
+#pragma once
+
+#include <stddef.h>  // max_align_t, size_t
+#include <stdint.h>  // uint32_t, uint64_t
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <new>  // placement new
+#include <thread>
+#include <type_traits>
+#include <utility>  // forward
+#include <vector>
+
+#include "core/work-stealing-queue.h"
+
+namespace physika::core {
+
+/**
+ * @brief Counts unfinished jobs.
+ *
+ *        Every job started with a counter increments it and decrements it
+ *        when the job returns. Express dependencies by waiting on the
+ *        counter of the jobs you depend on with JobSystem::Wait, which
+ *        runs other jobs in the meantime instead of blocking.
+ */
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    JobCounter(JobCounter const& other)            = delete;
+    JobCounter& operator=(JobCounter const& other) = delete;
+
+    /**
+     * @brief Returns true when every job attached to the counter has finished.
+     */
+    bool Done() const
+    {
+        return mPending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> mPending{ 0 };
+};
+
+/**
+ * @brief Totals over all threads since the job system was created.
+ */
+struct JobSystemStats
+{
+    uint64_t executed = 0;
+    //! Jobs taken from another thread's deque.
+    uint64_t stolen = 0;
+    //! Jobs run inline because the submitting thread's deque was full.
+    uint64_t inlined = 0;
+};
+
+/**
+ * @brief A work-stealing job system.
+ *
+ *        Every worker thread, and the thread that created the system, owns
+ *        a Chase-Lev deque. New jobs go to the bottom of the submitting
+ *        thread's deque; idle threads steal from the top of random others
+ *        and sleep when there is nothing to steal. Jobs submitted from
+ *        unrelated threads go through a shared locked queue.
+ *
+ *        Job closures are stored inline, so they must fit in
+ *        kJobStorageSize bytes; capture large state by pointer.
+ */
+class JobSystem
+{
+public:
+    static constexpr size_t kJobStorageSize = 64;
+
+    /**
+     * @brief Construct a new JobSystem object
+     *
+     * @param workerThreads Threads to start in addition to the calling
+     *                      thread, which takes part whenever it waits.
+     */
+    explicit JobSystem(uint32_t workerThreads = DefaultWorkerThreads());
+    ~JobSystem();
+
+    JobSystem(JobSystem const& other)            = delete;
+    JobSystem& operator=(JobSystem const& other) = delete;
+
+    /**
+     * @brief Returns one worker per hardware thread besides the caller.
+     */
+    static uint32_t DefaultWorkerThreads();
+
+    /**
+     * @brief Returns the number of threads that run jobs, including the creator.
+     */
+    uint32_t ThreadCount() const;
+
+    /**
+     * @brief Queue function to run on some thread.
+     *
+     * @param counter Optional; incremented now and decremented when function returns.
+     */
+    template <typename Function>
+    void Run(Function&& function, JobCounter* counter = nullptr)
+    {
+        using Closure = std::decay_t<Function>;
+        static_assert(sizeof(Closure) <= kJobStorageSize, "Job closure too large; capture by pointer");
+        static_assert(alignof(Closure) <= alignof(max_align_t), "Job closure over-aligned");
+
+        Job* job = AllocateJob();
+        new (job->storage) Closure(std::forward<Function>(function));
+        job->invoke = [](Job& self) {
+            Closure* closure = reinterpret_cast<Closure*>(self.storage);
+            (*closure)();
+            closure->~Closure();
+        };
+        job->counter = counter;
+        Submit(job);
+    }
+
+    /**
+     * @brief Run jobs until every job attached to counter has finished.
+     *        Safe to call from inside a job.
+     */
+    void Wait(JobCounter const& counter);
+
+    /**
+     * @brief Call function(begin, end) over disjoint ranges covering
+     *        [0, count) in parallel and return when all are done.
+     *
+     *        Ranges are split in halves on demand, so idle threads steal
+     *        big pieces first.
+     *
+     * @param grain Largest range handed to function. 0 picks one that gives
+     *              every thread several ranges to balance with.
+     */
+    template <typename Function>
+    void ParallelFor(uint32_t count, Function&& function, uint32_t grain = 0)
+    {
+        if (count == 0) {
+            return;
+        }
+        grain = grain > 0 ? grain : AutoGrain(count);
+
+        JobCounter                                          counter;
+        ParallelForRange<std::remove_reference_t<Function>> range{ this, &function, &counter, grain };
+        range.Execute(0, count);
+        Wait(counter);
+    }
+
+    /**
+     * @brief Returns job counts summed over all threads.
+     */
+    JobSystemStats Stats() const;
+
+private:
+    struct Job
+    {
+        void (*invoke)(Job& self) = nullptr;
+        JobCounter* counter       = nullptr;
+        //! Set while the job sits in a thread's ring; a busy slot is not reused.
+        std::atomic<bool> busy{ false };
+        bool              heap = false;
+        alignas(max_align_t) unsigned char storage[kJobStorageSize];
+    };
+
+    struct Worker;
+
+    template <typename Function>
+    struct ParallelForRange
+    {
+        JobSystem*  system;
+        Function*   function;
+        JobCounter* counter;
+        uint32_t    grain;
+
+        void Execute(uint32_t begin, uint32_t end) const
+        {
+            //! Hand the upper half to whoever steals it and keep splitting the lower one.
+            while (end - begin > grain) {
+                uint32_t const          middle = begin + (end - begin) / 2;
+                ParallelForRange const* self   = this;
+                system->Run([self, middle, end]() { self->Execute(middle, end); }, counter);
+                end = middle;
+            }
+            (*function)(begin, end);
+        }
+    };
+
+    uint32_t AutoGrain(uint32_t count) const;
+    Job*     AllocateJob();
+    void     Submit(Job* job);
+    void     Execute(Job* job);
+    Job*     FindJob(Worker* self);
+    void     WorkerMain(uint32_t index);
+    void     Wake();
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::thread>             mThreads;
+
+    //! Jobs from threads that own no deque.
+    std::mutex        mInjectionMutex;
+    std::deque<Job*>  mInjected;
+    std::atomic<bool> mHasInjected;
+
+    //! Idle workers sleep until the epoch moves.
+    std::mutex              mSleepMutex;
+    std::condition_variable mSleepCondition;
+    std::atomic<uint64_t>   mEpoch;
+    std::atomic<uint32_t>   mSleepers;
+    std::atomic<bool>       mStop;
+    std::atomic<uint64_t>   mInlined;
+};
+
+}  // namespace physika::core
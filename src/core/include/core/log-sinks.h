@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+#include <stdio.h>   // FILE
+
+#include <memory>  // shared_ptr
+#include <string>
+
+#include "core/logger.h"
+#include "core/mapped-file.h"
+
+namespace physika::core::logger {
+
+/**
+ * @brief Destination for formatted log lines.
+ *
+ * @note  The logger serialises calls into sinks, so implementations
+ *        do not need to be thread safe.
+ */
+class LogSink
+{
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Write one formatted line.
+     *
+     * @param level Level of the message
+     * @param line Formatted line including the trailing newline.
+     *             Not null terminated.
+     * @param length Number of bytes in line
+     */
+    virtual void Write(LogLevel level, char const* line, size_t length) = 0;
+
+    /**
+     * @brief Called after the async backend drains a batch and
+     *        on shutdown.
+     */
+    virtual void Flush();
+};
+
+using LogSinkPtr = std::shared_ptr<LogSink>;
+
+/**
+ * @brief Add a sink. A ConsoleSink is registered by default.
+ */
+void AddSink(LogSinkPtr sink);
+
+/**
+ * @brief Remove a previously added sink.
+ */
+void RemoveSink(LogSinkPtr const& sink);
+
+/**
+ * @brief Remove every sink, including the default console sink.
+ */
+void ClearSinks();
+
+/**
+ * @brief Flush every registered sink.
+ */
+void FlushSinks();
+
+/**
+ * @brief Writes lines to the standard output.
+ */
+class ConsoleSink : public LogSink
+{
+public:
+    void Write(LogLevel level, char const* line, size_t length) override;
+    void Flush() override;
+};
+
+/**
+ * @brief Writes lines to a file through stdio.
+ */
+class FileSink : public LogSink
+{
+public:
+    explicit FileSink(char const* path);
+    ~FileSink();
+
+    bool IsOpen() const;
+
+    void Write(LogLevel level, char const* line, size_t length) override;
+    void Flush() override;
+
+private:
+    FILE* mFile;
+};
+
+/**
+ * @brief Settings for MappedFileSink.
+ */
+struct MappedFileSinkOptions
+{
+    //! Segments are named <basePath>.<index>.log
+    std::string basePath = "log";
+    //! Size each segment is mapped at. Lines longer than this are truncated.
+    size_t segmentSize = size_t(16) << 20;
+    //! Number of segments kept on disk. Older ones are deleted. Zero keeps all.
+    uint32_t maxSegments = 8;
+};
+
+/**
+ * @brief Appends lines into pre-sized memory-mapped segments and rotates
+ *        to a new segment when the current one is full. Writing a line is
+ *        a memcpy; the file system is only involved on rotation. Segments
+ *        are trimmed to the bytes written when rotated or closed.
+ */
+class MappedFileSink : public LogSink
+{
+public:
+    explicit MappedFileSink(MappedFileSinkOptions const& options);
+    ~MappedFileSink();
+
+    /**
+     * @brief Returns false if the first segment could not be created.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Returns the path of a segment.
+     */
+    std::string SegmentPath(uint32_t index) const;
+
+    /**
+     * @brief Returns the index of the segment currently written to.
+     */
+    uint32_t CurrentSegment() const;
+
+    void Write(LogLevel level, char const* line, size_t length) override;
+
+private:
+    bool OpenSegment(uint32_t index);
+
+    MappedFileSinkOptions mOptions;
+    MappedFile            mSegment;
+    uint32_t              mSegmentIndex;
+    size_t                mOffset;
+};
+
+}  // namespace physika::core::logger
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+#include <stdio.h>   // FILE
+#include <string.h>  // strnlen
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
 #include <utility>
 
 namespace physika::core::logger {
 
-enum class LogLevel {
+enum class LogLevel : uint32_t {
     kTrace = 1 << 0,
     kDebug = 1 << 1,
     kInfo  = 1 << 2,
@@ -13,6 +21,67 @@ enum class LogLevel {
     kFatal = 1 << 5,
 };
 
+/**
+ * @brief Per module categories for the PHI_LOG_* macros. Categories share
+ *        the runtime mask with the levels so a call site is filtered with
+ *        a single load and test.
+ */
+enum class LogCategory : uint32_t {
+    kCore        = 1 << 8,
+    kGraphics    = 1 << 9,
+    kRenderer    = 1 << 10,
+    kApplication = 1 << 11,
+};
+
+//! Lowest level compiled into the binary. Calls below it are removed.
+//! Override with e.g. -DPHYSIKA_LOG_MIN_LEVEL=kInfo
+#ifndef PHYSIKA_LOG_MIN_LEVEL
+#define PHYSIKA_LOG_MIN_LEVEL kTrace
+#endif
+
+constexpr LogLevel kMinCompiledLevel = LogLevel::PHYSIKA_LOG_MIN_LEVEL;
+
+/**
+ * @brief Returns true if calls at this level survive compilation.
+ */
+constexpr bool IsCompiledIn(LogLevel level)
+{
+    return level >= kMinCompiledLevel;
+}
+
+namespace detail {
+
+constexpr uint32_t kLevelMask    = 0x000000FF;
+constexpr uint32_t kCategoryMask = 0xFFFFFF00;
+
+//! Enabled levels in the low byte, enabled categories above it.
+inline std::atomic<uint32_t> sEnabledMask{ kLevelMask | kCategoryMask };
+
+}  // namespace detail
+
+/**
+ * @brief Controls what a producer does when its async queue is full.
+ */
+enum class OverflowPolicy {
+    kDrop,   //!< Discard the message and count it. Never stalls the caller.
+    kBlock,  //!< Wait for the background thread to free a slot.
+};
+
+/**
+ * @brief Settings for the asynchronous logging backend.
+ */
+struct AsyncOptions
+{
+    //! Records buffered per producer thread. Rounded up to a power of two.
+    size_t queueCapacity = 1024;
+    //! Behaviour when a producer's queue is full.
+    OverflowPolicy overflowPolicy = OverflowPolicy::kDrop;
+    //! Upper bound on the time spent draining queues on shutdown.
+    uint32_t flushTimeoutMs = 100;
+    //! Interval at which the background thread calls LogRateLimitSummary. Zero disables it.
+    uint32_t rateLimitSummaryMs = 10000;
+};
+
 /**
  * @brief Set the Application Name to show in log out
  *
@@ -20,14 +89,49 @@ enum class LogLevel {
  */
 void SetApplicationName(char const* applicationName);
 
+/**
+ * @brief Returns the name set with SetApplicationName
+ */
+char const* ApplicationName();
+
+/**
+ * @brief Returns the display name of a log level, e.g. "INFO"
+ */
+char const* StringifyLogLevel(LogLevel level);
+
 /**
  * @brief Set the Logging Level object
  *
  * @param level A user defined log level settings
- *              to control log output
+ *              to control log output. Messages at
+ *              this level and above are written.
  */
 void SetLoggingLevel(LogLevel level);
 
+/**
+ * @brief Enable or disable messages from a category.
+ *        All categories are enabled by default.
+ */
+void SetCategoryEnabled(LogCategory category, bool enabled);
+
+/**
+ * @brief Returns true if messages of this level pass the
+ *        current logging level
+ */
+inline bool IsLevelEnabled(LogLevel level)
+{
+    return (detail::sEnabledMask.load(std::memory_order_relaxed) & static_cast<uint32_t>(level)) != 0;
+}
+
+/**
+ * @brief Returns true if both the level and the category are enabled.
+ */
+inline bool IsEnabled(LogLevel level, LogCategory category)
+{
+    uint32_t const bits = static_cast<uint32_t>(level) | static_cast<uint32_t>(category);
+    return (detail::sEnabledMask.load(std::memory_order_relaxed) & bits) == bits;
+}
+
 /**
  * @brief Log a message to the standard output
  *        with a specified log level and
@@ -42,38 +146,517 @@ void SetLoggingLevel(LogLevel level);
  */
 void LogMessage(LogLevel level, const char* format, ...);
 
+/**
+ * @brief Switch logging to asynchronous mode.
+ *
+ *        Every producer thread writes its messages into a private
+ *        lock-free ring buffer and a background thread formats them
+ *        and passes them to the log sinks. The LOG_* and PHI_LOG_*
+ *        calls only copy the format string pointer and their raw
+ *        arguments, encoded as in binary mode, so their format string
+ *        must outlive the call, as a literal does. Direct calls to
+ *        LogMessage, and calls whose arguments do not fit a ring slot,
+ *        are formatted on the calling thread. Ordering is preserved per
+ *        producer thread only. Messages longer than the ring slot are
+ *        truncated.
+ *
+ * @param options Queue sizing, overflow and shutdown settings
+ */
+void EnableAsyncLogging(AsyncOptions const& options = AsyncOptions());
+
+/**
+ * @brief Drain pending records, stop the background thread and
+ *        return to synchronous logging. Draining gives up after
+ *        AsyncOptions::flushTimeoutMs. Messages logged concurrently
+ *        with this call may be lost.
+ */
+void DisableAsyncLogging();
+
+/**
+ * @brief Returns true if asynchronous logging is active.
+ */
+bool IsAsyncLoggingEnabled();
+
+/**
+ * @brief Refresh the coarse clock the PHI_LOG_*_EVERY_MS macros compare
+ *        against, so that a suppressed call does not read the system clock.
+ *        The application calls it once per frame, which makes the windows
+ *        as precise as a frame.
+ */
+void UpdateLogClock();
+
+/**
+ * @brief Return the PHI_LOG_*_EVERY_MS macros to reading steady_clock on
+ *        every call. Call it when UpdateLogClock stops being called.
+ */
+void ResetLogClock();
+
+/**
+ * @brief Write one line per rate limited call site that suppressed
+ *        messages since the previous summary. Called periodically by
+ *        the async backend; call it directly in synchronous mode.
+ */
+void LogRateLimitSummary();
+
+/**
+ * @brief Switch the LOG_* functions to binary mode.
+ *
+ *        Instead of formatting, each call stores the format string
+ *        pointer and its raw typed arguments in a compact record that
+ *        is appended to a memory-mapped file. Formatting is deferred to
+ *        DecodeBinaryLog. Records that do not fit in the file are
+ *        dropped and counted. Binary mode takes precedence over async
+ *        mode; direct calls to LogMessage are unaffected.
+ *
+ * @note  Integers, enums, floating point values, C strings (truncated
+ *        to 255 characters) and pointers are stored raw. A call with any
+ *        other argument type is formatted on the calling thread and
+ *        stored as a single string.
+ *
+ * @param path Output file. Created or truncated.
+ * @param capacityBytes Size of the mapping. Fixed for the session.
+ * @return Bool value indicating success or failure
+ */
+bool EnableBinaryLogging(char const* path, size_t capacityBytes);
+
+/**
+ * @brief Unmap and trim the binary log file. Must not race with
+ *        threads that are still logging.
+ */
+void DisableBinaryLogging();
+
+/**
+ * @brief Returns true if binary logging is active.
+ */
+bool IsBinaryLoggingEnabled();
+
+/**
+ * @brief Convert a binary log file back to text.
+ *
+ * @param path File written by EnableBinaryLogging
+ * @param output Stream that receives one line per record
+ * @param printTimestamps Prefix lines with seconds since logging began
+ * @return false if the file could not be read or is malformed
+ */
+bool DecodeBinaryLog(char const* path, FILE* output, bool printTimestamps = false);
+
+namespace detail {
+
+//! Argument tags in a binary record. The low nibble of a tag holds
+//! the payload size for fixed size types.
+enum class ArgType : uint8_t {
+    kSigned   = 1,
+    kUnsigned = 2,
+    kFloat    = 3,
+    kString   = 4,
+    kPointer  = 5,
+};
+
+constexpr size_t kMaxStringArgLength = 255;
+
+inline std::atomic<bool> sBinaryLoggingEnabled{ false };
+inline std::atomic<bool> sAsyncLoggingEnabled{ false };
+
+//! Encoded argument bytes an async ring slot holds.
+constexpr size_t kMaxDeferredArgBytes = 496;
+
+/**
+ * @brief Reserve a record in the binary log, fill its header and
+ *        return a pointer to the argument payload. Returns nullptr if
+ *        the file is full.
+ */
+uint8_t* BeginBinaryRecord(LogLevel level, char const* format, size_t argBytes);
+
+/**
+ * @brief Format a message on the calling thread and store it in the binary
+ *        log as a single string argument.
+ */
+void LogBinaryFormatted(LogLevel level, char const* format, ...);
+
+/**
+ * @brief Reserve a slot in the calling thread's async queue and return a
+ *        pointer to its argument payload of argBytes bytes. Returns nullptr
+ *        if the message was dropped. Publish the slot with EndDeferredRecord.
+ */
+uint8_t* BeginDeferredRecord(LogLevel level, char const* format, size_t argBytes);
+void     EndDeferredRecord();
+
+/**
+ * @brief Apply a format string to arguments encoded with EncodeArg and
+ *        write the null terminated result to buffer, truncating it to
+ *        fit. Returns the length written.
+ */
+size_t FormatEncodedMessage(char* buffer, size_t bufferSize, char const* format, uint8_t const* args, size_t argBytes);
+
+template <typename T>
+inline constexpr bool kIsCString = std::is_same_v<T, char*> || std::is_same_v<T, char const*>;
+
+template <typename T>
+inline constexpr bool kAlwaysFalse = false;
+
+//! Argument types EncodeArg stores raw.
+template <typename T>
+inline constexpr bool kIsEncodable = kIsCString<T> || std::is_integral_v<T> || std::is_enum_v<T> ||
+                                     std::is_floating_point_v<T> || std::is_pointer_v<T>;
+
+template <typename... Targs>
+inline constexpr bool kAllEncodable = (kIsEncodable<std::decay_t<Targs>> && ...);
+
+inline constexpr uint8_t MakeArgTag(ArgType type, size_t size)
+{
+    return static_cast<uint8_t>((static_cast<uint8_t>(type) << 4) | size);
+}
+
+inline char const* StringArg(char const* value)
+{
+    return value ? value : "(null)";
+}
+
+template <typename T>
+inline size_t EncodedArgSize(T const& value)
+{
+    using U = std::decay_t<T>;
+    (void)value;
+    if constexpr (kIsCString<U>) {
+        return 1 + sizeof(uint16_t) + strnlen(StringArg(value), kMaxStringArgLength);
+    } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+        return 1 + sizeof(U);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return 1 + sizeof(double);
+    } else if constexpr (std::is_pointer_v<U>) {
+        return 1 + sizeof(uint64_t);
+    } else {
+        //! Callers check kAllEncodable first.
+        static_assert(kAlwaysFalse<U>, "Unsupported LOG_* argument type");
+        return 0;
+    }
+}
+
+template <typename T>
+inline uint8_t* EncodeArg(uint8_t* dst, T const& value)
+{
+    using U = std::decay_t<T>;
+    if constexpr (kIsCString<U>) {
+        char const*    string = StringArg(value);
+        uint16_t const length = static_cast<uint16_t>(strnlen(string, kMaxStringArgLength));
+        *dst++                = MakeArgTag(ArgType::kString, 0);
+        memcpy(dst, &length, sizeof(length));
+        memcpy(dst + sizeof(length), string, length);
+        return dst + sizeof(length) + length;
+    } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+        using Integer  = typename std::conditional_t<std::is_enum_v<U>, std::underlying_type<U>, std::common_type<U>>::type;
+        Integer number = static_cast<Integer>(value);
+        *dst++         = MakeArgTag(std::is_signed_v<Integer> ? ArgType::kSigned : ArgType::kUnsigned, sizeof(Integer));
+        memcpy(dst, &number, sizeof(Integer));
+        return dst + sizeof(Integer);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        double number = static_cast<double>(value);
+        *dst++        = MakeArgTag(ArgType::kFloat, sizeof(double));
+        memcpy(dst, &number, sizeof(double));
+        return dst + sizeof(double);
+    } else {
+        uint64_t address = reinterpret_cast<uintptr_t>(value);
+        *dst++           = MakeArgTag(ArgType::kPointer, sizeof(uint64_t));
+        memcpy(dst, &address, sizeof(uint64_t));
+        return dst + sizeof(uint64_t);
+    }
+}
+
+template <typename... Targs>
+inline void LogBinary(LogLevel level, char const* format, Targs const&... args)
+{
+    if constexpr (kAllEncodable<Targs...>) {
+        size_t const argBytes = (size_t(0) + ... + EncodedArgSize(args));
+        uint8_t*     dst      = BeginBinaryRecord(level, format, argBytes);
+        if (!dst) {
+            return;
+        }
+        ((dst = EncodeArg(dst, args)), ...);
+        (void)dst;
+    } else {
+        LogBinaryFormatted(level, format, args...);
+    }
+}
+
+template <typename... Targs>
+inline void LogDeferred(LogLevel level, char const* format, Targs const&... args)
+{
+    size_t const argBytes = (size_t(0) + ... + EncodedArgSize(args));
+    if (argBytes > kMaxDeferredArgBytes) {
+        LogMessage(level, format, args...);
+        return;
+    }
+    uint8_t* dst = BeginDeferredRecord(level, format, argBytes);
+    if (!dst) {
+        return;
+    }
+    ((dst = EncodeArg(dst, args)), ...);
+    EndDeferredRecord();
+}
+
+//! Callers are expected to have filtered on level and category.
+template <typename... Targs>
+inline void Dispatch(LogLevel level, char const* message, Targs&&... args)
+{
+    if (sBinaryLoggingEnabled.load(std::memory_order_relaxed)) {
+        LogBinary(level, message, args...);
+        return;
+    }
+    if constexpr (kAllEncodable<Targs...>) {
+        if (sAsyncLoggingEnabled.load(std::memory_order_relaxed)) {
+            LogDeferred(level, message, args...);
+            return;
+        }
+    }
+    LogMessage(level, message, std::forward<Targs&&>(args)...);
+}
+
+/**
+ * @brief Per call site state of the PHI_LOG_*_EVERY_N, _EVERY_MS and
+ *        _FIRST_N macros. Constant initialised, so the static in the
+ *        macro needs no guard. A suppressed call costs one relaxed
+ *        atomic read-modify-write, plus for _EVERY_MS two relaxed loads
+ *        while UpdateLogClock keeps the coarse clock current.
+ */
+enum class RateLimit : uint8_t {
+    kEveryN,
+    kEveryMs,
+    kFirstN,
+};
+
+//! Coarse clock for the _EVERY_MS macros in ms. Zero reads steady_clock.
+inline std::atomic<uint64_t> sLogClockMs{ 0 };
+
+struct RateLimitSite
+{
+    constexpr RateLimitSite(char const* siteFile, int siteLine, RateLimit siteKind, uint64_t siteParam)
+        : file(siteFile), line(siteLine), kind(siteKind), param(siteParam > 0 ? siteParam : 1)
+    {
+    }
+
+    char const* const     file;
+    int const             line;
+    RateLimit const       kind;
+    uint64_t const        param;
+    //! Calls so far; for kEveryMs, calls suppressed so far.
+    std::atomic<uint64_t> state{ 0 };
+    //! kEveryMs: time in ms from which the next call logs.
+    std::atomic<uint64_t> deadline{ 0 };
+    std::atomic<bool>     registered{ false };
+    //! Intrusive list of sites walked by LogRateLimitSummary.
+    RateLimitSite* next = nullptr;
+    //! Suppressed count at the last summary. Owned by LogRateLimitSummary.
+    uint64_t reported = 0;
+};
+
+/**
+ * @brief Add a site to the summary list. Only reached on the logging path.
+ */
+void RegisterRateLimitSite(RateLimitSite& site);
+
+inline bool Admit(RateLimitSite& site)
+{
+    if (!site.registered.load(std::memory_order_relaxed)) {
+        RegisterRateLimitSite(site);
+    }
+    return true;
+}
+
+inline bool ShouldLogEveryN(RateLimitSite& site)
+{
+    return site.state.fetch_add(1, std::memory_order_relaxed) % site.param == 0 && Admit(site);
+}
+
+inline bool ShouldLogFirstN(RateLimitSite& site)
+{
+    return site.state.fetch_add(1, std::memory_order_relaxed) < site.param && Admit(site);
+}
+
+inline uint64_t RateLimitNowMs()
+{
+    uint64_t const coarse = sLogClockMs.load(std::memory_order_relaxed);
+    if (coarse != 0) {
+        return coarse;
+    }
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline bool ShouldLogEveryMs(RateLimitSite& site)
+{
+    uint64_t const now      = RateLimitNowMs();
+    uint64_t       deadline = site.deadline.load(std::memory_order_relaxed);
+    //! Deadline passed: the thread that installs the next one logs.
+    if (now < deadline || !site.deadline.compare_exchange_strong(deadline, now + site.param, std::memory_order_relaxed)) {
+        site.state.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return Admit(site);
+}
+
+}  // namespace detail
+
+/**
+ * Logging functions. A call below PHYSIKA_LOG_MIN_LEVEL compiles to an
+ * empty function, but as with any function call its arguments are still
+ * evaluated. Only the PHI_LOG_* macros below skip argument evaluation, so
+ * prefer them where the arguments cost anything to compute.
+ */
+
 template <typename... Targs>
 inline void LOG_FATAL(char const* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kFatal, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kFatal)) {
+        if (IsLevelEnabled(LogLevel::kFatal)) {
+            detail::Dispatch(LogLevel::kFatal, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 
 template <typename... Targs>
 inline void LOG_ERROR(char const* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kError, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kError)) {
+        if (IsLevelEnabled(LogLevel::kError)) {
+            detail::Dispatch(LogLevel::kError, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 
 template <typename... Targs>
 inline void LOG_WARN(char const* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kWarn, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kWarn)) {
+        if (IsLevelEnabled(LogLevel::kWarn)) {
+            detail::Dispatch(LogLevel::kWarn, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 
 template <typename... Targs>
 inline void LOG_INFO(const char* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kInfo, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kInfo)) {
+        if (IsLevelEnabled(LogLevel::kInfo)) {
+            detail::Dispatch(LogLevel::kInfo, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 
 template <typename... Targs>
 inline void LOG_DEBUG(char const* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kDebug, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kDebug)) {
+        if (IsLevelEnabled(LogLevel::kDebug)) {
+            detail::Dispatch(LogLevel::kDebug, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 template <typename... Targs>
 inline void LOG_TRACE(char const* message, Targs&&... args)
 {
-    LogMessage(LogLevel::kTrace, message, std::forward<Targs&&>(args)...);
+    if constexpr (IsCompiledIn(LogLevel::kTrace)) {
+        if (IsLevelEnabled(LogLevel::kTrace)) {
+            detail::Dispatch(LogLevel::kTrace, message, std::forward<Targs&&>(args)...);
+        }
+    }
 }
 }  // namespace physika::core::logger
+
+/**
+ * Categorised logging macros. Unlike the LOG_* functions, the arguments
+ * are not evaluated when the call is filtered out: levels below
+ * PHYSIKA_LOG_MIN_LEVEL compile to nothing and the runtime check is one
+ * load and test of the shared level/category mask.
+ *
+ * Usage: PHI_LOG_DEBUG(kRenderer, "Flushing command queue: %llu", fence);
+ */
+#define PHI_LOG(level, category, ...)                                                           \
+    do {                                                                                        \
+        if constexpr (::physika::core::logger::IsCompiledIn(level)) {                           \
+            if (::physika::core::logger::IsEnabled(level, category)) {                          \
+                ::physika::core::logger::detail::Dispatch(level, __VA_ARGS__);                  \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+#define PHI_LOG_FATAL(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kFatal, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+#define PHI_LOG_ERROR(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kError, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+#define PHI_LOG_WARN(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kWarn, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+#define PHI_LOG_INFO(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kInfo, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+#define PHI_LOG_DEBUG(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kDebug, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+#define PHI_LOG_TRACE(category, ...) \
+    PHI_LOG(::physika::core::logger::LogLevel::kTrace, ::physika::core::logger::LogCategory::category, __VA_ARGS__)
+
+/**
+ * Rate limited variants of the PHI_LOG_* macros for per-frame code. Each
+ * call site keeps its own state; N and MS must be constants.
+ *
+ *   PHI_LOG_INFO_EVERY_N(kRenderer, 100, ...)   logs calls 1, N+1, 2N+1...
+ *   PHI_LOG_INFO_EVERY_MS(kRenderer, 1000, ...) logs at most once per MS
+ *   PHI_LOG_INFO_FIRST_N(kRenderer, 10, ...)    logs the first N calls only
+ *
+ * Suppressed calls are reported per call site by LogRateLimitSummary.
+ */
+#define PHI_LOG_RATE_LIMITED(kind, check, param, level, category, ...)                                           \
+    do {                                                                                                         \
+        if constexpr (::physika::core::logger::IsCompiledIn(level)) {                                            \
+            static ::physika::core::logger::detail::RateLimitSite phiRateLimitSite(                              \
+                __FILE__, __LINE__, ::physika::core::logger::detail::RateLimit::kind, param);                    \
+            if (::physika::core::logger::IsEnabled(level, category) &&                                           \
+                ::physika::core::logger::detail::check(phiRateLimitSite)) {                                      \
+                ::physika::core::logger::detail::Dispatch(level, __VA_ARGS__);                                   \
+            }                                                                                                    \
+        }                                                                                                        \
+    } while (0)
+
+#define PHI_LOG_EVERY_N(level, category, n, ...) \
+    PHI_LOG_RATE_LIMITED(kEveryN, ShouldLogEveryN, n, level, category, __VA_ARGS__)
+#define PHI_LOG_EVERY_MS(level, category, ms, ...) \
+    PHI_LOG_RATE_LIMITED(kEveryMs, ShouldLogEveryMs, ms, level, category, __VA_ARGS__)
+#define PHI_LOG_FIRST_N(level, category, n, ...) \
+    PHI_LOG_RATE_LIMITED(kFirstN, ShouldLogFirstN, n, level, category, __VA_ARGS__)
+
+#define PHI_LOG_FATAL_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kFatal, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_ERROR_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kError, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_WARN_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kWarn, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_INFO_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kInfo, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_DEBUG_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kDebug, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_TRACE_EVERY_N(category, n, ...) \
+    PHI_LOG_EVERY_N(::physika::core::logger::LogLevel::kTrace, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+
+#define PHI_LOG_FATAL_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kFatal, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+#define PHI_LOG_ERROR_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kError, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+#define PHI_LOG_WARN_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kWarn, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+#define PHI_LOG_INFO_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kInfo, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+#define PHI_LOG_DEBUG_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kDebug, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+#define PHI_LOG_TRACE_EVERY_MS(category, ms, ...) \
+    PHI_LOG_EVERY_MS(::physika::core::logger::LogLevel::kTrace, ::physika::core::logger::LogCategory::category, ms, __VA_ARGS__)
+
+#define PHI_LOG_FATAL_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kFatal, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_ERROR_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kError, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_WARN_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kWarn, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_INFO_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kInfo, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_DEBUG_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kDebug, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
+#define PHI_LOG_TRACE_FIRST_N(category, n, ...) \
+    PHI_LOG_FIRST_N(::physika::core::logger::LogLevel::kTrace, ::physika::core::logger::LogCategory::category, n, __VA_ARGS__)
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, SIZE_MAX
+
+namespace physika::core {
+
+/**
+ * @brief A file mapped into the address space of the process.
+ *
+ *        Writable mappings are created at a fixed size up front so
+ *        that writers only ever touch memory. Close can shrink the
+ *        file to the number of bytes actually used.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const& other)            = delete;
+    MappedFile& operator=(MappedFile const& other) = delete;
+
+    /**
+     * @brief Create (or truncate) a file of the given size and map
+     *        it for reading and writing. The contents are zeroed.
+     *
+     * @param path Path of the file to create
+     * @param size Size of the mapping in bytes
+     * @return Bool value indicating success or failure
+     */
+    bool Create(char const* path, size_t size);
+
+    /**
+     * @brief Map an existing file for reading.
+     *
+     * @param path Path of the file to open
+     * @return Bool value indicating success or failure
+     */
+    bool OpenReadOnly(char const* path);
+
+    //! Close argument that leaves the file at its mapped size.
+    static constexpr size_t kKeepSize = SIZE_MAX;
+
+    /**
+     * @brief Unmap the file.
+     *
+     * @param finalSize If the mapping is writable, the file is truncated
+     *                  to this many bytes. Zero leaves an empty file.
+     */
+    void Close(size_t finalSize = kKeepSize);
+
+    bool IsOpen() const;
+
+    uint8_t* Data();
+
+    uint8_t const* Data() const;
+
+    size_t Size() const;
+
+private:
+    uint8_t* mData     = nullptr;
+    size_t   mSize     = 0;
+    bool     mWritable = false;
+
+#ifdef _WIN32
+    void* mFileHandle    = nullptr;
+    void* mMappingHandle = nullptr;
+#else
+    int mFileDescriptor = -1;
+#endif
+};
+
+}  // namespace physika::core
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, uint64_t
+
+#include <new>  // operator new
+#include <vector>
+
+//! Set to 0 to compile allocation tracking out; tracked allocators then
+//! behave like std::allocator. Controlled by the PHYSIKA_ENABLE_MEMORY_TRACKING
+//! CMake option.
+#ifndef PHYSIKA_MEMORY_TRACKING_ENABLED
+#define PHYSIKA_MEMORY_TRACKING_ENABLED 1
+#endif
+
+namespace physika::core::memory {
+
+/**
+ * @brief Subsystems memory is accounted to.
+ */
+enum class MemoryTag : uint8_t {
+    kGeneral,
+    kMesh,
+    kMaterial,
+    kLogging,
+    kFrame,
+    kStaging,
+    kCount
+};
+
+/**
+ * @brief Memory accounted to one tag. Rates are averages since the
+ *        process started tracking.
+ */
+struct TagStats
+{
+    char const* name        = nullptr;
+    uint64_t    liveBytes   = 0;
+    uint64_t    peakBytes   = 0;
+    uint64_t    allocations = 0;
+    uint64_t    frees       = 0;
+    //! Bytes ever allocated, including those since freed.
+    uint64_t totalBytes           = 0;
+    double   allocationsPerSecond = 0.0;
+    double   bytesPerSecond       = 0.0;
+};
+
+char const* TagName(MemoryTag tag);
+
+#if PHYSIKA_MEMORY_TRACKING_ENABLED
+/**
+ * @brief Account bytes allocated elsewhere (GPU staging, D3D blobs, ...)
+ *        to tag. Every TrackAllocation needs a matching TrackFree.
+ */
+void TrackAllocation(MemoryTag tag, size_t bytes);
+void TrackFree(MemoryTag tag, size_t bytes);
+#else
+inline void TrackAllocation(MemoryTag /*tag*/, size_t /*bytes*/)
+{
+}
+inline void TrackFree(MemoryTag /*tag*/, size_t /*bytes*/)
+{
+}
+#endif
+
+/**
+ * @brief Returns what is accounted to tag; all zeros when tracking is
+ *        compiled out.
+ */
+TagStats Stats(MemoryTag tag);
+
+/**
+ * @brief Write the stats of every tag that saw an allocation to the log.
+ */
+void LogStats(char const* label);
+
+/**
+ * @brief STL allocator that accounts its memory to kTag.
+ */
+template <typename T, MemoryTag kTag>
+class TrackingAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = TrackingAllocator<U, kTag>;
+    };
+
+    TrackingAllocator() noexcept = default;
+
+    template <typename U>
+    TrackingAllocator(TrackingAllocator<U, kTag> const& /*other*/) noexcept
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        TrackAllocation(kTag, count * sizeof(T));
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept
+    {
+        TrackFree(kTag, count * sizeof(T));
+        ::operator delete(pointer);
+    }
+
+    template <typename U>
+    bool operator==(TrackingAllocator<U, kTag> const& /*other*/) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(TrackingAllocator<U, kTag> const& /*other*/) const noexcept
+    {
+        return false;
+    }
+};
+
+template <typename T, MemoryTag kTag>
+using TrackedVector = std::vector<T, TrackingAllocator<T, kTag>>;
+
+}  // namespace physika::core::memory
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdint.h>  // uint32_t
+
+#include <vector>
+
+//! Set to 0 to compile PROFILE_SCOPE and PROFILE_END_FRAME out.
+//! Controlled by the PHYSIKA_ENABLE_PROFILER CMake option.
+#ifndef PHYSIKA_PROFILER_ENABLED
+#define PHYSIKA_PROFILER_ENABLED 1
+#endif
+
+namespace physika::core::profiler {
+
+constexpr uint32_t kNoParent = UINT32_MAX;
+
+/**
+ * @brief Aggregated timing of one scope path within a frame.
+ *        Repeated calls of a scope under the same parent are merged.
+ */
+struct ProfileNode
+{
+    char const* name;
+    //! Index of the parent node or kNoParent for a root scope.
+    uint32_t parent;
+    uint32_t depth;
+    //! Index of the thread in registration order.
+    uint32_t thread;
+    uint32_t calls;
+    double   totalMs;
+    //! totalMs minus the time spent in child scopes.
+    double selfMs;
+};
+
+/**
+ * @brief Hierarchical timings of the scopes that finished during a frame.
+ *        Parents always precede their children in nodes.
+ */
+struct FrameProfile
+{
+    uint64_t                 frameIndex = 0;
+    //! Time between the two EndFrame calls that bracket the frame.
+    double                   frameMs = 0.0;
+    //! Scopes lost because a thread buffer filled up.
+    uint64_t                 droppedScopes = 0;
+    std::vector<ProfileNode> nodes;
+};
+
+/**
+ * @brief Name the calling thread in exported traces.
+ *
+ * @param name A null terminated character string
+ */
+void SetThreadName(char const* name);
+
+/**
+ * @brief Collect the scopes recorded by every thread since the previous
+ *        call and aggregate them into LastFrame. Call once per frame
+ *        from a single thread.
+ */
+void EndFrame();
+
+/**
+ * @brief Returns the profile built by the last EndFrame call.
+ *        Valid until the next EndFrame.
+ */
+FrameProfile const& LastFrame();
+
+/**
+ * @brief Keep every scope collected by EndFrame until StopCapture.
+ */
+void StartCapture();
+
+/**
+ * @brief Write the captured scopes as Chrome trace-event JSON, viewable
+ *        in chrome://tracing or Perfetto, and end the capture.
+ *
+ * @param path Output file. Created or truncated.
+ * @return Bool value indicating success or failure
+ */
+bool StopCapture(char const* path);
+
+/**
+ * @brief Returns true between StartCapture and StopCapture.
+ */
+bool IsCapturing();
+
+namespace detail {
+
+//! Current time in ticks of the profiler clock.
+int64_t Now();
+
+void RecordScope(char const* name, int64_t begin, int64_t end, uint32_t depth);
+
+//! Nesting depth of open scopes on this thread.
+inline thread_local uint32_t tDepth = 0;
+
+}  // namespace detail
+
+/**
+ * @brief Records the lifetime of a C++ scope. Use PROFILE_SCOPE.
+ *
+ * @note  name must outlive the profiler, e.g. a string literal.
+ */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(char const* name) : mName(name), mDepth(detail::tDepth++), mBegin(detail::Now())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        detail::RecordScope(mName, mBegin, detail::Now(), mDepth);
+        --detail::tDepth;
+    }
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    char const* mName;
+    uint32_t    mDepth;
+    int64_t     mBegin;
+};
+
+}  // namespace physika::core::profiler
+
+#define PHI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PHI_PROFILE_CONCAT(a, b)      PHI_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Usage: PROFILE_SCOPE("Draw"); times the rest of the enclosing scope.
+ */
+#if PHYSIKA_PROFILER_ENABLED
+#define PROFILE_SCOPE(name) \
+    ::physika::core::profiler::ProfileScope PHI_PROFILE_CONCAT(phiProfileScope, __LINE__)(name)
+#define PROFILE_END_FRAME() ::physika::core::profiler::EndFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint32_t
+
+#include <utility>  // forward, move
+#include <vector>
+
+namespace physika::core {
+
+/**
+ * @brief Refers to an object in a SlotMap<T>. A handle outlives its object
+ *        safely: once the object is removed the handle no longer resolves.
+ */
+template <typename T>
+struct Handle
+{
+    static uint32_t const kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index      = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const
+    {
+        return index != kInvalidIndex;
+    }
+
+    bool operator==(Handle const& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(Handle const& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Object pool addressed by generational handles.
+ *
+ *        Objects are stored densely, so iterating a SlotMap walks a plain
+ *        array. A handle names a slot that maps to the object's current
+ *        dense position; Remove moves the last object into the hole and
+ *        bumps the slot's generation, so Insert and Remove are O(1) and
+ *        handles to removed objects fail to resolve instead of aliasing
+ *        whatever reuses the slot.
+ *
+ * @note  Pointers and references to objects are invalidated by Insert and
+ *        Remove; keep handles instead.
+ */
+template <typename T>
+class SlotMap
+{
+public:
+    using HandleType = Handle<T>;
+
+    SlotMap()
+        : mFreeHead{ HandleType::kInvalidIndex }
+    {
+    }
+
+    void Reserve(size_t count)
+    {
+        mSlots.reserve(count);
+        mValues.reserve(count);
+        mValueSlots.reserve(count);
+    }
+
+    template <typename... Args>
+    HandleType Emplace(Args&&... args)
+    {
+        uint32_t slotIndex = mFreeHead;
+        if (slotIndex != HandleType::kInvalidIndex) {
+            mFreeHead = mSlots[slotIndex].value;
+        } else {
+            slotIndex = static_cast<uint32_t>(mSlots.size());
+            mSlots.push_back(Slot{});
+        }
+        mValues.emplace_back(std::forward<Args>(args)...);
+        mValueSlots.push_back(slotIndex);
+
+        Slot& slot = mSlots[slotIndex];
+        slot.value = static_cast<uint32_t>(mValues.size() - 1);
+        return HandleType{ slotIndex, slot.generation };
+    }
+
+    HandleType Insert(T value)
+    {
+        return Emplace(std::move(value));
+    }
+
+    /**
+     * @brief Remove the object handle refers to. Returns false if the
+     *        handle is stale or invalid.
+     */
+    bool Remove(HandleType handle)
+    {
+        if (!Contains(handle)) {
+            return false;
+        }
+        Slot&          slot  = mSlots[handle.index];
+        uint32_t const value = slot.value;
+        uint32_t const last  = static_cast<uint32_t>(mValues.size() - 1);
+        if (value != last) {
+            mValues[value]                   = std::move(mValues[last]);
+            mValueSlots[value]               = mValueSlots[last];
+            mSlots[mValueSlots[value]].value = value;
+        }
+        mValues.pop_back();
+        mValueSlots.pop_back();
+
+        slot.generation += 1;
+        slot.value = mFreeHead;
+        mFreeHead  = handle.index;
+        return true;
+    }
+
+    bool Contains(HandleType handle) const
+    {
+        return handle.index < mSlots.size() && mSlots[handle.index].generation == handle.generation &&
+               mSlots[handle.index].value < mValues.size() && mValueSlots[mSlots[handle.index].value] == handle.index;
+    }
+
+    /**
+     * @brief Returns the object or nullptr if handle is stale.
+     */
+    T* Get(HandleType handle)
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.index].value] : nullptr;
+    }
+
+    T const* Get(HandleType handle) const
+    {
+        return Contains(handle) ? &mValues[mSlots[handle.index].value] : nullptr;
+    }
+
+    /**
+     * @brief Unchecked access for handles known to be live; stale handles
+     *        assert in debug builds.
+     */
+    T& operator[](HandleType handle)
+    {
+        assert(Contains(handle) && "Stale or invalid handle");
+        return mValues[mSlots[handle.index].value];
+    }
+
+    T const& operator[](HandleType handle) const
+    {
+        assert(Contains(handle) && "Stale or invalid handle");
+        return mValues[mSlots[handle.index].value];
+    }
+
+    /**
+     * @brief Returns the handle of the object at dense position index.
+     */
+    HandleType HandleAt(size_t index) const
+    {
+        uint32_t const slotIndex = mValueSlots[index];
+        return HandleType{ slotIndex, mSlots[slotIndex].generation };
+    }
+
+    void Clear()
+    {
+        for (size_t ii = 0; ii < mValueSlots.size(); ++ii) {
+            Slot& slot = mSlots[mValueSlots[ii]];
+            slot.generation += 1;
+            slot.value = mFreeHead;
+            mFreeHead  = mValueSlots[ii];
+        }
+        mValues.clear();
+        mValueSlots.clear();
+    }
+
+    size_t Size() const
+    {
+        return mValues.size();
+    }
+
+    bool Empty() const
+    {
+        return mValues.empty();
+    }
+
+    T* Data()
+    {
+        return mValues.data();
+    }
+
+    T const* Data() const
+    {
+        return mValues.data();
+    }
+
+    typename std::vector<T>::iterator begin()
+    {
+        return mValues.begin();
+    }
+
+    typename std::vector<T>::iterator end()
+    {
+        return mValues.end();
+    }
+
+    typename std::vector<T>::const_iterator begin() const
+    {
+        return mValues.begin();
+    }
+
+    typename std::vector<T>::const_iterator end() const
+    {
+        return mValues.end();
+    }
+
+private:
+    struct Slot
+    {
+        //! Dense position while live, next free slot while free.
+        uint32_t value      = 0;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot>     mSlots;
+    std::vector<T>        mValues;
+    std::vector<uint32_t> mValueSlots;
+    uint32_t              mFreeHead;
+};
+
+}  // namespace physika::core
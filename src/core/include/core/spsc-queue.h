@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+
+#include <atomic>
+#include <memory>  // unique_ptr
+
+namespace physika::core {
+
+/**
+ * @brief A bounded, lock-free, single producer / single consumer queue.
+ *
+ *        Slots are preallocated at construction so neither side ever
+ *        allocates. Producers can write in place with BeginPush/EndPush
+ *        and consumers can read in place with Front/Pop to avoid copying
+ *        large elements.
+ *
+ * @note  Exactly one thread may push and exactly one thread may pop
+ *        at any given time.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @brief Construct a new queue.
+     *
+     * @param capacity Number of slots. Rounded up to a power of two.
+     */
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t roundedCapacity = 2;
+        while (roundedCapacity < capacity) {
+            roundedCapacity <<= 1;
+        }
+        mMask  = roundedCapacity - 1;
+        mSlots = std::make_unique<T[]>(roundedCapacity);
+    }
+
+    SpscQueue(SpscQueue const& other)            = delete;
+    SpscQueue& operator=(SpscQueue const& other) = delete;
+
+    /**
+     * @brief Producer: returns the next free slot or nullptr when
+     *        the queue is full. Call EndPush to publish the slot.
+     */
+    T* BeginPush()
+    {
+        size_t const tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mCachedHead > mMask) {
+            mCachedHead = mHead.load(std::memory_order_acquire);
+            if (tail - mCachedHead > mMask) {
+                return nullptr;
+            }
+        }
+        return &mSlots[tail & mMask];
+    }
+
+    /**
+     * @brief Producer: publishes the slot returned by BeginPush.
+     */
+    void EndPush()
+    {
+        mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Producer: copies value into the queue.
+     * @return false if the queue is full.
+     */
+    bool TryPush(T const& value)
+    {
+        T* slot = BeginPush();
+        if (!slot) {
+            return false;
+        }
+        *slot = value;
+        EndPush();
+        return true;
+    }
+
+    /**
+     * @brief Consumer: returns the oldest element or nullptr when
+     *        the queue is empty. Call Pop to release the slot.
+     */
+    T* Front()
+    {
+        size_t const head = mHead.load(std::memory_order_relaxed);
+        if (head == mCachedTail) {
+            mCachedTail = mTail.load(std::memory_order_acquire);
+            if (head == mCachedTail) {
+                return nullptr;
+            }
+        }
+        return &mSlots[head & mMask];
+    }
+
+    /**
+     * @brief Consumer: releases the slot returned by Front.
+     */
+    void Pop()
+    {
+        mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer: moves the oldest element into value.
+     * @return false if the queue is empty.
+     */
+    bool TryPop(T& value)
+    {
+        T* slot = Front();
+        if (!slot) {
+            return false;
+        }
+        value = std::move(*slot);
+        Pop();
+        return true;
+    }
+
+    /**
+     * @brief Returns true if there is nothing to consume.
+     *        Safe to call from either side.
+     */
+    bool Empty() const
+    {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the number of slots in the queue.
+     */
+    size_t Capacity() const
+    {
+        return mMask + 1;
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::unique_ptr<T[]> mSlots;
+    size_t               mMask = 0;
+
+    //! Consumer owned
+    alignas(kCacheLineSize) std::atomic<size_t> mHead{ 0 };
+    size_t mCachedTail = 0;
+
+    //! Producer owned
+    alignas(kCacheLineSize) std::atomic<size_t> mTail{ 0 };
+    size_t mCachedHead = 0;
+};
+
+}  // namespace physika::core
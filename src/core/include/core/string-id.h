@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint64_t
+
+#include <functional>  // hash
+#include <string_view>
+
+//! Set to 1 to keep the text of every StringId built from a runtime string
+//! so Name() can show it. On by default in debug builds.
+#ifndef PHYSIKA_STRING_ID_NAMES
+#ifdef NDEBUG
+#define PHYSIKA_STRING_ID_NAMES 0
+#else
+#define PHYSIKA_STRING_ID_NAMES 1
+#endif
+#endif
+
+namespace physika::core {
+
+/**
+ * @brief 64-bit FNV-1a of text; usable at compile time.
+ */
+constexpr uint64_t Fnv1a64(char const* text, size_t length)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t ii = 0; ii < length; ++ii) {
+        hash ^= static_cast<uint8_t>(text[ii]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief A name reduced to its 64-bit hash, for use as a map key.
+ *
+ *        Ids built from string literals are hashed at compile time, so
+ *        looking up map["cube"] compares two integers. Ids built from
+ *        runtime strings hash once at construction and, when names are
+ *        enabled, record their text in a global intern table so Name()
+ *        can show it while debugging. The table also reports two
+ *        different strings hashing to the same id.
+ */
+class StringId
+{
+public:
+    constexpr StringId() = default;
+
+    template <size_t N>
+    constexpr StringId(char const (&literal)[N]) : mHash{ Fnv1a64(literal, LiteralLength(literal)) }
+    {
+    }
+
+    explicit StringId(std::string_view text);
+
+    static constexpr StringId FromHash(uint64_t hash)
+    {
+        StringId id;
+        id.mHash = hash;
+        return id;
+    }
+
+    constexpr uint64_t Hash() const
+    {
+        return mHash;
+    }
+
+    /**
+     * @brief Returns the interned text, or "<unnamed>" for ids that were
+     *        never built from a runtime string or when names are off.
+     */
+    char const* Name() const;
+
+    constexpr bool operator==(StringId other) const
+    {
+        return mHash == other.mHash;
+    }
+
+    constexpr bool operator!=(StringId other) const
+    {
+        return mHash != other.mHash;
+    }
+
+    constexpr bool operator<(StringId other) const
+    {
+        return mHash < other.mHash;
+    }
+
+private:
+    template <size_t N>
+    static constexpr size_t LiteralLength(char const (&literal)[N])
+    {
+        size_t length = 0;
+        while (length + 1 < N && literal[length] != '\0') {
+            ++length;
+        }
+        return length;
+    }
+
+    uint64_t mHash = 0;
+};
+
+}  // namespace physika::core
+
+template <>
+struct std::hash<physika::core::StringId>
+{
+    size_t operator()(physika::core::StringId id) const noexcept
+    {
+        return static_cast<size_t>(id.Hash());
+    }
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stdint.h>  // uint32_t, int64_t
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>  // unique_ptr
+#include <vector>
+
+#include "core/job-system.h"
+#include "core/timer.h"
+
+namespace physika::core {
+
+/**
+ * @brief When one task ran during the last TaskGraph::Execute, in
+ *        milliseconds from the start of Execute.
+ */
+struct TaskTiming
+{
+    char const* name       = nullptr;
+    double      startMs    = 0.0;
+    double      durationMs = 0.0;
+    //! The task lies on the longest dependency chain of the frame.
+    bool critical = false;
+};
+
+/**
+ * @brief Timings of the last TaskGraph::Execute.
+ */
+struct TaskGraphTimings
+{
+    double frameMs = 0.0;
+    //! Sum of task durations along the longest dependency chain. The frame
+    //! cannot finish faster than this however many threads there are.
+    double                  criticalPathMs = 0.0;
+    std::vector<TaskTiming> tasks;
+};
+
+/**
+ * @brief A graph of frame tasks ordered by the resources they touch.
+ *
+ *        Tasks are declared in the order they would run serially, each
+ *        with the resources it reads and writes. Compile turns that into
+ *        dependencies: a task waits for the last earlier writer of every
+ *        resource it touches, and writers also wait for earlier readers.
+ *        Execute then runs every task whose dependencies are done on the
+ *        job system, so independent tasks overlap.
+ *
+ * @note  Task and resource names must outlive the graph, as with
+ *        PROFILE_SCOPE.
+ */
+class TaskGraph
+{
+public:
+    using TaskId     = uint32_t;
+    using ResourceId = uint32_t;
+
+    explicit TaskGraph(JobSystem& jobs);
+    ~TaskGraph();
+
+    TaskGraph(TaskGraph const& other)            = delete;
+    TaskGraph& operator=(TaskGraph const& other) = delete;
+
+    /**
+     * @brief Declare a resource tasks can read or write.
+     */
+    ResourceId AddResource(char const* name);
+
+    /**
+     * @brief Declare a task after all tasks it should follow.
+     */
+    TaskId AddTask(char const* name, std::function<void()> function, std::initializer_list<ResourceId> reads,
+                   std::initializer_list<ResourceId> writes);
+
+    /**
+     * @brief Derive the dependencies. Execute compiles on first use; adding
+     *        tasks afterwards requires compiling again.
+     */
+    void Compile();
+
+    /**
+     * @brief Run every task once and return when all are done.
+     */
+    void Execute();
+
+    /**
+     * @brief Returns the tasks that must finish before task starts.
+     */
+    std::vector<TaskId> const& Dependencies(TaskId task) const;
+
+    /**
+     * @brief Returns the number of declared tasks.
+     */
+    uint32_t TaskCount() const;
+
+    /**
+     * @brief Returns the timings of the last Execute.
+     */
+    TaskGraphTimings const& LastTimings() const;
+
+    /**
+     * @brief Write the last timings to the log, critical tasks marked with '*'.
+     */
+    void LogTimings(char const* label) const;
+
+private:
+    struct Task
+    {
+        char const*             name = nullptr;
+        std::function<void()>   function;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        std::vector<TaskId>     dependencies;
+        std::vector<TaskId>     dependents;
+
+        std::atomic<uint32_t> remaining{ 0 };
+        int64_t               startTicks = 0;
+        int64_t               endTicks   = 0;
+    };
+
+    void RunTask(TaskId id);
+    void UpdateTimings(int64_t frameStart, int64_t frameEnd);
+
+    JobSystem&                         mJobs;
+    std::vector<char const*>           mResources;
+    std::vector<std::unique_ptr<Task>> mTasks;
+    std::vector<TaskId>                mRoots;
+    bool                               mCompiled;
+
+    JobCounter*      mFrameCounter;
+    TimerBackend     mBackend;
+    double           mMsPerTick;
+    TaskGraphTimings mTimings;
+};
+
+}  // namespace physika::core
@@ -2,10 +2,49 @@
 #include <stdint.h>  // int64_t
 namespace physika::core {
 
+/**
+ * @brief Clock a Timer samples. Unavailable backends fall back to kDefault.
+ */
+enum class TimerBackend {
+    kDefault,                  //!< QueryPerformanceCounter on Windows, CLOCK_MONOTONIC_RAW on Linux
+    kQueryPerformanceCounter,  //!< Windows only
+    kMonotonicRaw,             //!< clock_gettime(CLOCK_MONOTONIC_RAW), Linux only
+    kSteadyClock,              //!< std::chrono::steady_clock, always available
+    kInvariantTsc,             //!< rdtsc calibrated against steady_clock. x86 with invariant TSC only
+};
+
+/**
+ * @brief Returns true if the backend can be used on this machine.
+ */
+bool IsTimerBackendAvailable(TimerBackend backend);
+
+/**
+ * @brief Maps kDefault and unavailable backends to the clock
+ *        that will actually be sampled.
+ */
+TimerBackend ResolveTimerBackend(TimerBackend backend);
+
+/**
+ * @brief Returns the current value of a clock in ticks.
+ *
+ * @note  The backend must be resolved. Cheap enough to call
+ *        from instrumentation such as the profiler.
+ */
+int64_t ReadTicks(TimerBackend backend);
+
+/**
+ * @brief Returns the number of ticks per second of a resolved backend.
+ *        The invariant TSC is calibrated on first use.
+ */
+int64_t TicksPerSecond(TimerBackend backend);
+
 /**
  * @brief Represent a timer object which can start/stop a timer
  *        and sample time at user-defined intervals
  *
+ *        Time is accumulated in integer ticks of the selected
+ *        clock and only converted to seconds when read, so the
+ *        running total does not lose precision over long sessions.
  */
 class Timer
 {
@@ -13,8 +52,9 @@ public:
     /**
      * @brief Construct a new Timer object
      *
+     * @param backend Clock to sample
      */
-    Timer();
+    Timer(TimerBackend backend = TimerBackend::kDefault);
 
     /**
      * @brief Returns the total duration in seconds
@@ -23,6 +63,11 @@ public:
      */
     float TotalRunningTime();
 
+    /**
+     * @brief Double precision version of TotalRunningTime.
+     */
+    double TotalRunningTimeSeconds() const;
+
     /**
      * @brief Call this function to sample time
      *        between intervals.
@@ -55,14 +100,25 @@ public:
      */
     float Delta();
 
+    /**
+     * @brief Double precision version of Delta.
+     */
+    double DeltaSeconds() const;
+
+    /**
+     * @brief Returns the clock the timer samples.
+     */
+    TimerBackend Backend() const;
+
 private:
     bool mStopped;
 
-    float mDelta;
-    float mTotalRunningTime;
-    float mSecondsPerCount;
+    TimerBackend mBackend;
+    int64_t      mTicksPerSecond;
+    double       mSecondsPerTick;
 
-    int64_t mStartTime;
+    int64_t mDeltaTicks;
+    int64_t mTotalTicks;
     int64_t mPreviousTime;
 };
-}  // namespace physika::core
\ No newline at end of file
+}  // namespace physika::core
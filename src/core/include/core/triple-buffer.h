@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+#include <atomic>
+
+namespace physika::core {
+
+/**
+ * @brief A lock-free triple buffer handing whole snapshots from one writer
+ *        thread to one reader thread.
+ *
+ *        The writer fills WriteBuffer and Publishes it; the reader calls
+ *        Acquire to swap in the newest published snapshot and reads it
+ *        through ReadBuffer. Neither side ever waits: the writer can
+ *        publish faster than the reader consumes (intermediate snapshots
+ *        are skipped) and the reader keeps its last snapshot while
+ *        nothing new is published.
+ *
+ * @note  After Publish the writer gets an older buffer back, so each
+ *        snapshot has to be written in full.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(TripleBuffer const& other)            = delete;
+    TripleBuffer& operator=(TripleBuffer const& other) = delete;
+
+    /**
+     * @brief Writer: returns the buffer to fill for the next snapshot.
+     */
+    T& WriteBuffer()
+    {
+        return mBuffers[mWriteIndex];
+    }
+
+    /**
+     * @brief Writer: makes the current write buffer the newest snapshot.
+     */
+    void Publish()
+    {
+        uint8_t const previous = mMiddle.exchange(mWriteIndex | kFresh, std::memory_order_acq_rel);
+        mWriteIndex            = previous & kIndexMask;
+    }
+
+    /**
+     * @brief Reader: switch to the newest published snapshot.
+     * @return false if nothing was published since the last Acquire.
+     */
+    bool Acquire()
+    {
+        if ((mMiddle.load(std::memory_order_relaxed) & kFresh) == 0) {
+            return false;
+        }
+        uint8_t const previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+        mReadIndex             = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * @brief Reader: returns the snapshot taken by the last Acquire.
+     */
+    T const& ReadBuffer() const
+    {
+        return mBuffers[mReadIndex];
+    }
+
+private:
+    static constexpr size_t  kCacheLineSize = 64;
+    static constexpr uint8_t kIndexMask     = 0x3;
+    static constexpr uint8_t kFresh         = 0x4;
+
+    T mBuffers[3] = {};
+
+    //! Index of the buffer between the two sides, plus kFresh when the reader has not taken it yet.
+    alignas(kCacheLineSize) std::atomic<uint8_t> mMiddle{ 1 };
+
+    //! Writer owned
+    alignas(kCacheLineSize) uint8_t mWriteIndex = 0;
+
+    //! Reader owned
+    alignas(kCacheLineSize) uint8_t mReadIndex = 2;
+};
+
+}  // namespace physika::core
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // int64_t
+
+#include <atomic>
+#include <memory>  // unique_ptr
+
+namespace physika::core {
+
+/**
+ * @brief A bounded Chase-Lev work-stealing deque.
+ *
+ *        The owning thread pushes and pops at the bottom (LIFO, so it
+ *        keeps working on hot data); any other thread steals from the
+ *        top (FIFO, so thieves take the oldest and usually largest
+ *        pieces of work). Only the last element is contended. Follows
+ *        the C11 formulation by Le, Pop, Cohen and Zappa Nardelli.
+ *
+ * @note  T must be cheap to copy, typically a pointer. Push, Pop: owner
+ *        thread only. Steal: any thread.
+ */
+template <typename T>
+class WorkStealingQueue
+{
+public:
+    /**
+     * @brief Construct a new queue.
+     *
+     * @param capacity Number of slots. Rounded up to a power of two.
+     */
+    explicit WorkStealingQueue(size_t capacity)
+    {
+        size_t roundedCapacity = 2;
+        while (roundedCapacity < capacity) {
+            roundedCapacity <<= 1;
+        }
+        mMask  = static_cast<int64_t>(roundedCapacity - 1);
+        mSlots = std::make_unique<std::atomic<T>[]>(roundedCapacity);
+    }
+
+    WorkStealingQueue(WorkStealingQueue const& other)            = delete;
+    WorkStealingQueue& operator=(WorkStealingQueue const& other) = delete;
+
+    /**
+     * @brief Owner: add value at the bottom.
+     * @return false if the queue is full.
+     */
+    bool Push(T value)
+    {
+        int64_t const bottom = mBottom.load(std::memory_order_relaxed);
+        int64_t const top    = mTop.load(std::memory_order_acquire);
+        if (bottom - top > mMask) {
+            return false;
+        }
+        mSlots[bottom & mMask].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Owner: take the most recently pushed value.
+     * @return false if the queue is empty or a thief won the last element.
+     */
+    bool Pop(T& value)
+    {
+        int64_t const bottom = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = mTop.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        value = mSlots[bottom & mMask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            //! Last element: race the thieves for it.
+            bool const won =
+                mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Any thread: take the oldest value.
+     * @return false if the queue is empty or another thread got there first.
+     */
+    bool Steal(T& value)
+    {
+        int64_t top = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t const bottom = mBottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        value = mSlots[top & mMask].load(std::memory_order_relaxed);
+        return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns an estimate of the number of queued values.
+     */
+    size_t Size() const
+    {
+        int64_t const bottom = mBottom.load(std::memory_order_relaxed);
+        int64_t const top    = mTop.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    /**
+     * @brief Returns the number of slots in the queue.
+     */
+    size_t Capacity() const
+    {
+        return static_cast<size_t>(mMask + 1);
+    }
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    std::unique_ptr<std::atomic<T>[]> mSlots;
+    int64_t                           mMask = 0;
+
+    //! Thieves
+    alignas(kCacheLineSize) std::atomic<int64_t> mTop{ 0 };
+
+    //! Owner
+    alignas(kCacheLineSize) std::atomic<int64_t> mBottom{ 0 };
+};
+
+}  // namespace physika::core
@@ -0,0 +1,94 @@
+#include "core/input-queue.h"
+
+#include <string.h>  // memset
+
+namespace physika::core {
+
+void InputState::BeginFrame()
+{
+    memset(keyPressed, 0, sizeof(keyPressed));
+    memset(keyReleased, 0, sizeof(keyReleased));
+    mouseDeltaX = 0;
+    mouseDeltaY = 0;
+    wheelDelta  = 0;
+    events      = 0;
+}
+
+void InputState::Apply(InputEvent const& event)
+{
+    events += 1;
+    switch (event.type) {
+    case InputEventType::kKeyDown:
+    case InputEventType::kKeyUp:
+        if (event.code >= 0 && event.code < kKeyCodeCount) {
+            bool const down = event.type == InputEventType::kKeyDown;
+            //! Auto-repeat sends kKeyDown again without a kKeyUp in between.
+            if (down && !keyDown[event.code]) {
+                keyPressed[event.code] = true;
+            } else if (!down && keyDown[event.code]) {
+                keyReleased[event.code] = true;
+            }
+            keyDown[event.code] = down;
+        }
+        break;
+    case InputEventType::kMouseDown:
+        //! Button events carry the cursor position, so the next move's delta starts from there.
+        mouseButtons |= static_cast<MouseButton>(event.code);
+        mouseX = event.x;
+        mouseY = event.y;
+        break;
+    case InputEventType::kMouseUp:
+        //! code is the released button only; the others stay held.
+        mouseButtons = mouseButtons & static_cast<MouseButton>(~event.code);
+        mouseX       = event.x;
+        mouseY       = event.y;
+        break;
+    case InputEventType::kMouseMove:
+        mouseDeltaX += event.x - mouseX;
+        mouseDeltaY += event.y - mouseY;
+        mouseX = event.x;
+        mouseY = event.y;
+        break;
+    case InputEventType::kMouseWheel:
+        wheelDelta += event.code;
+        break;
+    }
+}
+
+InputQueue::InputQueue(size_t capacity)
+    : mQueue(capacity),
+      mBackend{ ResolveTimerBackend(TimerBackend::kDefault) },
+      mMsPerTick{ 1000.0 / static_cast<double>(TicksPerSecond(mBackend)) },
+      mDropped{ 0 },
+      mDrainedEvents{ 0 },
+      mLatencySum{ 0 },
+      mLatencyMax{ 0 },
+      mLastDrainMax{ 0 }
+{
+}
+
+bool InputQueue::Post(InputEvent const& event)
+{
+    Entry* slot = mQueue.BeginPush();
+    if (!slot) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    slot->event       = event;
+    slot->postedTicks = ReadTicks(mBackend);
+    mQueue.EndPush();
+    return true;
+}
+
+InputLatencyStats InputQueue::Latency() const
+{
+    InputLatencyStats stats;
+    stats.events         = mDrainedEvents;
+    stats.dropped        = mDropped.load(std::memory_order_relaxed);
+    stats.meanMs         = mDrainedEvents > 0 ? static_cast<double>(mLatencySum) / mDrainedEvents * mMsPerTick : 0.0;
+    stats.maxMs          = static_cast<double>(mLatencyMax) * mMsPerTick;
+    stats.lastDrainMaxMs = static_cast<double>(mLastDrainMax) * mMsPerTick;
+    return stats;
+}
+
+}  // namespace physika::core
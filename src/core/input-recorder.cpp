@@ -0,0 +1,293 @@
+#include "core/input-recorder.h"
+
+#include <stdio.h>
+
+namespace {
+
+using namespace physika::core;
+
+uint8_t const kMagic[]  = { 'P', 'H', 'I', 'R' };
+uint8_t const kVersion  = 1;
+uint8_t const kEndEvent = 0xFF;
+
+void WriteVarint(std::vector<uint8_t>& data, uint64_t value)
+{
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteSigned(std::vector<uint8_t>& data, int64_t value)
+{
+    //! Zigzag so small negative deltas stay small.
+    WriteVarint(data, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+class Reader
+{
+public:
+    Reader(std::vector<uint8_t> const& data) : mData(data), mOffset(0), mFailed(false) {}
+
+    bool AtEnd() const
+    {
+        return mOffset >= mData.size();
+    }
+
+    bool Failed() const
+    {
+        return mFailed;
+    }
+
+    uint8_t Byte()
+    {
+        if (AtEnd()) {
+            mFailed = true;
+            return 0;
+        }
+        return mData[mOffset++];
+    }
+
+    uint64_t Varint()
+    {
+        uint64_t value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            uint8_t const byte = Byte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        mFailed = true;
+        return 0;
+    }
+
+    int64_t Signed()
+    {
+        uint64_t const value = Varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+private:
+    std::vector<uint8_t> const& mData;
+    size_t                      mOffset;
+    bool                        mFailed;
+};
+
+}  // namespace
+
+namespace physika::core {
+
+InputRecorder::InputRecorder()
+    : mBackend{ ResolveTimerBackend(TimerBackend::kDefault) },
+      mTicksPerUs{ static_cast<double>(TicksPerSecond(mBackend)) * 1e-6 }
+{
+    Reset();
+}
+
+void InputRecorder::Reset()
+{
+    mData.assign(kMagic, kMagic + sizeof(kMagic));
+    mData.push_back(kVersion);
+    mStartTicks = ReadTicks(mBackend);
+    mLastFrame  = 0;
+    mLastTimeUs = 0;
+    mLastX      = 0;
+    mLastY      = 0;
+    mEventCount = 0;
+    mFinished   = false;
+}
+
+void InputRecorder::Append(uint8_t type, uint64_t frame, uint64_t timeUs)
+{
+    //! Frames and time never run backwards; clamp so deltas stay unsigned.
+    frame  = frame < mLastFrame ? mLastFrame : frame;
+    timeUs = timeUs < mLastTimeUs ? mLastTimeUs : timeUs;
+    mData.push_back(type);
+    WriteVarint(mData, frame - mLastFrame);
+    WriteVarint(mData, timeUs - mLastTimeUs);
+    mLastFrame  = frame;
+    mLastTimeUs = timeUs;
+}
+
+void InputRecorder::Record(uint64_t frame, InputEvent const& event)
+{
+    if (mFinished) {
+        return;
+    }
+    uint64_t const timeUs = static_cast<uint64_t>((ReadTicks(mBackend) - mStartTicks) / mTicksPerUs);
+    Append(static_cast<uint8_t>(event.type), frame, timeUs);
+
+    switch (event.type) {
+    case InputEventType::kKeyDown:
+    case InputEventType::kKeyUp:
+        WriteVarint(mData, static_cast<uint32_t>(event.code));
+        break;
+    case InputEventType::kMouseDown:
+    case InputEventType::kMouseUp:
+        WriteVarint(mData, static_cast<uint32_t>(event.code));
+        [[fallthrough]];
+    case InputEventType::kMouseMove:
+        WriteSigned(mData, static_cast<int64_t>(event.x) - mLastX);
+        WriteSigned(mData, static_cast<int64_t>(event.y) - mLastY);
+        mLastX = event.x;
+        mLastY = event.y;
+        break;
+    case InputEventType::kMouseWheel:
+        WriteSigned(mData, event.code);
+        break;
+    }
+    mEventCount += 1;
+}
+
+void InputRecorder::Finish(uint64_t frame)
+{
+    if (mFinished) {
+        return;
+    }
+    uint64_t const timeUs = static_cast<uint64_t>((ReadTicks(mBackend) - mStartTicks) / mTicksPerUs);
+    Append(kEndEvent, frame, timeUs);
+    mFinished = true;
+}
+
+size_t InputRecorder::EventCount() const
+{
+    return mEventCount;
+}
+
+std::vector<uint8_t> const& InputRecorder::Data() const
+{
+    return mData;
+}
+
+bool InputRecorder::Save(char const* path) const
+{
+    FILE* file = path ? fopen(path, "wb") : nullptr;
+    if (!file) {
+        return false;
+    }
+    bool const written = fwrite(mData.data(), 1, mData.size(), file) == mData.size();
+    return fclose(file) == 0 && written;
+}
+
+bool InputReplay::Load(std::vector<uint8_t> const& data)
+{
+    mEvents.clear();
+    mNext     = 0;
+    mEndFrame = 0;
+
+    Reader reader(data);
+    for (uint8_t const expected : kMagic) {
+        if (reader.Byte() != expected) {
+            return false;
+        }
+    }
+    if (reader.Byte() != kVersion) {
+        return false;
+    }
+
+    RecordedInputEvent record;
+    int32_t            lastX = 0;
+    int32_t            lastY = 0;
+    while (!reader.AtEnd()) {
+        uint8_t const type = reader.Byte();
+        record.frame += reader.Varint();
+        record.timeUs += reader.Varint();
+        if (type == kEndEvent) {
+            mEndFrame = record.frame;
+            break;
+        }
+
+        InputEvent& event = record.event;
+        event             = InputEvent{};
+        event.type        = static_cast<InputEventType>(type);
+        switch (event.type) {
+        case InputEventType::kKeyDown:
+        case InputEventType::kKeyUp:
+            event.code = static_cast<int32_t>(reader.Varint());
+            break;
+        case InputEventType::kMouseDown:
+        case InputEventType::kMouseUp:
+            event.code = static_cast<int32_t>(reader.Varint());
+            [[fallthrough]];
+        case InputEventType::kMouseMove:
+            lastX   = static_cast<int32_t>(lastX + reader.Signed());
+            lastY   = static_cast<int32_t>(lastY + reader.Signed());
+            event.x = lastX;
+            event.y = lastY;
+            break;
+        case InputEventType::kMouseWheel:
+            event.code = static_cast<int32_t>(reader.Signed());
+            break;
+        default:
+            mEvents.clear();
+            return false;
+        }
+        if (reader.Failed()) {
+            mEvents.clear();
+            return false;
+        }
+        mEvents.push_back(record);
+    }
+    if (reader.Failed()) {
+        mEvents.clear();
+        return false;
+    }
+    //! A recording cut short without Finish ends after its last event.
+    if (mEndFrame == 0 && !mEvents.empty()) {
+        mEndFrame = mEvents.back().frame + 1;
+    }
+    return true;
+}
+
+bool InputReplay::Load(char const* path)
+{
+    FILE* file = path ? fopen(path, "rb") : nullptr;
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t              buffer[4096];
+    size_t               read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return Load(data);
+}
+
+bool InputReplay::NextEvent(uint64_t frame, RecordedInputEvent* event)
+{
+    //! Skip anything left over from frames that were never polled.
+    while (mNext < mEvents.size() && mEvents[mNext].frame < frame) {
+        ++mNext;
+    }
+    if (mNext == mEvents.size() || mEvents[mNext].frame != frame) {
+        return false;
+    }
+    *event = mEvents[mNext++];
+    return true;
+}
+
+bool InputReplay::Finished(uint64_t frame) const
+{
+    return frame >= mEndFrame;
+}
+
+void InputReplay::Restart()
+{
+    mNext = 0;
+}
+
+std::vector<RecordedInputEvent> const& InputReplay::Events() const
+{
+    return mEvents;
+}
+
+uint64_t InputReplay::EndFrame() const
+{
+    return mEndFrame;
+}
+
+}  // namespace physika::core
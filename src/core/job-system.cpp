@@ -0,0 +1,258 @@
+#include "core/job-system.h"
+
+#include <algorithm>  // max
+#include <chrono>
+
+#include "core/profiler.h"
+
+namespace {
+
+//! Deque slots and ring-allocated jobs per thread.
+size_t const   kQueueCapacity = 4096;
+uint32_t const kSpinRounds    = 64;
+
+std::chrono::milliseconds const kSleepTimeout(100);
+//! Ranges per thread ParallelFor aims for when picking a grain.
+uint32_t const kRangesPerThread = 8;
+
+}  // namespace
+
+namespace physika::core {
+
+struct JobSystem::Worker
+{
+    explicit Worker(uint32_t workerIndex)
+        : queue(kQueueCapacity), jobs(std::make_unique<Job[]>(kQueueCapacity)), index(workerIndex)
+    {
+    }
+
+    WorkStealingQueue<Job*> queue;
+    std::unique_ptr<Job[]>  jobs;
+    uint32_t                nextJob = 0;
+    uint32_t                index;
+    uint32_t                random = 0x9E3779B9u;
+
+    std::atomic<uint64_t> executed{ 0 };
+    std::atomic<uint64_t> stolen{ 0 };
+};
+
+namespace {
+
+//! The deque of the current thread, if it belongs to a job system.
+struct ThreadBinding
+{
+    JobSystem const* system = nullptr;
+    void*            worker = nullptr;
+};
+
+thread_local ThreadBinding tBinding;
+
+}  // namespace
+
+JobSystem::JobSystem(uint32_t workerThreads)
+    : mHasInjected{ false }, mEpoch{ 0 }, mSleepers{ 0 }, mStop{ false }, mInlined{ 0 }
+{
+    for (uint32_t ii = 0; ii <= workerThreads; ++ii) {
+        mWorkers.push_back(std::make_unique<Worker>(ii));
+    }
+    //! The creating thread owns deque 0.
+    tBinding = ThreadBinding{ this, mWorkers[0].get() };
+    for (uint32_t ii = 1; ii <= workerThreads; ++ii) {
+        mThreads.emplace_back([this, ii]() { WorkerMain(ii); });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    //! Finish anything still queued before the workers go away.
+    Job* job = nullptr;
+    while ((job = FindJob(mWorkers[0].get())) != nullptr) {
+        Execute(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop.store(true);
+    }
+    mSleepCondition.notify_all();
+    for (auto& thread : mThreads) {
+        thread.join();
+    }
+    if (tBinding.system == this) {
+        tBinding = ThreadBinding{};
+    }
+}
+
+uint32_t JobSystem::DefaultWorkerThreads()
+{
+    unsigned int const hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+uint32_t JobSystem::ThreadCount() const
+{
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+uint32_t JobSystem::AutoGrain(uint32_t count) const
+{
+    return std::max(1u, count / (ThreadCount() * kRangesPerThread));
+}
+
+JobSystem::Job* JobSystem::AllocateJob()
+{
+    if (tBinding.system == this) {
+        Worker* self = static_cast<Worker*>(tBinding.worker);
+        Job*    job  = &self->jobs[self->nextJob];
+        if (!job->busy.load(std::memory_order_acquire)) {
+            self->nextJob = (self->nextJob + 1) & (kQueueCapacity - 1);
+            job->busy.store(true, std::memory_order_relaxed);
+            job->heap = false;
+            return job;
+        }
+    }
+    //! Foreign thread, or every ring slot still in flight.
+    Job* job  = new Job;
+    job->heap = true;
+    return job;
+}
+
+void JobSystem::Submit(Job* job)
+{
+    if (job->counter) {
+        job->counter->mPending.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (tBinding.system == this) {
+        Worker* self = static_cast<Worker*>(tBinding.worker);
+        if (!self->queue.Push(job)) {
+            //! Deque full: running the job now is always correct and bounds memory.
+            mInlined.fetch_add(1, std::memory_order_relaxed);
+            Execute(job);
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(mInjectionMutex);
+        mInjected.push_back(job);
+        mHasInjected.store(true, std::memory_order_release);
+    }
+    Wake();
+}
+
+void JobSystem::Wake()
+{
+    mEpoch.fetch_add(1);
+    if (mSleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mSleepCondition.notify_one();
+    }
+}
+
+void JobSystem::Execute(Job* job)
+{
+    JobCounter* counter = job->counter;
+    job->invoke(*job);
+    if (job->heap) {
+        delete job;
+    } else {
+        job->busy.store(false, std::memory_order_release);
+    }
+    if (counter) {
+        counter->mPending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+JobSystem::Job* JobSystem::FindJob(Worker* self)
+{
+    Job* job = nullptr;
+    if (self && self->queue.Pop(job)) {
+        self->executed.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+    if (mHasInjected.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mInjectionMutex);
+        if (!mInjected.empty()) {
+            job = mInjected.front();
+            mInjected.pop_front();
+            mHasInjected.store(!mInjected.empty(), std::memory_order_relaxed);
+            if (self) {
+                self->executed.fetch_add(1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+    }
+
+    //! Try every other deque once, starting at a random victim.
+    size_t const count = mWorkers.size();
+    size_t       start = 0;
+    if (self) {
+        self->random ^= self->random << 13;
+        self->random ^= self->random >> 17;
+        self->random ^= self->random << 5;
+        start = self->random % count;
+    }
+    for (size_t ii = 0; ii < count; ++ii) {
+        Worker* victim = mWorkers[(start + ii) % count].get();
+        if (victim != self && victim->queue.Steal(job)) {
+            if (self) {
+                self->executed.fetch_add(1, std::memory_order_relaxed);
+                self->stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    Worker* self = mWorkers[index].get();
+    tBinding     = ThreadBinding{ this, self };
+    profiler::SetThreadName("Job worker");
+
+    uint32_t idleRounds = 0;
+    while (!mStop.load(std::memory_order_acquire)) {
+        uint64_t const epoch = mEpoch.load();
+        if (Job* job = FindJob(self)) {
+            Execute(job);
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < kSpinRounds) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        //! Nothing came in while spinning: sleep until a job is submitted. The timeout is only a backstop.
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepers.fetch_add(1);
+        mSleepCondition.wait_for(lock, kSleepTimeout,
+                                 [this, epoch]() { return mStop.load() || mEpoch.load() != epoch; });
+        mSleepers.fetch_sub(1);
+        idleRounds = 0;
+    }
+    tBinding = ThreadBinding{};
+}
+
+void JobSystem::Wait(JobCounter const& counter)
+{
+    Worker* self = tBinding.system == this ? static_cast<Worker*>(tBinding.worker) : nullptr;
+    while (!counter.Done()) {
+        if (Job* job = FindJob(self)) {
+            Execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystemStats JobSystem::Stats() const
+{
+    JobSystemStats stats;
+    for (auto const& worker : mWorkers) {
+        stats.executed += worker->executed.load(std::memory_order_relaxed);
+        stats.stolen += worker->stolen.load(std::memory_order_relaxed);
+    }
+    stats.inlined = mInlined.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace physika::core
@@ -0,0 +1,111 @@
+#include "core/log-sinks.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>  // min
+
+namespace physika::core::logger {
+
+void LogSink::Flush()
+{
+}
+
+void ConsoleSink::Write(LogLevel /*level*/, char const* line, size_t length)
+{
+    fwrite(line, 1, length, stdout);
+}
+
+void ConsoleSink::Flush()
+{
+    fflush(stdout);
+}
+
+FileSink::FileSink(char const* path) : mFile{ path ? fopen(path, "wb") : nullptr }
+{
+}
+
+FileSink::~FileSink()
+{
+    if (mFile) {
+        fclose(mFile);
+    }
+}
+
+bool FileSink::IsOpen() const
+{
+    return mFile != nullptr;
+}
+
+void FileSink::Write(LogLevel /*level*/, char const* line, size_t length)
+{
+    if (mFile) {
+        fwrite(line, 1, length, mFile);
+    }
+}
+
+void FileSink::Flush()
+{
+    if (mFile) {
+        fflush(mFile);
+    }
+}
+
+MappedFileSink::MappedFileSink(MappedFileSinkOptions const& options)
+    : mOptions(options), mSegmentIndex{ 0 }, mOffset{ 0 }
+{
+    OpenSegment(0);
+}
+
+MappedFileSink::~MappedFileSink()
+{
+    mSegment.Close(mOffset);
+}
+
+bool MappedFileSink::IsOpen() const
+{
+    return mSegment.IsOpen();
+}
+
+std::string MappedFileSink::SegmentPath(uint32_t index) const
+{
+    return mOptions.basePath + "." + std::to_string(index) + ".log";
+}
+
+uint32_t MappedFileSink::CurrentSegment() const
+{
+    return mSegmentIndex;
+}
+
+bool MappedFileSink::OpenSegment(uint32_t index)
+{
+    mSegmentIndex = index;
+    mOffset       = 0;
+    if (!mSegment.Create(SegmentPath(index).c_str(), mOptions.segmentSize)) {
+        return false;
+    }
+    if (mOptions.maxSegments > 0 && index >= mOptions.maxSegments) {
+        remove(SegmentPath(index - mOptions.maxSegments).c_str());
+    }
+    return true;
+}
+
+void MappedFileSink::Write(LogLevel /*level*/, char const* line, size_t length)
+{
+    if (!mSegment.IsOpen()) {
+        return;
+    }
+    if (mOffset > 0 && mOffset + length > mSegment.Size()) {
+        //! Trim the full segment to the bytes written and start the next
+        //! one. A line longer than a segment is truncated instead.
+        mSegment.Close(mOffset);
+        if (!OpenSegment(mSegmentIndex + 1)) {
+            return;
+        }
+    }
+    size_t const bytes = std::min(length, mSegment.Size());
+    memcpy(mSegment.Data() + mOffset, line, bytes);
+    mOffset += bytes;
+}
+
+}  // namespace physika::core::logger
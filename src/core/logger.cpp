@@ -3,14 +3,358 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include <algorithm>  // min
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>  // shared_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/log-sinks.h"
+#include "core/memory-tracker.h"
+#include "core/spsc-queue.h"
+
 namespace {
 
+using namespace physika::core;
 using namespace physika::core::logger;
 
-LogLevel sLevel;
-char     sApplicationName[1024] = { '\0' };
+char sApplicationName[1024] = { '\0' };
+
+int const kBufferSize = 2048;
+//! Room for the application name and level prefix.
+int const kLineSize = kBufferSize + 64;
+
+//! Sinks are called with the mutex held, so they need no locking of their own.
+struct SinkRegistry
+{
+    std::mutex              mutex;
+    std::vector<LogSinkPtr> sinks{ std::make_shared<ConsoleSink>() };
+};
+
+//! Function local so logging from static initialisers is safe.
+SinkRegistry& Sinks()
+{
+    static SinkRegistry registry;
+    return registry;
+}
+
+void WriteLine(LogLevel level, char const* message)
+{
+    char      line[kLineSize];
+    int const length = snprintf(line, sizeof(line) - 1, "[%s] [%s]: %s", sApplicationName, StringifyLogLevel(level), message);
+    if (length < 0) {
+        return;
+    }
+    size_t size  = std::min<size_t>(length, sizeof(line) - 2);
+    line[size++] = '\n';
+
+    SinkRegistry&               registry = Sinks();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto const& sink : registry.sinks) {
+        sink->Write(level, line, size);
+    }
+}
+
+//! Rate limited call sites
+
+std::atomic<detail::RateLimitSite*> sRateLimitSites{ nullptr };
+std::mutex                          sRateLimitSummaryMutex;
+
+//! Calls suppressed by a site since it was first reached.
+uint64_t SuppressedCount(detail::RateLimitSite const& site)
+{
+    uint64_t const state = site.state.load(std::memory_order_relaxed);
+    switch (site.kind) {
+    case detail::RateLimit::kEveryN:
+        return state - (state + site.param - 1) / site.param;
+    case detail::RateLimit::kFirstN:
+        return state > site.param ? state - site.param : 0;
+    case detail::RateLimit::kEveryMs:
+        return state;
+    default:
+        return 0;
+    }
+}
+
+char const* FileName(char const* path)
+{
+    char const* name = path;
+    for (char const* cc = path; *cc; ++cc) {
+        if (*cc == '/' || *cc == '\\') {
+            name = cc + 1;
+        }
+    }
+    return name;
+}
+
+//! Async backend
+
+//! A record either carries the format string and its encoded arguments,
+//! or, when format is null, text formatted by the producer.
+struct LogRecord
+{
+    LogLevel    level;
+    uint32_t    size;
+    char const* format;
+    uint8_t     payload[detail::kMaxDeferredArgBytes];
+};
+
+//! Sized so a record fills eight cache lines.
+static_assert(sizeof(LogRecord) == 512, "LogRecord layout changed");
+
+struct ProducerQueue
+{
+    explicit ProducerQueue(size_t capacity) : records(capacity)
+    {
+        memory::TrackAllocation(memory::MemoryTag::kLogging, records.Capacity() * sizeof(LogRecord));
+    }
+
+    ~ProducerQueue()
+    {
+        memory::TrackFree(memory::MemoryTag::kLogging, records.Capacity() * sizeof(LogRecord));
+    }
+
+    SpscQueue<LogRecord>  records;
+    std::atomic<uint64_t> dropped{ 0 };
+    //! Set when the owning thread exits. The worker releases the
+    //! queue once it has been drained.
+    std::atomic<bool> orphaned{ false };
+};
+
+using ProducerQueuePtr = std::shared_ptr<ProducerQueue>;
+
+struct AsyncBackend
+{
+    ~AsyncBackend()
+    {
+        //! Stop a worker the application forgot to shut down.
+        if (worker.joinable()) {
+            running.store(false, std::memory_order_release);
+            Wake();
+            worker.join();
+        }
+    }
+
+    void Wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeRequested = true;
+        }
+        wake.notify_one();
+    }
+
+    //! Written before the worker starts and read only by the worker.
+    AsyncOptions options;
+    //! The settings producers read, which may race with EnableAsyncLogging.
+    std::atomic<size_t>           queueCapacity{ 0 };
+    std::atomic<OverflowPolicy>   overflowPolicy{ OverflowPolicy::kDrop };
+    std::mutex                    registryMutex;
+    std::vector<ProducerQueuePtr> queues;
+    std::thread                   worker;
+    std::mutex                    wakeMutex;
+    std::condition_variable       wake;
+    bool                          wakeRequested = false;  //!< guarded by wakeMutex
+    //! Set while the worker waits, so producers only signal an idle worker.
+    std::atomic<bool> sleeping{ false };
+    std::atomic<bool> running{ false };
+};
+
+using detail::sAsyncLoggingEnabled;
+std::atomic<uint64_t> sAsyncGeneration{ 0 };
+std::mutex            sAsyncControlMutex;
+AsyncBackend          sBackend;
+
+//! Per thread handle to the producer queue. Marks the queue orphaned
+//! on thread exit so late records still get written.
+struct ProducerHandle
+{
+    ~ProducerHandle()
+    {
+        if (queue) {
+            queue->orphaned.store(true, std::memory_order_release);
+        }
+    }
+
+    ProducerQueuePtr queue;
+    uint64_t         generation = 0;
+};
+
+ProducerQueue& AcquireProducerQueue()
+{
+    thread_local ProducerHandle handle;
+
+    uint64_t const generation = sAsyncGeneration.load(std::memory_order_acquire);
+    if (!handle.queue || handle.generation != generation) {
+        if (handle.queue) {
+            handle.queue->orphaned.store(true, std::memory_order_release);
+        }
+        handle.queue      = std::make_shared<ProducerQueue>(sBackend.queueCapacity.load(std::memory_order_relaxed));
+        handle.generation = generation;
+
+        std::lock_guard<std::mutex> lock(sBackend.registryMutex);
+        sBackend.queues.push_back(handle.queue);
+    }
+    return *handle.queue;
+}
+
+LogRecord* ReserveRecord(ProducerQueue& queue)
+{
+    LogRecord* record = queue.records.BeginPush();
+    if (record || sBackend.overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::kDrop) {
+        return record;
+    }
+
+    sBackend.Wake();
+    while (!record && sAsyncLoggingEnabled.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+        record = queue.records.BeginPush();
+    }
+    return record;
+}
+
+void PublishRecord(ProducerQueue& queue)
+{
+    queue.records.EndPush();
+    //! Pairs with the fence in WaitForRecords: either the worker sees the
+    //! record before it sleeps or this thread sees it sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sBackend.sleeping.load(std::memory_order_relaxed)) {
+        sBackend.Wake();
+    }
+}
+
+//! Queue the record reserved by BeginDeferredRecord is in.
+thread_local ProducerQueue* tReservedQueue = nullptr;
+
+void EnqueueMessage(LogLevel level, char const* format, va_list args)
+{
+    ProducerQueue& queue  = AcquireProducerQueue();
+    LogRecord*     record = ReserveRecord(queue);
+    if (!record) {
+        queue.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    char* const text   = reinterpret_cast<char*>(record->payload);
+    int const   length = vsnprintf(text, sizeof(record->payload), format, args);
+    record->level      = level;
+    record->format     = nullptr;
+    record->size       = static_cast<uint32_t>(std::min<size_t>(length < 0 ? 0 : length, sizeof(record->payload) - 1));
+    PublishRecord(queue);
+}
+
+void WriteRecord(LogRecord const& record)
+{
+    if (!record.format) {
+        WriteLine(record.level, reinterpret_cast<char const*>(record.payload));
+        return;
+    }
+    char buffer[kBufferSize];
+    detail::FormatEncodedMessage(buffer, sizeof(buffer), record.format, record.payload, record.size);
+    WriteLine(record.level, buffer);
+}
+
+//! Writes everything currently queued. Returns the number of records written.
+size_t DrainQueues(std::vector<ProducerQueuePtr>& snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(sBackend.registryMutex);
+        snapshot = sBackend.queues;
+    }
+
+    size_t   written = 0;
+    uint64_t dropped = 0;
+    for (auto& queue : snapshot) {
+        while (LogRecord const* record = queue->records.Front()) {
+            WriteRecord(*record);
+            queue->records.Pop();
+            ++written;
+        }
+        dropped += queue->dropped.exchange(0, std::memory_order_relaxed);
+    }
+    if (dropped > 0) {
+        char message[64];
+        snprintf(message, sizeof(message), "async logger dropped %llu messages", static_cast<unsigned long long>(dropped));
+        WriteLine(LogLevel::kWarn, message);
+    }
+    if (written > 0 || dropped > 0) {
+        FlushSinks();
+    }
+
+    //! Release queues whose threads have exited and that are fully drained.
+    std::lock_guard<std::mutex> lock(sBackend.registryMutex);
+    auto&                       queues = sBackend.queues;
+    queues.erase(std::remove_if(queues.begin(), queues.end(),
+                                [](ProducerQueuePtr const& queue) {
+                                    return queue->orphaned.load(std::memory_order_acquire) && queue->records.Empty();
+                                }),
+                 queues.end());
+    return written;
+}
+
+bool QueuesEmpty()
+{
+    std::lock_guard<std::mutex> lock(sBackend.registryMutex);
+    for (auto const& queue : sBackend.queues) {
+        if (!queue->records.Empty()) {
+            return false;
+        }
+    }
+    return true;
+}
 
-const char* StringifyLogLevel(LogLevel level)
+//! Blocks until a producer publishes a record, Wake is called or the
+//! deadline passes. A zero deadline waits without a timeout.
+void WaitForRecords(std::chrono::steady_clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(sBackend.wakeMutex);
+    sBackend.sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sBackend.wakeRequested && QueuesEmpty() && sBackend.running.load(std::memory_order_acquire)) {
+        auto const woken = []() { return sBackend.wakeRequested; };
+        if (deadline.time_since_epoch().count() == 0) {
+            sBackend.wake.wait(lock, woken);
+        } else {
+            sBackend.wake.wait_until(lock, deadline, woken);
+        }
+    }
+    sBackend.wakeRequested = false;
+    sBackend.sleeping.store(false, std::memory_order_relaxed);
+}
+
+void WorkerMain()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<ProducerQueuePtr> snapshot;
+    auto const                    summaryInterval = std::chrono::milliseconds(sBackend.options.rateLimitSummaryMs);
+    auto                          nextSummary     = Clock::now() + summaryInterval;
+    while (sBackend.running.load(std::memory_order_acquire)) {
+        if (summaryInterval.count() > 0 && Clock::now() >= nextSummary) {
+            LogRateLimitSummary();
+            nextSummary = Clock::now() + summaryInterval;
+        }
+        if (DrainQueues(snapshot) == 0) {
+            WaitForRecords(summaryInterval.count() > 0 ? nextSummary : Clock::time_point());
+        }
+    }
+
+    //! Bounded flush on shutdown.
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(sBackend.options.flushTimeoutMs);
+    do {
+        DrainQueues(snapshot);
+    } while (!QueuesEmpty() && std::chrono::steady_clock::now() < deadline);
+}
+
+}  // namespace
+
+namespace physika::core::logger {
+
+char const* StringifyLogLevel(LogLevel level)
 {
     switch (level) {
     case LogLevel::kTrace:
@@ -29,13 +373,24 @@ const char* StringifyLogLevel(LogLevel level)
         return "";
     }
 }
-}  // namespace
-
-namespace physika::core::logger {
 
 void SetLoggingLevel(LogLevel level)
 {
-    sLevel = level;
+    //! Enable the requested level and every level above it.
+    uint32_t const levelBits = ~(static_cast<uint32_t>(level) - 1) & detail::kLevelMask;
+    uint32_t       mask      = detail::sEnabledMask.load(std::memory_order_relaxed);
+    while (!detail::sEnabledMask.compare_exchange_weak(mask, (mask & ~detail::kLevelMask) | levelBits,
+                                                       std::memory_order_relaxed)) {
+    }
+}
+
+void SetCategoryEnabled(LogCategory category, bool enabled)
+{
+    if (enabled) {
+        detail::sEnabledMask.fetch_or(static_cast<uint32_t>(category), std::memory_order_relaxed);
+    } else {
+        detail::sEnabledMask.fetch_and(~static_cast<uint32_t>(category), std::memory_order_relaxed);
+    }
 }
 
 void SetApplicationName(char const* applicationName)
@@ -46,19 +401,157 @@ void SetApplicationName(char const* applicationName)
     snprintf(sApplicationName, sizeof(sApplicationName) - 1, applicationName);
 }
 
+char const* ApplicationName()
+{
+    return sApplicationName;
+}
+
 void LogMessage(LogLevel level, char const* format...)
 {
-    if (level < sLevel) {
+    if (!IsLevelEnabled(level)) {
         return;
     }
-    int const kBufferSize         = 2048;
-    char      buffer[kBufferSize] = {};
-    va_list   args;
+    va_list args;
     va_start(args, format);
+    if (sAsyncLoggingEnabled.load(std::memory_order_acquire)) {
+        EnqueueMessage(level, format, args);
+        va_end(args);
+        return;
+    }
+    char buffer[kBufferSize] = {};
     vsnprintf(buffer, kBufferSize - 1, format, args);
     va_end(args);
 
-    printf("[%s] [%s]: %s\n", sApplicationName, StringifyLogLevel(level), buffer);
+    WriteLine(level, buffer);
+}
+
+void EnableAsyncLogging(AsyncOptions const& options)
+{
+    std::lock_guard<std::mutex> lock(sAsyncControlMutex);
+    if (sAsyncLoggingEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    sBackend.options = options;
+    sBackend.queueCapacity.store(options.queueCapacity, std::memory_order_relaxed);
+    sBackend.overflowPolicy.store(options.overflowPolicy, std::memory_order_relaxed);
+    sBackend.wakeRequested = false;
+    sBackend.running.store(true, std::memory_order_release);
+    sBackend.worker = std::thread(WorkerMain);
+
+    sAsyncGeneration.fetch_add(1, std::memory_order_acq_rel);
+    sAsyncLoggingEnabled.store(true, std::memory_order_release);
+}
+
+void DisableAsyncLogging()
+{
+    std::lock_guard<std::mutex> lock(sAsyncControlMutex);
+    if (!sAsyncLoggingEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    sAsyncLoggingEnabled.store(false, std::memory_order_release);
+    sBackend.running.store(false, std::memory_order_release);
+    sBackend.Wake();
+    sBackend.worker.join();
+
+    std::lock_guard<std::mutex> registryLock(sBackend.registryMutex);
+    sBackend.queues.clear();
+}
+
+bool IsAsyncLoggingEnabled()
+{
+    return sAsyncLoggingEnabled.load(std::memory_order_acquire);
+}
+
+uint8_t* detail::BeginDeferredRecord(LogLevel level, char const* format, size_t argBytes)
+{
+    ProducerQueue& queue  = AcquireProducerQueue();
+    LogRecord*     record = ReserveRecord(queue);
+    if (!record) {
+        queue.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    record->level  = level;
+    record->format = format;
+    record->size   = static_cast<uint32_t>(argBytes);
+    tReservedQueue = &queue;
+    return record->payload;
+}
+
+void detail::EndDeferredRecord()
+{
+    PublishRecord(*tReservedQueue);
+    tReservedQueue = nullptr;
+}
+
+void LogRateLimitSummary()
+{
+    std::lock_guard<std::mutex> lock(sRateLimitSummaryMutex);
+    for (auto* site = sRateLimitSites.load(std::memory_order_acquire); site; site = site->next) {
+        uint64_t const suppressed = SuppressedCount(*site);
+        if (suppressed > site->reported) {
+            LogMessage(LogLevel::kInfo, "%s:%d suppressed %llu messages (%llu total)", FileName(site->file), site->line,
+                       static_cast<unsigned long long>(suppressed - site->reported),
+                       static_cast<unsigned long long>(suppressed));
+            site->reported = suppressed;
+        }
+    }
+}
+
+void UpdateLogClock()
+{
+    using namespace std::chrono;
+    auto const now = duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    detail::sLogClockMs.store(static_cast<uint64_t>(now), std::memory_order_relaxed);
+}
+
+void ResetLogClock()
+{
+    detail::sLogClockMs.store(0, std::memory_order_relaxed);
+}
+
+void detail::RegisterRateLimitSite(RateLimitSite& site)
+{
+    if (site.registered.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    RateLimitSite* head = sRateLimitSites.load(std::memory_order_relaxed);
+    do {
+        site.next = head;
+    } while (!sRateLimitSites.compare_exchange_weak(head, &site, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void AddSink(LogSinkPtr sink)
+{
+    if (!sink) {
+        return;
+    }
+    SinkRegistry&               registry = Sinks();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.sinks.push_back(std::move(sink));
+}
+
+void RemoveSink(LogSinkPtr const& sink)
+{
+    SinkRegistry&               registry = Sinks();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto&                       sinks = registry.sinks;
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+}
+
+void ClearSinks()
+{
+    SinkRegistry&               registry = Sinks();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.sinks.clear();
+}
+
+void FlushSinks()
+{
+    SinkRegistry&               registry = Sinks();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto const& sink : registry.sinks) {
+        sink->Flush();
+    }
 }
 
-}  // namespace physika::core::logger
\ No newline at end of file
+}  // namespace physika::core::logger
@@ -0,0 +1,226 @@
+#include "core/mapped-file.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace physika::core {
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::IsOpen() const
+{
+    return mData != nullptr;
+}
+
+uint8_t* MappedFile::Data()
+{
+    return mData;
+}
+
+uint8_t const* MappedFile::Data() const
+{
+    return mData;
+}
+
+size_t MappedFile::Size() const
+{
+    return mSize;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Create(char const* path, size_t size)
+{
+    Close();
+    if (!path || size == 0) {
+        return false;
+    }
+
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    ULARGE_INTEGER mappingSize;
+    mappingSize.QuadPart = size;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, mappingSize.HighPart, mappingSize.LowPart, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle    = file;
+    mMappingHandle = mapping;
+    mData          = static_cast<uint8_t*>(data);
+    mSize          = size;
+    mWritable      = true;
+    return true;
+}
+
+bool MappedFile::OpenReadOnly(char const* path)
+{
+    Close();
+    if (!path) {
+        return false;
+    }
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle    = file;
+    mMappingHandle = mapping;
+    mData          = static_cast<uint8_t*>(data);
+    mSize          = static_cast<size_t>(fileSize.QuadPart);
+    mWritable      = false;
+    return true;
+}
+
+void MappedFile::Close(size_t finalSize)
+{
+    if (!mData) {
+        return;
+    }
+    if (mWritable) {
+        FlushViewOfFile(mData, 0);
+    }
+    UnmapViewOfFile(mData);
+    CloseHandle(mMappingHandle);
+
+    if (mWritable && finalSize < mSize) {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(finalSize);
+        SetFilePointerEx(mFileHandle, end, nullptr, FILE_BEGIN);
+        SetEndOfFile(mFileHandle);
+    }
+    CloseHandle(mFileHandle);
+
+    mFileHandle    = nullptr;
+    mMappingHandle = nullptr;
+    mData          = nullptr;
+    mSize          = 0;
+    mWritable      = false;
+}
+
+#else
+
+bool MappedFile::Create(char const* path, size_t size)
+{
+    Close();
+    if (!path || size == 0) {
+        return false;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    mFileDescriptor = fd;
+    mData           = static_cast<uint8_t*>(data);
+    mSize           = size;
+    mWritable       = true;
+    return true;
+}
+
+bool MappedFile::OpenReadOnly(char const* path)
+{
+    Close();
+    if (!path) {
+        return false;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat fileStats;
+    if (fstat(fd, &fileStats) != 0 || fileStats.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t const size = static_cast<size_t>(fileStats.st_size);
+    void*        data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    mFileDescriptor = fd;
+    mData           = static_cast<uint8_t*>(data);
+    mSize           = size;
+    mWritable       = false;
+    return true;
+}
+
+void MappedFile::Close(size_t finalSize)
+{
+    if (!mData) {
+        return;
+    }
+    munmap(mData, mSize);
+
+    if (mWritable && finalSize < mSize) {
+        (void)ftruncate(mFileDescriptor, static_cast<off_t>(finalSize));
+    }
+    close(mFileDescriptor);
+
+    mFileDescriptor = -1;
+    mData           = nullptr;
+    mSize           = 0;
+    mWritable       = false;
+}
+
+#endif
+
+}  // namespace physika::core
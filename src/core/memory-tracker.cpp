@@ -0,0 +1,110 @@
+#include "core/memory-tracker.h"
+
+#include <atomic>
+
+#include "core/logger.h"
+#include "core/timer.h"
+
+namespace physika::core::memory {
+
+namespace {
+
+size_t const kTagCount = static_cast<size_t>(MemoryTag::kCount);
+
+char const* const kTagNames[kTagCount] = { "general", "mesh", "material", "logging", "frame", "staging" };
+
+//! One cache line per tag so threads working on different subsystems do not contend.
+struct alignas(64) TagCounters
+{
+    std::atomic<uint64_t> liveBytes{ 0 };
+    std::atomic<uint64_t> peakBytes{ 0 };
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+    std::atomic<uint64_t> totalBytes{ 0 };
+};
+
+TagCounters sCounters[kTagCount];
+
+struct TrackingClock
+{
+    TimerBackend backend;
+    int64_t      startTicks;
+};
+
+//! Rates are measured from the first tracked allocation.
+TrackingClock const& Clock()
+{
+    static TrackingClock const clock = [] {
+        TimerBackend const backend = ResolveTimerBackend(TimerBackend::kDefault);
+        return TrackingClock{ backend, ReadTicks(backend) };
+    }();
+    return clock;
+}
+
+}  // namespace
+
+char const* TagName(MemoryTag tag)
+{
+    size_t const index = static_cast<size_t>(tag);
+    return index < kTagCount ? kTagNames[index] : "unknown";
+}
+
+#if PHYSIKA_MEMORY_TRACKING_ENABLED
+void TrackAllocation(MemoryTag tag, size_t bytes)
+{
+    Clock();
+    TagCounters&   counters = sCounters[static_cast<size_t>(tag)];
+    uint64_t const live     = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void TrackFree(MemoryTag tag, size_t bytes)
+{
+    TagCounters& counters = sCounters[static_cast<size_t>(tag)];
+    counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.frees.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+TagStats Stats(MemoryTag tag)
+{
+    TagCounters const& counters = sCounters[static_cast<size_t>(tag)];
+
+    TagStats stats;
+    stats.name        = TagName(tag);
+    stats.liveBytes   = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes   = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.frees       = counters.frees.load(std::memory_order_relaxed);
+    stats.totalBytes  = counters.totalBytes.load(std::memory_order_relaxed);
+
+    TrackingClock const& clock   = Clock();
+    double const         seconds = static_cast<double>(ReadTicks(clock.backend) - clock.startTicks) /
+                           static_cast<double>(TicksPerSecond(clock.backend));
+    if (seconds > 0.0) {
+        stats.allocationsPerSecond = static_cast<double>(stats.allocations) / seconds;
+        stats.bytesPerSecond       = static_cast<double>(stats.totalBytes) / seconds;
+    }
+    return stats;
+}
+
+void LogStats(char const* label)
+{
+    for (size_t ii = 0; ii < kTagCount; ++ii) {
+        TagStats const stats = Stats(static_cast<MemoryTag>(ii));
+        if (stats.allocations == 0) {
+            continue;
+        }
+        logger::LOG_INFO("%s memory [%s]: live %.1f KiB, peak %.1f KiB, %llu allocations (%.1f/s, %.1f KiB/s)", label,
+                         stats.name, stats.liveBytes / 1024.0, stats.peakBytes / 1024.0,
+                         static_cast<unsigned long long>(stats.allocations), stats.allocationsPerSecond,
+                         stats.bytesPerSecond / 1024.0);
+    }
+}
+
+}  // namespace physika::core::memory
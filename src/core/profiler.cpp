@@ -0,0 +1,301 @@
+#include "core/profiler.h"
+
+#include <stdio.h>
+
+#include <algorithm>  // sort, remove_if
+#include <atomic>
+#include <memory>  // shared_ptr
+#include <mutex>
+#include <string>
+
+#include "core/spsc-queue.h"
+#include "core/timer.h"
+
+namespace {
+
+using namespace physika::core;
+using namespace physika::core::profiler;
+
+//! Scopes a thread can record between two EndFrame calls.
+size_t const kScopesPerThread = 16384;
+
+struct ScopeEvent
+{
+    char const* name;
+    int64_t     begin;
+    int64_t     end;
+    uint32_t    depth;
+};
+
+struct ThreadBuffer
+{
+    ThreadBuffer() : events(kScopesPerThread)
+    {
+    }
+
+    SpscQueue<ScopeEvent> events;
+    std::atomic<uint64_t> dropped{ 0 };
+    //! Set when the owning thread exits. Released once drained.
+    std::atomic<bool> orphaned{ false };
+    uint32_t          index = 0;
+};
+
+using ThreadBufferPtr = std::shared_ptr<ThreadBuffer>;
+
+struct CapturedEvent
+{
+    ScopeEvent event;
+    uint32_t   thread;
+};
+
+struct Registry
+{
+    std::mutex                   mutex;
+    std::vector<ThreadBufferPtr> buffers;
+    uint32_t                     nextIndex = 0;
+    //! Names of every thread seen, kept for traces after threads exit.
+    std::vector<std::string> threadNames;
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+//! Only touched by the thread calling EndFrame and the capture functions.
+FrameProfile               sFrame;
+std::vector<ScopeEvent>    sScratch;
+std::vector<uint32_t>      sStack;
+int64_t                    sLastFrameEnd = 0;
+bool                       sCapturing    = false;
+int64_t                    sCaptureStart = 0;
+std::vector<CapturedEvent> sCapture;
+
+struct ThreadHandle
+{
+    ~ThreadHandle()
+    {
+        if (buffer) {
+            buffer->orphaned.store(true, std::memory_order_release);
+        }
+    }
+
+    ThreadBufferPtr buffer;
+};
+
+ThreadBuffer& AcquireThreadBuffer()
+{
+    thread_local ThreadHandle handle;
+    if (!handle.buffer) {
+        handle.buffer = std::make_shared<ThreadBuffer>();
+
+        Registry&                   registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        handle.buffer->index = registry.nextIndex++;
+        registry.threadNames.push_back("Thread " + std::to_string(handle.buffer->index));
+        registry.buffers.push_back(handle.buffer);
+    }
+    return *handle.buffer;
+}
+
+TimerBackend ProfilerClock()
+{
+    //! The invariant TSC is the cheapest clock to read where available.
+    static TimerBackend const sBackend = ResolveTimerBackend(TimerBackend::kInvariantTsc);
+    return sBackend;
+}
+
+double TicksToMs(int64_t ticks)
+{
+    static double const sMsPerTick = 1000.0 / static_cast<double>(TicksPerSecond(ProfilerClock()));
+    return static_cast<double>(ticks) * sMsPerTick;
+}
+
+uint32_t FindOrAddNode(char const* name, uint32_t parent, uint32_t depth, uint32_t thread, size_t firstNode)
+{
+    auto& nodes = sFrame.nodes;
+    for (size_t ii = firstNode; ii < nodes.size(); ++ii) {
+        if (nodes[ii].parent == parent && nodes[ii].name == name) {
+            return static_cast<uint32_t>(ii);
+        }
+    }
+    nodes.push_back({ name, parent, depth, thread, 0, 0.0, 0.0 });
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+//! Builds the scope tree of one thread from its events.
+void AggregateThread(uint32_t thread)
+{
+    //! Events arrive in completion order; sort them into call order so
+    //! every parent is visited before its children.
+    std::sort(sScratch.begin(), sScratch.end(), [](ScopeEvent const& lhs, ScopeEvent const& rhs) {
+        return lhs.begin != rhs.begin ? lhs.begin < rhs.begin : lhs.depth < rhs.depth;
+    });
+
+    size_t const firstNode = sFrame.nodes.size();
+    sStack.clear();
+    for (auto const& event : sScratch) {
+        while (sStack.size() > event.depth) {
+            sStack.pop_back();
+        }
+        uint32_t const parent = sStack.empty() ? kNoParent : sStack.back();
+        uint32_t const depth  = static_cast<uint32_t>(sStack.size());
+        uint32_t const node   = FindOrAddNode(event.name, parent, depth, thread, firstNode);
+        sFrame.nodes[node].calls += 1;
+        sFrame.nodes[node].totalMs += TicksToMs(event.end - event.begin);
+        sStack.push_back(node);
+    }
+}
+
+void WriteEscaped(FILE* file, char const* text)
+{
+    for (char const* cc = text; *cc; ++cc) {
+        if (*cc == '"' || *cc == '\\') {
+            fputc('\\', file);
+        }
+        if (static_cast<unsigned char>(*cc) >= 0x20) {
+            fputc(*cc, file);
+        }
+    }
+}
+
+}  // namespace
+
+namespace physika::core::profiler {
+
+int64_t detail::Now()
+{
+    return ReadTicks(ProfilerClock());
+}
+
+void detail::RecordScope(char const* name, int64_t begin, int64_t end, uint32_t depth)
+{
+    ThreadBuffer& buffer = AcquireThreadBuffer();
+    ScopeEvent*   event  = buffer.events.BeginPush();
+    if (!event) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    event->name  = name;
+    event->begin = begin;
+    event->end   = end;
+    event->depth = depth;
+    buffer.events.EndPush();
+}
+
+void SetThreadName(char const* name)
+{
+    if (!name) {
+        return;
+    }
+    ThreadBuffer&               buffer   = AcquireThreadBuffer();
+    Registry&                   registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threadNames[buffer.index] = name;
+}
+
+void EndFrame()
+{
+    int64_t const now = detail::Now();
+    sFrame.frameIndex += 1;
+    sFrame.frameMs       = sLastFrameEnd != 0 ? TicksToMs(now - sLastFrameEnd) : 0.0;
+    sFrame.droppedScopes = 0;
+    sFrame.nodes.clear();
+    sLastFrameEnd = now;
+
+    Registry&                   registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers) {
+        sScratch.clear();
+        while (ScopeEvent const* event = buffer->events.Front()) {
+            sScratch.push_back(*event);
+            buffer->events.Pop();
+        }
+        sFrame.droppedScopes += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (sCapturing) {
+            for (auto const& event : sScratch) {
+                sCapture.push_back({ event, buffer->index });
+            }
+        }
+        AggregateThread(buffer->index);
+    }
+
+    //! Self time is whatever the children did not account for.
+    for (auto& node : sFrame.nodes) {
+        node.selfMs = node.totalMs;
+    }
+    for (auto const& node : sFrame.nodes) {
+        if (node.parent != kNoParent) {
+            sFrame.nodes[node.parent].selfMs -= node.totalMs;
+        }
+    }
+
+    auto& buffers = registry.buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](ThreadBufferPtr const& buffer) {
+                                     return buffer->orphaned.load(std::memory_order_acquire) &&
+                                            buffer->events.Empty();
+                                 }),
+                  buffers.end());
+}
+
+FrameProfile const& LastFrame()
+{
+    return sFrame;
+}
+
+void StartCapture()
+{
+    sCapture.clear();
+    sCaptureStart = detail::Now();
+    sCapturing    = true;
+}
+
+bool IsCapturing()
+{
+    return sCapturing;
+}
+
+bool StopCapture(char const* path)
+{
+    if (!sCapturing) {
+        return false;
+    }
+    sCapturing = false;
+
+    FILE* file = path ? fopen(path, "w") : nullptr;
+    if (!file) {
+        sCapture.clear();
+        return false;
+    }
+
+    double const usPerTick = 1000.0 * TicksToMs(1);
+    char const*  separator = "";
+    fprintf(file, "{\"traceEvents\":[");
+    {
+        Registry&                   registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (size_t ii = 0; ii < registry.threadNames.size(); ++ii) {
+            fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"",
+                    separator, ii);
+            WriteEscaped(file, registry.threadNames[ii].c_str());
+            fprintf(file, "\"}}");
+            separator = ",";
+        }
+    }
+    for (auto const& captured : sCapture) {
+        fprintf(file, "%s\n{\"name\":\"", separator);
+        WriteEscaped(file, captured.event.name);
+        fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", captured.thread,
+                static_cast<double>(captured.event.begin - sCaptureStart) * usPerTick,
+                static_cast<double>(captured.event.end - captured.event.begin) * usPerTick);
+        separator = ",";
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    sCapture.clear();
+    sCapture.shrink_to_fit();
+    return fclose(file) == 0;
+}
+
+}  // namespace physika::core::profiler
@@ -0,0 +1,58 @@
+#include "core/string-id.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/logger.h"
+
+namespace physika::core {
+
+namespace {
+
+#if PHYSIKA_STRING_ID_NAMES
+struct InternTable
+{
+    std::mutex                                lock;
+    std::unordered_map<uint64_t, std::string> names;
+};
+
+InternTable& Interned()
+{
+    static InternTable table;
+    return table;
+}
+#endif
+
+}  // namespace
+
+StringId::StringId(std::string_view text) : mHash{ Fnv1a64(text.data(), text.size()) }
+{
+#if PHYSIKA_STRING_ID_NAMES
+    InternTable&                table = Interned();
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto const [entry, inserted] = table.names.try_emplace(mHash, text);
+    if (!inserted && entry->second != text) {
+        logger::LOG_ERROR("StringId collision: '%s' and '%.*s' both hash to %016llx", entry->second.c_str(),
+                          static_cast<int>(text.size()), text.data(), static_cast<unsigned long long>(mHash));
+    }
+#endif
+}
+
+char const* StringId::Name() const
+{
+#if PHYSIKA_STRING_ID_NAMES
+    InternTable&                table = Interned();
+    std::lock_guard<std::mutex> lock(table.lock);
+
+    auto const entry = table.names.find(mHash);
+    if (entry != table.names.end()) {
+        //! Entries are never removed, so the text stays put.
+        return entry->second.c_str();
+    }
+#endif
+    return "<unnamed>";
+}
+
+}  // namespace physika::core
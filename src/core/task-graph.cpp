@@ -0,0 +1,210 @@
+#include "core/task-graph.h"
+
+#include <assert.h>
+
+#include <algorithm>  // find
+
+#include "core/logger.h"
+#include "core/profiler.h"
+
+namespace physika::core {
+
+namespace {
+
+void AddDependency(std::vector<TaskGraph::TaskId>& dependencies, TaskGraph::TaskId task)
+{
+    if (std::find(dependencies.begin(), dependencies.end(), task) == dependencies.end()) {
+        dependencies.push_back(task);
+    }
+}
+
+}  // namespace
+
+TaskGraph::TaskGraph(JobSystem& jobs)
+    : mJobs(jobs),
+      mCompiled{ false },
+      mFrameCounter{ nullptr },
+      mBackend{ ResolveTimerBackend(TimerBackend::kDefault) },
+      mMsPerTick{ 1000.0 / static_cast<double>(TicksPerSecond(mBackend)) }
+{
+}
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::ResourceId TaskGraph::AddResource(char const* name)
+{
+    mResources.push_back(name);
+    return static_cast<ResourceId>(mResources.size() - 1);
+}
+
+TaskGraph::TaskId TaskGraph::AddTask(char const* name, std::function<void()> function,
+                                     std::initializer_list<ResourceId> reads, std::initializer_list<ResourceId> writes)
+{
+    auto task      = std::make_unique<Task>();
+    task->name     = name;
+    task->function = std::move(function);
+    task->reads.assign(reads.begin(), reads.end());
+    task->writes.assign(writes.begin(), writes.end());
+#ifndef NDEBUG
+    for (ResourceId const resource : task->reads) {
+        assert(resource < mResources.size() && "Unknown resource");
+    }
+    for (ResourceId const resource : task->writes) {
+        assert(resource < mResources.size() && "Unknown resource");
+    }
+#endif
+    mTasks.push_back(std::move(task));
+    mCompiled = false;
+    return static_cast<TaskId>(mTasks.size() - 1);
+}
+
+void TaskGraph::Compile()
+{
+    size_t const                     resourceCount = mResources.size();
+    std::vector<int64_t>             lastWriter(resourceCount, -1);
+    std::vector<std::vector<TaskId>> readers(resourceCount);
+
+    mRoots.clear();
+    for (auto& task : mTasks) {
+        task->dependencies.clear();
+        task->dependents.clear();
+    }
+
+    for (TaskId id = 0; id < mTasks.size(); ++id) {
+        Task& task = *mTasks[id];
+        //! Read after write
+        for (ResourceId const resource : task.reads) {
+            if (lastWriter[resource] >= 0) {
+                AddDependency(task.dependencies, static_cast<TaskId>(lastWriter[resource]));
+            }
+        }
+        //! Write after write and write after read
+        for (ResourceId const resource : task.writes) {
+            if (lastWriter[resource] >= 0) {
+                AddDependency(task.dependencies, static_cast<TaskId>(lastWriter[resource]));
+            }
+            for (TaskId const reader : readers[resource]) {
+                if (reader != id) {
+                    AddDependency(task.dependencies, reader);
+                }
+            }
+        }
+        for (ResourceId const resource : task.reads) {
+            readers[resource].push_back(id);
+        }
+        for (ResourceId const resource : task.writes) {
+            lastWriter[resource] = id;
+            readers[resource].clear();
+        }
+
+        for (TaskId const dependency : task.dependencies) {
+            mTasks[dependency]->dependents.push_back(id);
+        }
+        if (task.dependencies.empty()) {
+            mRoots.push_back(id);
+        }
+    }
+    mCompiled = true;
+}
+
+void TaskGraph::RunTask(TaskId id)
+{
+    Task& task      = *mTasks[id];
+    task.startTicks = ReadTicks(mBackend);
+    {
+        PROFILE_SCOPE(task.name);
+        task.function();
+    }
+    task.endTicks = ReadTicks(mBackend);
+
+    for (TaskId const dependent : task.dependents) {
+        //! The last dependency to finish starts the dependent. It joins the
+        //! frame counter before this task leaves it, so Execute cannot return early.
+        if (mTasks[dependent]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            mJobs.Run([this, dependent]() { RunTask(dependent); }, mFrameCounter);
+        }
+    }
+}
+
+void TaskGraph::Execute()
+{
+    if (!mCompiled) {
+        Compile();
+    }
+    for (auto& task : mTasks) {
+        task->remaining.store(static_cast<uint32_t>(task->dependencies.size()), std::memory_order_relaxed);
+    }
+
+    JobCounter    counter;
+    int64_t const start = ReadTicks(mBackend);
+    mFrameCounter       = &counter;
+    for (TaskId const root : mRoots) {
+        mJobs.Run([this, root]() { RunTask(root); }, &counter);
+    }
+    mJobs.Wait(counter);
+    mFrameCounter = nullptr;
+    UpdateTimings(start, ReadTicks(mBackend));
+}
+
+void TaskGraph::UpdateTimings(int64_t frameStart, int64_t frameEnd)
+{
+    size_t const taskCount = mTasks.size();
+    mTimings.frameMs       = static_cast<double>(frameEnd - frameStart) * mMsPerTick;
+    mTimings.tasks.resize(taskCount);
+
+    //! Longest chain ending at each task. Declaration order is a topological order.
+    std::vector<double>  chainMs(taskCount, 0.0);
+    std::vector<int64_t> chainPrevious(taskCount, -1);
+    int64_t              chainEnd = -1;
+    for (TaskId id = 0; id < taskCount; ++id) {
+        Task const& task   = *mTasks[id];
+        TaskTiming& timing = mTimings.tasks[id];
+        timing.name        = task.name;
+        timing.startMs     = static_cast<double>(task.startTicks - frameStart) * mMsPerTick;
+        timing.durationMs  = static_cast<double>(task.endTicks - task.startTicks) * mMsPerTick;
+        timing.critical    = false;
+
+        for (TaskId const dependency : task.dependencies) {
+            if (chainPrevious[id] < 0 || chainMs[dependency] > chainMs[id]) {
+                chainMs[id]       = chainMs[dependency];
+                chainPrevious[id] = dependency;
+            }
+        }
+        chainMs[id] += timing.durationMs;
+        if (chainEnd < 0 || chainMs[id] > chainMs[chainEnd]) {
+            chainEnd = id;
+        }
+    }
+
+    mTimings.criticalPathMs = chainEnd >= 0 ? chainMs[chainEnd] : 0.0;
+    for (int64_t id = chainEnd; id >= 0; id = chainPrevious[id]) {
+        mTimings.tasks[id].critical = true;
+    }
+}
+
+std::vector<TaskGraph::TaskId> const& TaskGraph::Dependencies(TaskId task) const
+{
+    return mTasks[task]->dependencies;
+}
+
+uint32_t TaskGraph::TaskCount() const
+{
+    return static_cast<uint32_t>(mTasks.size());
+}
+
+TaskGraphTimings const& TaskGraph::LastTimings() const
+{
+    return mTimings;
+}
+
+void TaskGraph::LogTimings(char const* label) const
+{
+    logger::LOG_INFO("%s task graph: frame %.3f ms, critical path %.3f ms", label, mTimings.frameMs,
+                     mTimings.criticalPathMs);
+    for (TaskTiming const& timing : mTimings.tasks) {
+        logger::LOG_INFO("  %c %-24s start %8.3f ms  duration %8.3f ms", timing.critical ? '*' : ' ', timing.name,
+                         timing.startMs, timing.durationMs);
+    }
+}
+
+}  // namespace physika::core
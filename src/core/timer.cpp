@@ -1,32 +1,210 @@
 #include "core/timer.h"
 
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PHYSIKA_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#else
+#define PHYSIKA_HAS_TSC 0
+#endif
+
+namespace {
+
+using namespace physika::core;
+using SteadyClock = std::chrono::steady_clock;
+
+//! Long enough for a calibration error well below one part in 10^4.
+auto const kTscCalibrationTime = std::chrono::milliseconds(20);
+
+int64_t ReadSteadyClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now().time_since_epoch()).count();
+}
+
+#if PHYSIKA_HAS_TSC
+bool HasInvariantTsc()
+{
+    //! CPUID leaf 0x80000007, EDX bit 8.
+    unsigned int regs[4] = {};
+#ifdef _MSC_VER
+    __cpuid(reinterpret_cast<int*>(regs), 0x80000000);
+    if (regs[0] < 0x80000007) {
+        return false;
+    }
+    __cpuid(reinterpret_cast<int*>(regs), 0x80000007);
+#else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+    return (regs[3] & (1u << 8)) != 0;
+}
+
+int64_t CalibrateTsc()
+{
+    int64_t const startTsc   = static_cast<int64_t>(__rdtsc());
+    int64_t const startClock = ReadSteadyClock();
+    std::this_thread::sleep_for(kTscCalibrationTime);
+    int64_t const endTsc   = static_cast<int64_t>(__rdtsc());
+    int64_t const endClock = ReadSteadyClock();
+    return static_cast<int64_t>(static_cast<double>(endTsc - startTsc) * 1e9 / static_cast<double>(endClock - startClock));
+}
+#endif
+
+}  // namespace
+
 namespace physika::core {
 
-Timer::Timer() : mPreviousTime{ 0 }, mTotalRunningTime{ 0.0f }, mStopped{ true }
+bool IsTimerBackendAvailable(TimerBackend backend)
+{
+    switch (backend) {
+    case TimerBackend::kDefault:
+    case TimerBackend::kSteadyClock:
+        return true;
+    case TimerBackend::kQueryPerformanceCounter:
+#ifdef _WIN32
+        return true;
+#else
+        return false;
+#endif
+    case TimerBackend::kMonotonicRaw:
+#ifdef CLOCK_MONOTONIC_RAW
+        return true;
+#else
+        return false;
+#endif
+    case TimerBackend::kInvariantTsc: {
+#if PHYSIKA_HAS_TSC
+        static bool const sInvariant = HasInvariantTsc();
+        return sInvariant;
+#else
+        return false;
+#endif
+    }
+    default:
+        return false;
+    }
+}
+
+TimerBackend ResolveTimerBackend(TimerBackend backend)
 {
-    int64_t frequency;
-    QueryPerformanceCounter((LARGE_INTEGER*)&mPreviousTime);
-    QueryPerformanceFrequency((LARGE_INTEGER*)&frequency);  // 1/T
-    mSecondsPerCount = (float)1 / frequency;                // 1/F
+    if (backend != TimerBackend::kDefault && IsTimerBackendAvailable(backend)) {
+        return backend;
+    }
+#if defined(_WIN32)
+    return TimerBackend::kQueryPerformanceCounter;
+#elif defined(CLOCK_MONOTONIC_RAW)
+    return TimerBackend::kMonotonicRaw;
+#else
+    return TimerBackend::kSteadyClock;
+#endif
+}
+
+int64_t ReadTicks(TimerBackend backend)
+{
+    switch (backend) {
+#ifdef _WIN32
+    case TimerBackend::kQueryPerformanceCounter: {
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+    }
+#endif
+#ifdef CLOCK_MONOTONIC_RAW
+    case TimerBackend::kMonotonicRaw: {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+        return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+    }
+#endif
+#if PHYSIKA_HAS_TSC
+    case TimerBackend::kInvariantTsc:
+        return static_cast<int64_t>(__rdtsc());
+#endif
+    default:
+        return ReadSteadyClock();
+    }
+}
+
+int64_t TicksPerSecond(TimerBackend backend)
+{
+    switch (backend) {
+#ifdef _WIN32
+    case TimerBackend::kQueryPerformanceCounter: {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return frequency.QuadPart;
+    }
+#endif
+#if PHYSIKA_HAS_TSC
+    case TimerBackend::kInvariantTsc: {
+        static int64_t const sFrequency = CalibrateTsc();
+        return sFrequency;
+    }
+#endif
+    default:
+        //! CLOCK_MONOTONIC_RAW and steady_clock are read in nanoseconds.
+        return 1000000000;
+    }
+}
+
+Timer::Timer(TimerBackend backend)
+    : mStopped{ true },
+      mBackend{ ResolveTimerBackend(backend) },
+      mDeltaTicks{ 0 },
+      mTotalTicks{ 0 }
+{
+    mTicksPerSecond = TicksPerSecond(mBackend);
+    mSecondsPerTick = 1.0 / static_cast<double>(mTicksPerSecond);
+    mPreviousTime   = ReadTicks(mBackend);
 }
 
 float Timer::TotalRunningTime()
 {
-    return mTotalRunningTime;
+    return static_cast<float>(TotalRunningTimeSeconds());
+}
+
+double Timer::TotalRunningTimeSeconds() const
+{
+    //! Split whole seconds off first so the remainder converts exactly.
+    int64_t const seconds = mTotalTicks / mTicksPerSecond;
+    int64_t const rest    = mTotalTicks % mTicksPerSecond;
+    return static_cast<double>(seconds) + static_cast<double>(rest) * mSecondsPerTick;
 }
 
 float Timer::Delta()
 {
-    return mDelta;
+    return static_cast<float>(DeltaSeconds());
+}
+
+double Timer::DeltaSeconds() const
+{
+    return static_cast<double>(mDeltaTicks) * mSecondsPerTick;
+}
+
+TimerBackend Timer::Backend() const
+{
+    return mBackend;
 }
 
 void Timer::Start()
 {
     if (mStopped) {
-        int64_t currentTime;
-        QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
-        mPreviousTime = currentTime;
+        mPreviousTime = ReadTicks(mBackend);
         mStopped      = false;
     }
 }
@@ -37,8 +215,6 @@ void Timer::Stop()
         return;
     }
     mStopped = true;
-    int64_t currentTime;
-    QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
 }
 
 void Timer::Reset()
@@ -46,26 +222,22 @@ void Timer::Reset()
     if (!mStopped) {
         return;
     }
-    mTotalRunningTime = 0.0f;
-    mDelta            = 0.0f;
-    mPreviousTime     = 0;
+    mTotalTicks   = 0;
+    mDeltaTicks   = 0;
+    mPreviousTime = 0;
 }
 
 void Timer::Tick()
 {
     if (mStopped) {
-        mDelta = 0.0f;
+        mDeltaTicks = 0;
         return;
     }
-    int64_t currentTime;
-    QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
-
-    int64_t delta = 0;
-    delta         = currentTime - mPreviousTime;
+    int64_t const currentTime = ReadTicks(mBackend);
 
-    mDelta = (float)(delta)*mSecondsPerCount;
-    mTotalRunningTime += mDelta;
+    mDeltaTicks = currentTime - mPreviousTime;
+    mTotalTicks += mDeltaTicks;
     mPreviousTime = currentTime;
 }
 
-}  // namespace physika::core
\ No newline at end of file
+}  // namespace physika::core
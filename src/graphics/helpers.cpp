@@ -22,7 +22,7 @@ char const* HRErrorDescription(HRESULT hr)
 void ThrowIfFailed(HRESULT hr)
 {
     if (FAILED(hr)) {
-        core::logger::LOG_ERROR("%s", HRErrorDescription(hr));
+        PHI_LOG_ERROR(kGraphics, "%s", HRErrorDescription(hr));
         throw std::exception();
     }
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <d3d12.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace physika::renderer {
+
+//! Vertices a 16-bit index can address from its base vertex.
+constexpr size_t kMaxIndex16Vertices = size_t(UINT16_MAX) + 1;
+
+/**
+ * @brief R16_UINT when every vertex is reachable with 16 bits, R32_UINT otherwise.
+ */
+constexpr DXGI_FORMAT IndexFormatForVertexCount(size_t vertexCount)
+{
+    return vertexCount <= kMaxIndex16Vertices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+}
+
+constexpr size_t IndexFormatSize(DXGI_FORMAT format)
+{
+    return format == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+/**
+ * @brief Copy count indices to destination in format, subtracting rebase
+ *        from each. The rebased indices must fit the format.
+ */
+void WriteIndices(uint32_t const* indices, size_t count, DXGI_FORMAT format, void* destination, uint32_t rebase = 0);
+
+//! vertexStartLocation is the base vertex the submesh's indices are relative to.
+struct Submesh
+{
+    uint32_t indexCount          = 0;
+    uint32_t vertexStartLocation = 0;
+    uint32_t indexStartLocation  = 0;
+};
+
+/**
+ * @brief Merges the index lists of several submeshes into one buffer.
+ *
+ * Each submesh is rebased to the lowest vertex it uses, which becomes its
+ * base vertex for DrawIndexedInstanced. The buffer is 16-bit as long as
+ * every submesh spans at most 65536 vertices, however large the merged
+ * vertex buffer is.
+ */
+class IndexBufferBuilder
+{
+public:
+    /**
+     * @brief Append a submesh whose indices address vertices from
+     *        vertexOffset in the merged vertex buffer.
+     */
+    Submesh Add(uint32_t const* indices, size_t count, uint32_t vertexOffset);
+
+    template <typename Container>
+    Submesh Add(Container const& indices, uint32_t vertexOffset)
+    {
+        return Add(indices.data(), indices.size(), vertexOffset);
+    }
+
+    DXGI_FORMAT Format() const;
+    size_t      IndexCount() const;
+    size_t      ByteSize() const;
+
+    //! destination holds ByteSize() bytes.
+    void Write(void* destination) const;
+
+private:
+    std::vector<uint32_t> mIndices;  //!< rebased to each submesh's base vertex
+    bool                  mNeeds32Bit = false;
+};
+
+}  // namespace physika::renderer
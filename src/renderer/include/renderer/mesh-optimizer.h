@@ -0,0 +1,173 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace physika::renderer {
+
+/*
+    Index and vertex reordering for indexed triangle lists. The functions work
+    on raw 32-bit index lists and strided float3 positions so any mesh layout
+    can use them; the templates take any MeshData flavour with `indices`,
+    VertexCount() and, where positions are needed, PositionAt()/PositionStride().
+
+    OptimizeMesh runs the passes in the order they depend on each other:
+    vertex cache, then overdraw (which keeps most of the cache order), then
+    vertex fetch (which only renames vertices).
+*/
+
+//! Post-transform cache entries assumed when measuring; a typical FIFO depth.
+constexpr uint32_t kDefaultVertexCacheSize = 16;
+
+//! How much worse than its hard cluster a soft cluster's ACMR may be.
+constexpr float kDefaultOverdrawThreshold = 1.05f;
+
+struct VertexCacheStats
+{
+    size_t transformedVertices = 0;     //!< cache misses, i.e. vertex shader invocations
+    float  acmr                = 0.0f;  //!< transformed vertices per triangle; 0.5 is ideal for a grid, 3 the worst
+    float  atvr                = 0.0f;  //!< transformed vertices per vertex; 1 is ideal
+};
+
+struct VertexFetchStats
+{
+    size_t bytesFetched = 0;     //!< in 64-byte cache lines
+    float  overfetch    = 0.0f;  //!< bytes fetched per vertex buffer byte; 1 is ideal
+};
+
+struct OverdrawStats
+{
+    size_t coveredPixels = 0;
+    size_t shadedPixels  = 0;
+    float  overdraw      = 0.0f;  //!< shaded per covered pixel; 1 is ideal
+};
+
+struct MeshOptimizationStats
+{
+    VertexCacheStats vertexCache;
+    VertexFetchStats vertexFetch;
+    OverdrawStats    overdraw;
+};
+
+struct MeshOptimizationReport
+{
+    MeshOptimizationStats before;
+    MeshOptimizationStats after;
+};
+
+/**
+ * @brief Simulate a FIFO post-transform cache of cacheSize entries.
+ */
+VertexCacheStats AnalyzeVertexCache(uint32_t const* indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize = kDefaultVertexCacheSize);
+
+/**
+ * @brief Simulate the memory traffic of fetching vertexStride-byte vertices
+ *        on every post-transform cache miss through a small cache of lines.
+ */
+VertexFetchStats AnalyzeVertexFetch(uint32_t const* indices, size_t indexCount, size_t vertexCount, size_t vertexStride);
+
+/**
+ * @brief Rasterize the mesh in draw order from the six axis directions with
+ *        depth testing and back-face culling, and count shaded pixels.
+ */
+OverdrawStats AnalyzeOverdraw(uint32_t const* indices, size_t indexCount, float const* positions, size_t vertexCount,
+                              size_t positionStride);
+
+/**
+ * @brief Reorder triangles for post-transform cache reuse with Forsyth's
+ *        linear-speed algorithm. destination may alias indices.
+ */
+void OptimizeVertexCache(uint32_t* destination, uint32_t const* indices, size_t indexCount, size_t vertexCount);
+
+/**
+ * @brief Split cache-optimized indices into clusters and draw the clusters
+ *        facing away from the mesh center first, so they occlude the inner
+ *        ones. Clusters break where the cache order already restarts, or
+ *        where the ACMR so far is within threshold of the cluster's, which
+ *        keeps most of the cache efficiency. destination may alias indices.
+ */
+void OptimizeOverdraw(uint32_t* destination, uint32_t const* indices, size_t indexCount, float const* positions,
+                      size_t vertexCount, size_t positionStride, float threshold = kDefaultOverdrawThreshold);
+
+/**
+ * @brief Number vertices in the order the indices first use them; unused
+ *        vertices follow in their old order. remap[old] is the new index.
+ */
+void BuildVertexFetchRemap(uint32_t* remap, uint32_t const* indices, size_t indexCount, size_t vertexCount);
+
+//! destination may alias indices.
+void RemapIndices(uint32_t* destination, uint32_t const* indices, size_t indexCount, uint32_t const* remap);
+
+void LogMeshOptimizationReport(char const* meshName, MeshOptimizationReport const& report);
+
+template <typename Mesh>
+VertexCacheStats AnalyzeVertexCache(Mesh const& mesh, uint32_t cacheSize = kDefaultVertexCacheSize)
+{
+    return AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.VertexCount(), cacheSize);
+}
+
+template <typename Mesh>
+void OptimizeVertexCache(Mesh& mesh)
+{
+    OptimizeVertexCache(mesh.indices.data(), mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+}
+
+template <typename Mesh>
+void OptimizeOverdraw(Mesh& mesh, float threshold = kDefaultOverdrawThreshold)
+{
+    if (mesh.VertexCount() == 0) {
+        return;
+    }
+    OptimizeOverdraw(mesh.indices.data(), mesh.indices.data(), mesh.indices.size(), &mesh.PositionAt(0).x,
+                     mesh.VertexCount(), Mesh::PositionStride(), threshold);
+}
+
+template <typename Mesh>
+void OptimizeVertexFetch(Mesh& mesh)
+{
+    std::vector<uint32_t> remap(mesh.VertexCount());
+    BuildVertexFetchRemap(remap.data(), mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+    RemapIndices(mesh.indices.data(), mesh.indices.data(), mesh.indices.size(), remap.data());
+    mesh.RemapVertices(remap.data());
+}
+
+/**
+ * @brief The metrics an asset pipeline gates on. Split meshes are measured
+ *        as if their streams were interleaved.
+ */
+template <typename Mesh>
+MeshOptimizationStats AnalyzeMesh(Mesh const& mesh)
+{
+    MeshOptimizationStats stats;
+    if (mesh.VertexCount() == 0) {
+        return stats;
+    }
+    size_t const vertexStride = mesh.VertexBufferSize() / mesh.VertexCount();
+
+    stats.vertexCache = AnalyzeVertexCache(mesh);
+    stats.vertexFetch = AnalyzeVertexFetch(mesh.indices.data(), mesh.indices.size(), mesh.VertexCount(), vertexStride);
+    stats.overdraw    = AnalyzeOverdraw(mesh.indices.data(), mesh.indices.size(), &mesh.PositionAt(0).x, mesh.VertexCount(),
+                                        Mesh::PositionStride());
+    return stats;
+}
+
+/**
+ * @brief Run the vertex cache, overdraw and vertex fetch passes and measure
+ *        the mesh before and after.
+ */
+template <typename Mesh>
+MeshOptimizationReport OptimizeMesh(Mesh& mesh, float overdrawThreshold = kDefaultOverdrawThreshold)
+{
+    MeshOptimizationReport report;
+    report.before = AnalyzeMesh(mesh);
+    OptimizeVertexCache(mesh);
+    OptimizeOverdraw(mesh, overdrawThreshold);
+    OptimizeVertexFetch(mesh);
+    report.after = AnalyzeMesh(mesh);
+    return report;
+}
+
+}  // namespace physika::renderer
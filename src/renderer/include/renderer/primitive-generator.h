@@ -3,10 +3,20 @@
 
 namespace physika::renderer {
 
-MeshData CreateEquilateralTriangle(float const side);
+/*
+    Generators write the layout of the requested mesh type directly.
+    Instantiated for MeshData, BasicMeshData<PositionVertex>,
+    BasicMeshData<PositionNormalVertex>, BasicMeshData<PositionNormalColorVertex>
+    and SplitMeshData<ShadingAttributes>.
+*/
 
-MeshData CreateCube(float const side);
+template <typename Mesh = MeshData>
+Mesh CreateEquilateralTriangle(float const side);
 
-MeshData CreateUniformGrid(int side, int cellSize);
+template <typename Mesh = MeshData>
+Mesh CreateCube(float const side);
 
-}  // namespace physika::renderer
\ No newline at end of file
+template <typename Mesh = MeshData>
+Mesh CreateUniformGrid(int side, int cellSize);
+
+}  // namespace physika::renderer
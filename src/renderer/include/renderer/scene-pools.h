@@ -0,0 +1,14 @@
+#pragma once
+
+#include "core/slot-map.h"
+#include "renderer/types.h"
+
+namespace physika::renderer {
+
+//! Scene meshes and materials live densely in slot maps and are referred to by handle.
+using MeshHandle     = core::Handle<Mesh>;
+using MaterialHandle = core::Handle<Material>;
+using MeshPool       = core::SlotMap<Mesh>;
+using MaterialPool   = core::SlotMap<Material>;
+
+}  // namespace physika::renderer
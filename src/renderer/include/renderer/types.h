@@ -4,10 +4,14 @@
 #include <inttypes.h>
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "core/flat-map.h"
+#include "core/memory-tracker.h"
+#include "core/string-id.h"
 #include "graphics/types.h"
+#include "renderer/index-buffer.h"
+#include "renderer/vertex-layout.h"
 
 namespace physika::renderer {
 
@@ -27,19 +31,44 @@ struct VertexData
     DirectX::XMFLOAT4 color;
 };
 
-struct MeshData
+/**
+ * @brief CPU geometry with interleaved vertices of layout Vertex.
+ */
+template <typename Vertex>
+struct BasicMeshData
 {
-    std::vector<VertexData> vertices;
-    std::vector<uint32_t>   indices;
+    using VertexType = Vertex;
+
+    static constexpr bool kHasNormals = VertexLayoutTraits<Vertex>::kNormal;
+
+    //! CPU-side geometry is accounted to the mesh memory tag.
+    core::memory::TrackedVector<Vertex, core::memory::MemoryTag::kMesh>   vertices;
+    core::memory::TrackedVector<uint32_t, core::memory::MemoryTag::kMesh> indices;
 
     constexpr static size_t PerVertexDataSize()
     {
-        return sizeof(VertexData);
+        return sizeof(Vertex);
+    }
+
+    constexpr static size_t PositionStride()
+    {
+        return sizeof(Vertex);
+    }
+
+    //! 16-bit whenever the vertex count allows; indices stay 32-bit on the CPU.
+    DXGI_FORMAT IndexFormat() const
+    {
+        return IndexFormatForVertexCount(VertexCount());
+    }
+
+    size_t IndexDataSize() const
+    {
+        return IndexFormatSize(IndexFormat());
     }
 
-    constexpr static size_t IndexDataSize()
+    size_t VertexCount() const
     {
-        return sizeof(uint32_t);
+        return vertices.size();
     }
 
     size_t VertexBufferSize() const
@@ -51,19 +80,163 @@ struct MeshData
     {
         return indices.size() * IndexDataSize();
     }
+
+    //! destination holds IndexBufferSize() bytes.
+    void WriteIndices(void* destination) const
+    {
+        renderer::WriteIndices(indices.data(), indices.size(), IndexFormat(), destination);
+    }
+
+    void ReserveVertices(size_t count)
+    {
+        vertices.reserve(count);
+    }
+
+    uint32_t AddVertex(DirectX::XMFLOAT3 const& position, DirectX::XMFLOAT3 const& normal, DirectX::XMFLOAT3 const& tangent,
+                       DirectX::XMFLOAT2 const& texcoord, DirectX::XMFLOAT4 const& color)
+    {
+        Vertex vertex{};
+        SetVertexAttributes(vertex, position, normal, tangent, texcoord, color);
+        vertices.push_back(vertex);
+        return static_cast<uint32_t>(vertices.size() - 1);
+    }
+
+    DirectX::XMFLOAT3 const& PositionAt(size_t index) const
+    {
+        return vertices[index].position;
+    }
+
+    DirectX::XMFLOAT3& NormalAt(size_t index)
+    {
+        return vertices[index].normal;
+    }
+
+    //! Move vertex ii to remap[ii]; remap is a permutation of the vertices.
+    void RemapVertices(uint32_t const* remap)
+    {
+        decltype(vertices) remapped(vertices.size());
+        for (size_t ii = 0; ii < vertices.size(); ++ii) {
+            remapped[remap[ii]] = vertices[ii];
+        }
+        vertices.swap(remapped);
+    }
 };
 
-struct Submesh
+/**
+ * @brief CPU geometry with positions and the remaining attributes in two
+ *        streams. Depth-only passes bind just the 12-byte position stream.
+ */
+template <typename Attributes>
+struct SplitMeshData
 {
-    uint32_t indexCount          = 0;
-    uint32_t vertexStartLocation = 0;
-    uint32_t indexStartLocation  = 0;
+    using AttributeType = Attributes;
+
+    static constexpr bool kHasNormals = VertexLayoutTraits<Attributes>::kNormal;
+
+    core::memory::TrackedVector<PositionVertex, core::memory::MemoryTag::kMesh> positions;
+    core::memory::TrackedVector<Attributes, core::memory::MemoryTag::kMesh>     attributes;
+    core::memory::TrackedVector<uint32_t, core::memory::MemoryTag::kMesh>       indices;
+
+    constexpr static size_t PositionStride()
+    {
+        return sizeof(PositionVertex);
+    }
+
+    constexpr static size_t AttributeStride()
+    {
+        return sizeof(Attributes);
+    }
+
+    //! 16-bit whenever the vertex count allows; indices stay 32-bit on the CPU.
+    DXGI_FORMAT IndexFormat() const
+    {
+        return IndexFormatForVertexCount(VertexCount());
+    }
+
+    size_t IndexDataSize() const
+    {
+        return IndexFormatSize(IndexFormat());
+    }
+
+    size_t VertexCount() const
+    {
+        return positions.size();
+    }
+
+    size_t PositionBufferSize() const
+    {
+        return positions.size() * PositionStride();
+    }
+
+    size_t AttributeBufferSize() const
+    {
+        return attributes.size() * AttributeStride();
+    }
+
+    //! Both streams together.
+    size_t VertexBufferSize() const
+    {
+        return PositionBufferSize() + AttributeBufferSize();
+    }
+
+    size_t IndexBufferSize() const
+    {
+        return indices.size() * IndexDataSize();
+    }
+
+    //! destination holds IndexBufferSize() bytes.
+    void WriteIndices(void* destination) const
+    {
+        renderer::WriteIndices(indices.data(), indices.size(), IndexFormat(), destination);
+    }
+
+    void ReserveVertices(size_t count)
+    {
+        positions.reserve(count);
+        attributes.reserve(count);
+    }
+
+    uint32_t AddVertex(DirectX::XMFLOAT3 const& position, DirectX::XMFLOAT3 const& normal, DirectX::XMFLOAT3 const& tangent,
+                       DirectX::XMFLOAT2 const& texcoord, DirectX::XMFLOAT4 const& color)
+    {
+        Attributes shading{};
+        SetVertexAttributes(shading, position, normal, tangent, texcoord, color);
+        positions.push_back(PositionVertex{ position });
+        attributes.push_back(shading);
+        return static_cast<uint32_t>(positions.size() - 1);
+    }
+
+    DirectX::XMFLOAT3 const& PositionAt(size_t index) const
+    {
+        return positions[index].position;
+    }
+
+    DirectX::XMFLOAT3& NormalAt(size_t index)
+    {
+        return attributes[index].normal;
+    }
+
+    //! Move vertex ii to remap[ii] in both streams; remap is a permutation of the vertices.
+    void RemapVertices(uint32_t const* remap)
+    {
+        decltype(positions)  remappedPositions(positions.size());
+        decltype(attributes) remappedAttributes(attributes.size());
+        for (size_t ii = 0; ii < positions.size(); ++ii) {
+            remappedPositions[remap[ii]]  = positions[ii];
+            remappedAttributes[remap[ii]] = attributes[ii];
+        }
+        positions.swap(remappedPositions);
+        attributes.swap(remappedAttributes);
+    }
 };
 
+//! The full 60-byte interleaved layout.
+using MeshData = BasicMeshData<VertexData>;
+
 struct Mesh
 {
-    std::string                              name;
-    std::unordered_map<std::string, Submesh> submeshes;
+    std::string                            name;
+    core::FlatMap<core::StringId, Submesh> submeshes;
 
     graphics::ID3DBlobPtr vertexBufferCPU = nullptr;
     graphics::ID3DBlobPtr indexBufferCPU  = nullptr;
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <d3d12.h>
+#include <stddef.h>  // offsetof
+
+#include <type_traits>
+#include <utility>  // declval
+#include <vector>
+
+namespace physika::renderer {
+
+/*
+    A vertex layout is a plain struct; the attributes it declares are the
+    ones a mesh stores. Generators fill whatever a layout has and skip the
+    rest, and AppendInputElements derives the input layout from it, so a
+    depth-only mesh never carries shading data.
+*/
+
+//! Depth and shadow passes, or the first stream of a split mesh. 12 bytes.
+struct PositionVertex
+{
+    DirectX::XMFLOAT3 position;
+};
+
+//! 24 bytes.
+struct PositionNormalVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+};
+
+//! Vertex-colored lighting. 40 bytes.
+struct PositionNormalColorVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT4 color;
+};
+
+//! Everything but the position; the second stream of a split mesh. 48 bytes.
+struct ShadingAttributes
+{
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT3 tangent;
+    DirectX::XMFLOAT2 texcoord;
+    DirectX::XMFLOAT4 color;
+};
+
+namespace detail {
+
+template <typename V, typename = void>
+struct HasPosition : std::false_type
+{
+};
+template <typename V>
+struct HasPosition<V, std::void_t<decltype(std::declval<V&>().position)>> : std::true_type
+{
+};
+
+template <typename V, typename = void>
+struct HasNormal : std::false_type
+{
+};
+template <typename V>
+struct HasNormal<V, std::void_t<decltype(std::declval<V&>().normal)>> : std::true_type
+{
+};
+
+template <typename V, typename = void>
+struct HasTangent : std::false_type
+{
+};
+template <typename V>
+struct HasTangent<V, std::void_t<decltype(std::declval<V&>().tangent)>> : std::true_type
+{
+};
+
+template <typename V, typename = void>
+struct HasTexcoord : std::false_type
+{
+};
+template <typename V>
+struct HasTexcoord<V, std::void_t<decltype(std::declval<V&>().texcoord)>> : std::true_type
+{
+};
+
+template <typename V, typename = void>
+struct HasColor : std::false_type
+{
+};
+template <typename V>
+struct HasColor<V, std::void_t<decltype(std::declval<V&>().color)>> : std::true_type
+{
+};
+
+}  // namespace detail
+
+/**
+ * @brief DXGI format the input assembler reads a member of type T with.
+ *        Packed attribute types add their own specializations.
+ */
+template <typename T>
+struct ElementFormat;
+
+template <>
+struct ElementFormat<DirectX::XMFLOAT2>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32_FLOAT;
+};
+
+template <>
+struct ElementFormat<DirectX::XMFLOAT3>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+};
+
+template <>
+struct ElementFormat<DirectX::XMFLOAT4>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R32G32B32A32_FLOAT;
+};
+
+/**
+ * @brief Which attributes the layout V carries.
+ */
+template <typename V>
+struct VertexLayoutTraits
+{
+    static constexpr bool kPosition = detail::HasPosition<V>::value;
+    static constexpr bool kNormal   = detail::HasNormal<V>::value;
+    static constexpr bool kTangent  = detail::HasTangent<V>::value;
+    static constexpr bool kTexcoord = detail::HasTexcoord<V>::value;
+    static constexpr bool kColor    = detail::HasColor<V>::value;
+};
+
+/**
+ * @brief Store the attributes V has and drop the others.
+ */
+template <typename V>
+void SetVertexAttributes(V& vertex, DirectX::XMFLOAT3 const& position, DirectX::XMFLOAT3 const& normal,
+                         DirectX::XMFLOAT3 const& tangent, DirectX::XMFLOAT2 const& texcoord, DirectX::XMFLOAT4 const& color)
+{
+    if constexpr (VertexLayoutTraits<V>::kPosition) {
+        vertex.position = position;
+    }
+    if constexpr (VertexLayoutTraits<V>::kNormal) {
+        vertex.normal = normal;
+    }
+    if constexpr (VertexLayoutTraits<V>::kTangent) {
+        vertex.tangent = tangent;
+    }
+    if constexpr (VertexLayoutTraits<V>::kTexcoord) {
+        vertex.texcoord = texcoord;
+    }
+    if constexpr (VertexLayoutTraits<V>::kColor) {
+        vertex.color = color;
+    }
+}
+
+/**
+ * @brief Append the input elements of layout V, read from inputSlot.
+ */
+template <typename V>
+void AppendInputElements(std::vector<D3D12_INPUT_ELEMENT_DESC>& elements, UINT inputSlot)
+{
+    auto const add = [&](char const* semantic, DXGI_FORMAT format, size_t offset) {
+        elements.push_back({ semantic, 0, format, inputSlot, static_cast<UINT>(offset),
+                             D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
+    };
+    if constexpr (VertexLayoutTraits<V>::kPosition) {
+        add("POSITION", ElementFormat<decltype(V::position)>::kFormat, offsetof(V, position));
+    }
+    if constexpr (VertexLayoutTraits<V>::kNormal) {
+        add("NORMAL", ElementFormat<decltype(V::normal)>::kFormat, offsetof(V, normal));
+    }
+    if constexpr (VertexLayoutTraits<V>::kTangent) {
+        add("TANGENT", ElementFormat<decltype(V::tangent)>::kFormat, offsetof(V, tangent));
+    }
+    if constexpr (VertexLayoutTraits<V>::kTexcoord) {
+        add("TEXCOORD", ElementFormat<decltype(V::texcoord)>::kFormat, offsetof(V, texcoord));
+    }
+    if constexpr (VertexLayoutTraits<V>::kColor) {
+        add("COLOR", ElementFormat<decltype(V::color)>::kFormat, offsetof(V, color));
+    }
+}
+
+}  // namespace physika::renderer
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "renderer/types.h"
+#include "renderer/vertex-layout.h"
+
+namespace physika::renderer {
+
+/*
+    Compact vertex layouts, built from a MeshData by PackMeshData.
+
+    Normals and tangents are folded onto an octahedron and stored as two
+    snorm16 values; the vertex shader unfolds them:
+
+        float3 n = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+        float  t = saturate(-n.z);
+        n.xy    += n.xy >= 0.0 ? -t : t;
+        n        = normalize(n);
+
+    At 16 bits per component a decoded direction is within
+    kMaxOctahedralErrorDegrees of the source.
+
+    Texture coordinates are half floats and colors RGBA8. QuantizedVertex
+    also stores the position as unorm16 inside the mesh bounds; the mesh's
+    PositionDequantization() goes in front of the world matrix.
+*/
+
+//! Largest angle between a unit vector and its decoded octahedral encoding;
+//! about 0.0037 degrees is reached in practice.
+constexpr float kMaxOctahedralErrorDegrees = 0.005f;
+
+//! 28 bytes, 0.47x of VertexData.
+struct PackedVertex
+{
+    DirectX::XMFLOAT3                position;
+    DirectX::PackedVector::XMSHORTN2 normal;
+    DirectX::PackedVector::XMSHORTN2 tangent;
+    DirectX::PackedVector::XMHALF2   texcoord;
+    DirectX::PackedVector::XMUBYTEN4 color;
+};
+
+//! 24 bytes, 0.4x of VertexData. position.w is unused.
+struct QuantizedVertex
+{
+    DirectX::PackedVector::XMUSHORTN4 position;
+    DirectX::PackedVector::XMSHORTN2  normal;
+    DirectX::PackedVector::XMSHORTN2  tangent;
+    DirectX::PackedVector::XMHALF2    texcoord;
+    DirectX::PackedVector::XMUBYTEN4  color;
+};
+
+template <>
+struct ElementFormat<DirectX::PackedVector::XMSHORTN2>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R16G16_SNORM;
+};
+
+template <>
+struct ElementFormat<DirectX::PackedVector::XMHALF2>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R16G16_FLOAT;
+};
+
+template <>
+struct ElementFormat<DirectX::PackedVector::XMUBYTEN4>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+};
+
+template <>
+struct ElementFormat<DirectX::PackedVector::XMUSHORTN4>
+{
+    static constexpr DXGI_FORMAT kFormat = DXGI_FORMAT_R16G16B16A16_UNORM;
+};
+
+/**
+ * @brief Interleaved packed vertices and the transform that restores their
+ *        positions. Layouts without quantized positions keep the identity.
+ */
+template <typename Vertex>
+struct PackedMeshData
+{
+    using VertexType = Vertex;
+
+    core::memory::TrackedVector<Vertex, core::memory::MemoryTag::kMesh>   vertices;
+    core::memory::TrackedVector<uint32_t, core::memory::MemoryTag::kMesh> indices;
+
+    //! position = positionBias + positionScale * stored
+    DirectX::XMFLOAT3 positionScale = { 1.0f, 1.0f, 1.0f };
+    DirectX::XMFLOAT3 positionBias  = { 0.0f, 0.0f, 0.0f };
+
+    constexpr static size_t PerVertexDataSize()
+    {
+        return sizeof(Vertex);
+    }
+
+    //! 16-bit whenever the vertex count allows; indices stay 32-bit on the CPU.
+    DXGI_FORMAT IndexFormat() const
+    {
+        return IndexFormatForVertexCount(VertexCount());
+    }
+
+    size_t IndexDataSize() const
+    {
+        return IndexFormatSize(IndexFormat());
+    }
+
+    size_t VertexCount() const
+    {
+        return vertices.size();
+    }
+
+    size_t VertexBufferSize() const
+    {
+        return vertices.size() * PerVertexDataSize();
+    }
+
+    size_t IndexBufferSize() const
+    {
+        return indices.size() * IndexDataSize();
+    }
+
+    //! destination holds IndexBufferSize() bytes.
+    void WriteIndices(void* destination) const
+    {
+        renderer::WriteIndices(indices.data(), indices.size(), IndexFormat(), destination);
+    }
+
+    //! Object-space position from the stored one; use as dequantization * world.
+    DirectX::XMMATRIX PositionDequantization() const
+    {
+        return DirectX::XMMatrixScaling(positionScale.x, positionScale.y, positionScale.z) *
+               DirectX::XMMatrixTranslation(positionBias.x, positionBias.y, positionBias.z);
+    }
+};
+
+/**
+ * @brief What packing cost a mesh. Errors are the largest over all vertices,
+ *        measured by decoding the packed data the way the GPU does.
+ */
+struct PackingReport
+{
+    size_t vertexCount = 0;
+    size_t sourceBytes = 0;
+    size_t packedBytes = 0;
+
+    float maxPositionError       = 0.0f;  //!< object-space units
+    float maxNormalErrorDegrees  = 0.0f;
+    float maxTangentErrorDegrees = 0.0f;
+    float maxTexcoordError       = 0.0f;
+    float maxColorError          = 0.0f;  //!< per channel, 0..1
+
+    double CompressionRatio() const
+    {
+        return packedBytes > 0 ? static_cast<double>(sourceBytes) / static_cast<double>(packedBytes) : 0.0;
+    }
+};
+
+/**
+ * @brief Pack mesh into PackedVertex or QuantizedVertex. Zero-length normals
+ *        and tangents are stored as +z and left out of the report.
+ */
+template <typename Vertex>
+PackedMeshData<Vertex> PackMeshData(MeshData const& mesh, PackingReport* report = nullptr);
+
+void LogPackingReport(char const* meshName, PackingReport const& report);
+
+}  // namespace physika::renderer
@@ -0,0 +1,73 @@
+#include "renderer/index-buffer.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include <algorithm>
+
+namespace physika::renderer {
+
+void WriteIndices(uint32_t const* indices, size_t count, DXGI_FORMAT format, void* destination, uint32_t rebase)
+{
+    if (format == DXGI_FORMAT_R16_UINT) {
+        uint16_t* dst = static_cast<uint16_t*>(destination);
+        for (size_t ii = 0; ii < count; ++ii) {
+            assert(indices[ii] - rebase <= UINT16_MAX);
+            dst[ii] = static_cast<uint16_t>(indices[ii] - rebase);
+        }
+        return;
+    }
+    if (rebase == 0) {
+        memcpy(destination, indices, count * sizeof(uint32_t));
+        return;
+    }
+    uint32_t* dst = static_cast<uint32_t*>(destination);
+    for (size_t ii = 0; ii < count; ++ii) {
+        dst[ii] = indices[ii] - rebase;
+    }
+}
+
+Submesh IndexBufferBuilder::Add(uint32_t const* indices, size_t count, uint32_t vertexOffset)
+{
+    Submesh submesh;
+    submesh.indexCount          = static_cast<uint32_t>(count);
+    submesh.indexStartLocation  = static_cast<uint32_t>(mIndices.size());
+    submesh.vertexStartLocation = vertexOffset;
+    if (count == 0) {
+        return submesh;
+    }
+
+    auto const [lowest, highest] = std::minmax_element(indices, indices + count);
+    uint32_t const rebase        = *lowest;
+    submesh.vertexStartLocation  = vertexOffset + rebase;
+    if (IndexFormatForVertexCount(size_t(*highest - rebase) + 1) != DXGI_FORMAT_R16_UINT) {
+        mNeeds32Bit = true;
+    }
+
+    size_t const start = mIndices.size();
+    mIndices.resize(start + count);
+    WriteIndices(indices, count, DXGI_FORMAT_R32_UINT, mIndices.data() + start, rebase);
+    return submesh;
+}
+
+DXGI_FORMAT IndexBufferBuilder::Format() const
+{
+    return mNeeds32Bit ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
+}
+
+size_t IndexBufferBuilder::IndexCount() const
+{
+    return mIndices.size();
+}
+
+size_t IndexBufferBuilder::ByteSize() const
+{
+    return mIndices.size() * IndexFormatSize(Format());
+}
+
+void IndexBufferBuilder::Write(void* destination) const
+{
+    WriteIndices(mIndices.data(), mIndices.size(), Format(), destination);
+}
+
+}  // namespace physika::renderer
@@ -0,0 +1,552 @@
+#include "renderer/mesh-optimizer.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/logger.h"
+
+namespace physika::renderer {
+
+namespace {
+
+/*
+    Forsyth, "Linear-Speed Vertex Cache Optimisation". Each vertex scores by
+    its position in a simulated LRU cache plus a boost for having few
+    triangles left, and the next triangle is the best scoring one among those
+    touching the cache.
+*/
+constexpr uint32_t kCacheSize         = 32;
+constexpr uint32_t kMaxValence        = 32;
+constexpr uint32_t kInvalidTriangle   = UINT32_MAX;
+float const        kCacheDecayPower   = 1.5f;
+float const        kLastTriangleScore = 0.75f;
+float const        kValenceBoostScale = 2.0f;
+float const        kValenceBoostPower = 0.5f;
+
+struct ScoreTable
+{
+    float cache[kCacheSize];
+    float valence[kMaxValence + 1];
+};
+
+ScoreTable const& Scores()
+{
+    static ScoreTable const table = []() {
+        ScoreTable scores;
+        for (uint32_t ii = 0; ii < kCacheSize; ++ii) {
+            //! The three vertices of the last triangle score the same so its
+            //! winding does not bias which neighbour comes next.
+            scores.cache[ii] = ii < 3 ? kLastTriangleScore
+                                      : powf(1.0f - float(ii - 3) / float(kCacheSize - 3), kCacheDecayPower);
+        }
+        scores.valence[0] = 0.0f;
+        for (uint32_t ii = 1; ii <= kMaxValence; ++ii) {
+            scores.valence[ii] = kValenceBoostScale * powf(float(ii), -kValenceBoostPower);
+        }
+        return scores;
+    }();
+    return table;
+}
+
+float VertexScore(int32_t cachePosition, uint32_t remainingTriangles)
+{
+    if (remainingTriangles == 0) {
+        return 0.0f;
+    }
+    ScoreTable const& scores = Scores();
+    float const       cached = cachePosition >= 0 ? scores.cache[cachePosition] : 0.0f;
+    return cached + scores.valence[std::min(remainingTriangles, kMaxValence)];
+}
+
+//! Vertex fetch is modelled as 64-byte lines through a 4 KiB FIFO.
+constexpr size_t   kFetchLineBytes     = 64;
+constexpr uint32_t kFetchCacheLines    = 64;
+constexpr int      kOverdrawResolution = 256;
+
+/**
+ * @brief FIFO cache of `size` entries over keys [0, keyCount). A key is cached
+ *        while fewer than `size` misses happened since its own.
+ */
+class FifoCache
+{
+public:
+    FifoCache(size_t keyCount, uint32_t size) : mInsertedAt(keyCount, 0), mClock(size + 1), mSize(size)
+    {
+    }
+
+    //! Returns true on a miss.
+    bool Touch(size_t key)
+    {
+        if (mClock - mInsertedAt[key] <= mSize) {
+            return false;
+        }
+        mInsertedAt[key] = mClock++;
+        return true;
+    }
+
+    void Flush()
+    {
+        mClock += mSize + 1;
+    }
+
+private:
+    std::vector<uint32_t> mInsertedAt;
+    uint32_t              mClock;
+    uint32_t              mSize;
+};
+
+struct Vec3
+{
+    float c[3];
+};
+
+Vec3 LoadPosition(float const* positions, size_t positionStride, uint32_t index)
+{
+    uint8_t const* bytes = reinterpret_cast<uint8_t const*>(positions) + size_t(index) * positionStride;
+    float const*   p     = reinterpret_cast<float const*>(bytes);
+    return { { p[0], p[1], p[2] } };
+}
+
+Vec3 Subtract(Vec3 const& a, Vec3 const& b)
+{
+    return { { a.c[0] - b.c[0], a.c[1] - b.c[1], a.c[2] - b.c[2] } };
+}
+
+Vec3 Cross(Vec3 const& a, Vec3 const& b)
+{
+    return { { a.c[1] * b.c[2] - a.c[2] * b.c[1], a.c[2] * b.c[0] - a.c[0] * b.c[2], a.c[0] * b.c[1] - a.c[1] * b.c[0] } };
+}
+
+float Dot(Vec3 const& a, Vec3 const& b)
+{
+    return a.c[0] * b.c[0] + a.c[1] * b.c[1] + a.c[2] * b.c[2];
+}
+
+uint32_t TriangleMisses(FifoCache& cache, uint32_t const* triangle)
+{
+    return uint32_t(cache.Touch(triangle[0])) + uint32_t(cache.Touch(triangle[1])) + uint32_t(cache.Touch(triangle[2]));
+}
+
+//! Screen-space vertex: pixel coordinates and depth, smaller is closer.
+struct RasterVertex
+{
+    float x;
+    float y;
+    float z;
+};
+
+//! Depth-tested fill of pixel centers inside the triangle; returns the pixels that passed.
+size_t RasterizeTriangle(RasterVertex const& v0, RasterVertex const& v1, RasterVertex const& v2, float* depth)
+{
+    float const area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (fabsf(area) < 1e-12f) {
+        return 0;
+    }
+
+    int const minX = std::max(0, static_cast<int>(floorf(std::min({ v0.x, v1.x, v2.x }))));
+    int const minY = std::max(0, static_cast<int>(floorf(std::min({ v0.y, v1.y, v2.y }))));
+    int const maxX = std::min(kOverdrawResolution - 1, static_cast<int>(ceilf(std::max({ v0.x, v1.x, v2.x }))));
+    int const maxY = std::min(kOverdrawResolution - 1, static_cast<int>(ceilf(std::max({ v0.y, v1.y, v2.y }))));
+
+    size_t shaded = 0;
+    for (int py = minY; py <= maxY; ++py) {
+        float const cy = float(py) + 0.5f;
+        for (int px = minX; px <= maxX; ++px) {
+            float const cx = float(px) + 0.5f;
+            float const w0 = ((v1.x - cx) * (v2.y - cy) - (v2.x - cx) * (v1.y - cy)) / area;
+            float const w1 = ((v2.x - cx) * (v0.y - cy) - (v0.x - cx) * (v2.y - cy)) / area;
+            float const w2 = 1.0f - w0 - w1;
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+                continue;
+            }
+            float const z     = w0 * v0.z + w1 * v1.z + w2 * v2.z;
+            float&      pixel = depth[py * kOverdrawResolution + px];
+            if (z < pixel) {
+                pixel = z;
+                shaded += 1;
+            }
+        }
+    }
+    return shaded;
+}
+
+}  // namespace
+
+VertexCacheStats AnalyzeVertexCache(uint32_t const* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indexCount == 0 || vertexCount == 0) {
+        return stats;
+    }
+
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t ii = 0; ii < indexCount; ++ii) {
+        assert(indices[ii] < vertexCount);
+        if (cache.Touch(indices[ii])) {
+            stats.transformedVertices += 1;
+        }
+    }
+
+    stats.acmr = float(stats.transformedVertices) / float(indexCount / 3);
+    stats.atvr = float(stats.transformedVertices) / float(vertexCount);
+    return stats;
+}
+
+VertexFetchStats AnalyzeVertexFetch(uint32_t const* indices, size_t indexCount, size_t vertexCount, size_t vertexStride)
+{
+    VertexFetchStats stats;
+    if (indexCount == 0 || vertexCount == 0 || vertexStride == 0) {
+        return stats;
+    }
+
+    size_t const bufferBytes = vertexCount * vertexStride;
+    FifoCache    vertexCache(vertexCount, kDefaultVertexCacheSize);
+    FifoCache    lineCache((bufferBytes + kFetchLineBytes - 1) / kFetchLineBytes, kFetchCacheLines);
+    for (size_t ii = 0; ii < indexCount; ++ii) {
+        size_t const vertex = indices[ii];
+        if (!vertexCache.Touch(vertex)) {
+            continue;
+        }
+        size_t const firstLine = vertex * vertexStride / kFetchLineBytes;
+        size_t const lastLine  = (vertex * vertexStride + vertexStride - 1) / kFetchLineBytes;
+        for (size_t line = firstLine; line <= lastLine; ++line) {
+            if (lineCache.Touch(line)) {
+                stats.bytesFetched += kFetchLineBytes;
+            }
+        }
+    }
+
+    stats.overfetch = float(stats.bytesFetched) / float(bufferBytes);
+    return stats;
+}
+
+OverdrawStats AnalyzeOverdraw(uint32_t const* indices, size_t indexCount, float const* positions, size_t vertexCount,
+                              size_t positionStride)
+{
+    OverdrawStats stats;
+    if (indexCount < 3 || vertexCount == 0) {
+        return stats;
+    }
+
+    Vec3 lower = LoadPosition(positions, positionStride, 0);
+    Vec3 upper = lower;
+    for (uint32_t ii = 1; ii < vertexCount; ++ii) {
+        Vec3 const p = LoadPosition(positions, positionStride, ii);
+        for (int axis = 0; axis < 3; ++axis) {
+            lower.c[axis] = std::min(lower.c[axis], p.c[axis]);
+            upper.c[axis] = std::max(upper.c[axis], p.c[axis]);
+        }
+    }
+
+    std::vector<float> depth(kOverdrawResolution * kOverdrawResolution);
+    for (int axis = 0; axis < 3; ++axis) {
+        int const   u      = (axis + 1) % 3;
+        int const   v      = (axis + 2) % 3;
+        float const extent = std::max(upper.c[u] - lower.c[u], upper.c[v] - lower.c[v]);
+        if (extent <= 0.0f) {
+            continue;
+        }
+        float const scale = float(kOverdrawResolution) / extent;
+
+        //! The viewer sits on the +axis side, then on the -axis side.
+        for (float const side : { 1.0f, -1.0f }) {
+            std::fill(depth.begin(), depth.end(), FLT_MAX);
+            for (size_t ii = 0; ii + 2 < indexCount; ii += 3) {
+                Vec3 const a = LoadPosition(positions, positionStride, indices[ii]);
+                Vec3 const b = LoadPosition(positions, positionStride, indices[ii + 1]);
+                Vec3 const c = LoadPosition(positions, positionStride, indices[ii + 2]);
+                if (Cross(Subtract(b, a), Subtract(c, a)).c[axis] * side <= 0.0f) {
+                    continue;
+                }
+                auto const project = [&](Vec3 const& p) {
+                    return RasterVertex{ (p.c[u] - lower.c[u]) * scale, (p.c[v] - lower.c[v]) * scale, -side * p.c[axis] };
+                };
+                stats.shadedPixels += RasterizeTriangle(project(a), project(b), project(c), depth.data());
+            }
+            auto const covered = std::count_if(depth.begin(), depth.end(), [](float z) { return z < FLT_MAX; });
+            stats.coveredPixels += static_cast<size_t>(covered);
+        }
+    }
+
+    stats.overdraw = stats.coveredPixels > 0 ? float(stats.shadedPixels) / float(stats.coveredPixels) : 0.0f;
+    return stats;
+}
+
+void OptimizeVertexCache(uint32_t* destination, uint32_t const* indices, size_t indexCount, size_t vertexCount)
+{
+    assert(indexCount % 3 == 0);
+    size_t const triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    //! The output is written while the input is still read.
+    std::vector<uint32_t> source;
+    if (destination == indices) {
+        source.assign(indices, indices + indexCount);
+        indices = source.data();
+    }
+
+    //! Triangles around each vertex; the first remaining[v] entries are not yet emitted.
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t ii = 0; ii < indexCount; ++ii) {
+        assert(indices[ii] < vertexCount);
+        remaining[indices[ii]] += 1;
+    }
+    std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+    for (size_t ii = 0; ii < vertexCount; ++ii) {
+        firstTriangle[ii + 1] = firstTriangle[ii] + remaining[ii];
+    }
+    std::vector<uint32_t> adjacency(indexCount);
+    {
+        std::vector<uint32_t> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+        for (size_t ii = 0; ii < indexCount; ++ii) {
+            adjacency[fill[indices[ii]]++] = static_cast<uint32_t>(ii / 3);
+        }
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t ii = 0; ii < vertexCount; ++ii) {
+        vertexScore[ii] = VertexScore(-1, remaining[ii]);
+    }
+
+    std::vector<float>   triangleScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    uint32_t             best      = 0;
+    float                bestScore = -1.0f;
+    for (size_t tt = 0; tt < triangleCount; ++tt) {
+        triangleScore[tt] = vertexScore[indices[tt * 3]] + vertexScore[indices[tt * 3 + 1]] + vertexScore[indices[tt * 3 + 2]];
+        if (triangleScore[tt] > bestScore) {
+            bestScore = triangleScore[tt];
+            best      = static_cast<uint32_t>(tt);
+        }
+    }
+
+    uint32_t cache[kCacheSize + 3];
+    uint32_t cacheCount    = 0;
+    size_t   nextUnemitted = 0;
+
+    for (size_t out = 0; out < triangleCount; ++out) {
+        //! Nothing in the cache touches a pending triangle; restart from the input order.
+        if (best == kInvalidTriangle) {
+            while (emitted[nextUnemitted]) {
+                ++nextUnemitted;
+            }
+            best = static_cast<uint32_t>(nextUnemitted);
+        }
+
+        uint32_t const* triangle = indices + size_t(best) * 3;
+        destination[out * 3]     = triangle[0];
+        destination[out * 3 + 1] = triangle[1];
+        destination[out * 3 + 2] = triangle[2];
+        emitted[best]            = 1;
+
+        //! The emitted vertices move to the front; the rest keep their order.
+        uint32_t newCache[kCacheSize + 3] = { triangle[0], triangle[1], triangle[2] };
+        uint32_t newCount                 = 3;
+        for (uint32_t ii = 0; ii < cacheCount; ++ii) {
+            uint32_t const vertex = cache[ii];
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) {
+                newCache[newCount++] = vertex;
+            }
+        }
+
+        for (int corner = 0; corner < 3; ++corner) {
+            uint32_t const vertex = triangle[corner];
+            uint32_t*      begin  = adjacency.data() + firstTriangle[vertex];
+            uint32_t*      end    = begin + remaining[vertex];
+            uint32_t*      found  = std::find(begin, end, best);
+            assert(found != end);
+            std::swap(*found, *(end - 1));
+            remaining[vertex] -= 1;
+        }
+
+        //! Vertices past kCacheSize just fell out and lose their cache score.
+        for (uint32_t ii = 0; ii < newCount; ++ii) {
+            uint32_t const vertex   = newCache[ii];
+            int32_t const  position = ii < kCacheSize ? static_cast<int32_t>(ii) : -1;
+            float const    score    = VertexScore(position, remaining[vertex]);
+            float const    delta    = score - vertexScore[vertex];
+            vertexScore[vertex]     = score;
+
+            uint32_t const* begin = adjacency.data() + firstTriangle[vertex];
+            for (uint32_t jj = 0; jj < remaining[vertex]; ++jj) {
+                triangleScore[begin[jj]] += delta;
+            }
+        }
+
+        cacheCount = std::min(newCount, kCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        best      = kInvalidTriangle;
+        bestScore = -1.0f;
+        for (uint32_t ii = 0; ii < cacheCount; ++ii) {
+            uint32_t const  vertex = cache[ii];
+            uint32_t const* begin  = adjacency.data() + firstTriangle[vertex];
+            for (uint32_t jj = 0; jj < remaining[vertex]; ++jj) {
+                uint32_t const candidate = begin[jj];
+                if (triangleScore[candidate] > bestScore) {
+                    bestScore = triangleScore[candidate];
+                    best      = candidate;
+                }
+            }
+        }
+    }
+}
+
+void OptimizeOverdraw(uint32_t* destination, uint32_t const* indices, size_t indexCount, float const* positions,
+                      size_t vertexCount, size_t positionStride, float threshold)
+{
+    assert(indexCount % 3 == 0);
+    size_t const triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> source;
+    if (destination == indices) {
+        source.assign(indices, indices + indexCount);
+        indices = source.data();
+    }
+
+    //! Hard boundaries: triangles the cache order already starts from scratch.
+    std::vector<size_t> hardStarts;
+    {
+        FifoCache cache(vertexCount, kDefaultVertexCacheSize);
+        for (size_t tt = 0; tt < triangleCount; ++tt) {
+            if (TriangleMisses(cache, indices + tt * 3) == 3 || tt == 0) {
+                hardStarts.push_back(tt);
+            }
+        }
+        hardStarts.push_back(triangleCount);
+    }
+
+    //! Soft boundaries: wherever a cluster's ACMR so far is close to the whole hard cluster's.
+    std::vector<size_t> clusterStarts;
+    FifoCache           cache(vertexCount, kDefaultVertexCacheSize);
+    for (size_t hh = 0; hh + 1 < hardStarts.size(); ++hh) {
+        size_t const begin = hardStarts[hh];
+        size_t const end   = hardStarts[hh + 1];
+
+        cache.Flush();
+        uint32_t hardMisses = 0;
+        for (size_t tt = begin; tt < end; ++tt) {
+            hardMisses += TriangleMisses(cache, indices + tt * 3);
+        }
+        float const limit = threshold * float(hardMisses) / float(end - begin);
+
+        cache.Flush();
+        clusterStarts.push_back(begin);
+        size_t   clusterBegin = begin;
+        uint32_t misses       = 0;
+        for (size_t tt = begin; tt + 1 < end; ++tt) {
+            misses += TriangleMisses(cache, indices + tt * 3);
+            if (float(misses) / float(tt - clusterBegin + 1) <= limit) {
+                clusterBegin = tt + 1;
+                misses       = 0;
+                clusterStarts.push_back(clusterBegin);
+                cache.Flush();
+            }
+        }
+    }
+    clusterStarts.push_back(triangleCount);
+
+    Vec3 meshCenter = { { 0.0f, 0.0f, 0.0f } };
+    {
+        double sum[3] = { 0.0, 0.0, 0.0 };
+        for (uint32_t ii = 0; ii < vertexCount; ++ii) {
+            Vec3 const p = LoadPosition(positions, positionStride, ii);
+            for (int axis = 0; axis < 3; ++axis) {
+                sum[axis] += p.c[axis];
+            }
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            meshCenter.c[axis] = vertexCount > 0 ? static_cast<float>(sum[axis] / double(vertexCount)) : 0.0f;
+        }
+    }
+
+    //! Clusters that face away from the center are outside and go first.
+    struct Cluster
+    {
+        float  sortKey;
+        size_t begin;
+        size_t end;
+    };
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStarts.size() - 1);
+    for (size_t cc = 0; cc + 1 < clusterStarts.size(); ++cc) {
+        Vec3  centroid = { { 0.0f, 0.0f, 0.0f } };
+        Vec3  normal   = { { 0.0f, 0.0f, 0.0f } };
+        float weight   = 0.0f;
+        for (size_t tt = clusterStarts[cc]; tt < clusterStarts[cc + 1]; ++tt) {
+            Vec3 const  a    = LoadPosition(positions, positionStride, indices[tt * 3]);
+            Vec3 const  b    = LoadPosition(positions, positionStride, indices[tt * 3 + 1]);
+            Vec3 const  c    = LoadPosition(positions, positionStride, indices[tt * 3 + 2]);
+            Vec3 const  n    = Cross(Subtract(b, a), Subtract(c, a));
+            float const area = sqrtf(Dot(n, n));
+            for (int axis = 0; axis < 3; ++axis) {
+                centroid.c[axis] += (a.c[axis] + b.c[axis] + c.c[axis]) * area / 3.0f;
+                normal.c[axis] += n.c[axis];
+            }
+            weight += area;
+        }
+        float const normalLength = sqrtf(Dot(normal, normal));
+        float       sortKey      = 0.0f;
+        if (weight > 0.0f && normalLength > 0.0f) {
+            for (int axis = 0; axis < 3; ++axis) {
+                centroid.c[axis] /= weight;
+            }
+            sortKey = Dot(Subtract(centroid, meshCenter), normal) / normalLength;
+        }
+        clusters.push_back({ sortKey, clusterStarts[cc], clusterStarts[cc + 1] });
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](Cluster const& lhs, Cluster const& rhs) { return lhs.sortKey > rhs.sortKey; });
+
+    size_t out = 0;
+    for (Cluster const& cluster : clusters) {
+        std::copy(indices + cluster.begin * 3, indices + cluster.end * 3, destination + out);
+        out += (cluster.end - cluster.begin) * 3;
+    }
+}
+
+void BuildVertexFetchRemap(uint32_t* remap, uint32_t const* indices, size_t indexCount, size_t vertexCount)
+{
+    std::fill(remap, remap + vertexCount, UINT32_MAX);
+    uint32_t next = 0;
+    for (size_t ii = 0; ii < indexCount; ++ii) {
+        assert(indices[ii] < vertexCount);
+        if (remap[indices[ii]] == UINT32_MAX) {
+            remap[indices[ii]] = next++;
+        }
+    }
+    for (size_t ii = 0; ii < vertexCount; ++ii) {
+        if (remap[ii] == UINT32_MAX) {
+            remap[ii] = next++;
+        }
+    }
+}
+
+void RemapIndices(uint32_t* destination, uint32_t const* indices, size_t indexCount, uint32_t const* remap)
+{
+    for (size_t ii = 0; ii < indexCount; ++ii) {
+        destination[ii] = remap[indices[ii]];
+    }
+}
+
+void LogMeshOptimizationReport(char const* meshName, MeshOptimizationReport const& report)
+{
+    MeshOptimizationStats const& before = report.before;
+    MeshOptimizationStats const& after  = report.after;
+    PHI_LOG_INFO(kRenderer,
+                 "Optimized %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, overfetch %.3f -> %.3f, overdraw %.3f -> %.3f",
+                 meshName, before.vertexCache.acmr, after.vertexCache.acmr, before.vertexCache.atvr,
+                 after.vertexCache.atvr, before.vertexFetch.overfetch, after.vertexFetch.overfetch,
+                 before.overdraw.overdraw, after.overdraw.overdraw);
+}
+
+}  // namespace physika::renderer
@@ -23,7 +23,7 @@ using namespace DirectX;
          |/
          +---------> x+
 
-         Vertex Data
+         Vertex Data (whichever of these the mesh layout has)
             DirectX::XMFLOAT3 position;
             DirectX::XMFLOAT3 normal;
             DirectX::XMFLOAT3 tangent;
@@ -31,86 +31,90 @@ using namespace DirectX;
             DirectX::XMFLOAT4 color;
 */
 
-MeshData CreateEquilateralTriangle(float const side)
+template <typename Mesh>
+Mesh CreateEquilateralTriangle(float const side)
 {
-    MeshData meshData;
-    float    halfSide = side * 0.5f;
+    Mesh  meshData;
+    float halfSide = side * 0.5f;
 
-    meshData.vertices = {
-        { XMFLOAT3(halfSide, -halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0), XMFLOAT2(0.5, -0.5), XMFLOAT4(Colors::Blue) },
-        { XMFLOAT3(0, halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0), XMFLOAT2(0, 0.5), XMFLOAT4(Colors::Green) },
-        { XMFLOAT3(-halfSide, -halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0), XMFLOAT2(-0.5, -0.5), XMFLOAT4(Colors::Red) }
-    };
+    meshData.ReserveVertices(3);
+    meshData.AddVertex(XMFLOAT3(halfSide, -halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0, 0, 0), XMFLOAT2(0.5, -0.5),
+                       XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(0, halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0, 0, 0), XMFLOAT2(0, 0.5),
+                       XMFLOAT4(Colors::Green));
+    meshData.AddVertex(XMFLOAT3(-halfSide, -halfSide, 0.0f), XMFLOAT3(0, 0, -1.0), XMFLOAT3(0, 0, 0), XMFLOAT2(-0.5, -0.5),
+                       XMFLOAT4(Colors::Red));
 
     meshData.indices = { 2, 1, 0 };
     return meshData;
 }
 
-MeshData CreateCube(float const side)
+template <typename Mesh>
+Mesh CreateCube(float const side)
 {
-    MeshData meshData;
-    float    half = side * 0.5f;
+    Mesh  meshData;
+    float half = side * 0.5f;
 
-    meshData.vertices.resize(24);
+    meshData.ReserveVertices(24);
     // front
-    meshData.vertices[0] = VertexData(XMFLOAT3(-half, -half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[1] = VertexData(XMFLOAT3(-half, +half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[2] = VertexData(XMFLOAT3(+half, +half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[3] = VertexData(XMFLOAT3(+half, -half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, -half), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
 
     // back
-    meshData.vertices[4] = VertexData(XMFLOAT3(-half, -half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[5] = VertexData(XMFLOAT3(+half, -half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[6] = VertexData(XMFLOAT3(+half, +half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[7] = VertexData(XMFLOAT3(-half, +half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                      XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, +half), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
 
     // top
-    meshData.vertices[8]  = VertexData(XMFLOAT3(-half, +half, -half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[9]  = VertexData(XMFLOAT3(-half, +half, +half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[10] = VertexData(XMFLOAT3(+half, +half, +half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[11] = VertexData(XMFLOAT3(+half, +half, -half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, -half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, +half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, +half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, -half), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
 
     // bottom
-    meshData.vertices[12] = VertexData(XMFLOAT3(-half, -half, -half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[13] = VertexData(XMFLOAT3(+half, -half, -half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[14] = VertexData(XMFLOAT3(+half, -half, +half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[15] = VertexData(XMFLOAT3(-half, -half, +half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
-                                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, -half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, -half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, +half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, +half), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
 
     // left
-    meshData.vertices[16] = VertexData(XMFLOAT3(-half, -half, +half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
-                                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[17] = VertexData(XMFLOAT3(-half, +half, +half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
-                                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[18] = VertexData(XMFLOAT3(-half, +half, -half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
-                                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[19] = VertexData(XMFLOAT3(-half, -half, -half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
-                                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, +half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, +half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, +half, -half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(-half, -half, -half), XMFLOAT3(-1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
 
     // right
-    meshData.vertices[20] = VertexData(XMFLOAT3(+half, -half, -half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
-                                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[21] = VertexData(XMFLOAT3(+half, +half, -half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
-                                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[22] = VertexData(XMFLOAT3(+half, +half, +half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
-                                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
-    meshData.vertices[23] = VertexData(XMFLOAT3(+half, -half, +half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
-                                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, -half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
+                       XMFLOAT2(0.0f, 1.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, -half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
+                       XMFLOAT2(0.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, +half, +half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
+                       XMFLOAT2(1.0f, 0.0f), XMFLOAT4(Colors::Blue));
+    meshData.AddVertex(XMFLOAT3(+half, -half, +half), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f),
+                       XMFLOAT2(1.0f, 1.0f), XMFLOAT4(Colors::Blue));
 
     meshData.indices.resize(36);
 
@@ -153,17 +157,18 @@ MeshData CreateCube(float const side)
 
 */
 
-MeshData CreateUniformGrid(int side, int cellSize)
+template <typename Mesh>
+Mesh CreateUniformGrid(int side, int cellSize)
 {
-    MeshData meshData;
-    int      halfSide         = side / 2;
-    int      cellCountPerRow  = side / cellSize;
-    int      pointCountPerRow = cellCountPerRow + 1;
+    Mesh meshData;
+    int  halfSide         = side / 2;
+    int  cellCountPerRow  = side / cellSize;
+    int  pointCountPerRow = cellCountPerRow + 1;
+    meshData.ReserveVertices(static_cast<size_t>(pointCountPerRow) * pointCountPerRow);
     for (int z = halfSide; z >= -halfSide; z -= cellSize) {
         for (int x = -halfSide; x <= halfSide; x += cellSize) {
-            VertexData vertex = { XMFLOAT3(float(x), 0, float(z)), XMFLOAT3(), XMFLOAT3(),
-                                  XMFLOAT2(float(x) / float(side), float(z) / float(side)), XMFLOAT4(Colors::White) };
-            meshData.vertices.push_back(vertex);
+            meshData.AddVertex(XMFLOAT3(float(x), 0, float(z)), XMFLOAT3(), XMFLOAT3(),
+                               XMFLOAT2(float(x) / float(side), float(z) / float(side)), XMFLOAT4(Colors::White));
         }
     }
     for (int ii = 0; ii < pointCountPerRow - 1; ii++) {
@@ -183,41 +188,56 @@ MeshData CreateUniformGrid(int side, int cellSize)
         }
     }
 
-    // Calculate normals
-    for (int ii = 0; ii < meshData.indices.size(); ii += 3) {
-        unsigned int idx1 = meshData.indices[ii];
-        unsigned int idx2 = meshData.indices[ii + 1];
-        unsigned int idx3 = meshData.indices[ii + 2];
+    if constexpr (Mesh::kHasNormals) {
+        // Calculate normals
+        for (int ii = 0; ii < meshData.indices.size(); ii += 3) {
+            unsigned int idx1 = meshData.indices[ii];
+            unsigned int idx2 = meshData.indices[ii + 1];
+            unsigned int idx3 = meshData.indices[ii + 2];
 
-        SimpleMath::Vector3 const& A = meshData.vertices[idx1].position;
-        SimpleMath::Vector3 const& B = meshData.vertices[idx2].position;
-        SimpleMath::Vector3 const& C = meshData.vertices[idx3].position;
+            SimpleMath::Vector3 const& A = meshData.PositionAt(idx1);
+            SimpleMath::Vector3 const& B = meshData.PositionAt(idx2);
+            SimpleMath::Vector3 const& C = meshData.PositionAt(idx3);
 
-        SimpleMath::Vector3 const AB    = B - A;
-        SimpleMath::Vector3 const AC    = C - A;
-        SimpleMath::Vector3 const cross = AB.Cross(AC);
+            SimpleMath::Vector3 const AB    = B - A;
+            SimpleMath::Vector3 const AC    = C - A;
+            SimpleMath::Vector3 const cross = AB.Cross(AC);
 
-        SimpleMath::Vector3 n1 = meshData.vertices[idx1].normal;
-        SimpleMath::Vector3 n2 = meshData.vertices[idx2].normal;
-        SimpleMath::Vector3 n3 = meshData.vertices[idx3].normal;
+            SimpleMath::Vector3 n1 = meshData.NormalAt(idx1);
+            SimpleMath::Vector3 n2 = meshData.NormalAt(idx2);
+            SimpleMath::Vector3 n3 = meshData.NormalAt(idx3);
 
-        n1 += cross;
-        n2 += cross;
-        n3 += cross;
+            n1 += cross;
+            n2 += cross;
+            n3 += cross;
 
-        meshData.vertices[idx1].normal = n1;
-        meshData.vertices[idx2].normal = n2;
-        meshData.vertices[idx3].normal = n3;
-    }
+            meshData.NormalAt(idx1) = n1;
+            meshData.NormalAt(idx2) = n2;
+            meshData.NormalAt(idx3) = n3;
+        }
 
-    // normalize normals
-    for (int ii = 0; ii < meshData.vertices.size(); ++ii) {
-        SimpleMath::Vector3 n(meshData.vertices[ii].normal);
-        n.Normalize();
-        meshData.vertices[ii].normal = n;
+        // normalize normals
+        for (size_t ii = 0; ii < meshData.VertexCount(); ++ii) {
+            SimpleMath::Vector3 n(meshData.NormalAt(ii));
+            n.Normalize();
+            meshData.NormalAt(ii) = n;
+        }
     }
 
     return meshData;
 }
 
+#define PHI_INSTANTIATE_PRIMITIVES(Mesh)                             \
+    template Mesh CreateEquilateralTriangle<Mesh>(float const side); \
+    template Mesh CreateCube<Mesh>(float const side);                \
+    template Mesh CreateUniformGrid<Mesh>(int side, int cellSize);
+
+PHI_INSTANTIATE_PRIMITIVES(MeshData)
+PHI_INSTANTIATE_PRIMITIVES(BasicMeshData<PositionVertex>)
+PHI_INSTANTIATE_PRIMITIVES(BasicMeshData<PositionNormalVertex>)
+PHI_INSTANTIATE_PRIMITIVES(BasicMeshData<PositionNormalColorVertex>)
+PHI_INSTANTIATE_PRIMITIVES(SplitMeshData<ShadingAttributes>)
+
+#undef PHI_INSTANTIATE_PRIMITIVES
+
 }  // namespace physika::renderer
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "renderer/vertex-packing.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <type_traits>
+
+#include "core/logger.h"
+
+namespace physika::renderer {
+
+namespace {
+
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+using DirectX::XMFLOAT4;
+using namespace DirectX::PackedVector;
+
+float const kRadiansToDegrees = 57.2957795f;
+
+float Dot(XMFLOAT3 const& a, XMFLOAT3 const& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+float Length(XMFLOAT3 const& v)
+{
+    return sqrtf(Dot(v, v));
+}
+
+float SignNotZero(float v)
+{
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+int16_t ToSnorm16(float v)
+{
+    return static_cast<int16_t>(lroundf(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+//! The input assembler maps both -32768 and -32767 to -1.
+float FromSnorm16(int16_t v)
+{
+    return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+}
+
+uint16_t ToUnorm16(float v)
+{
+    return static_cast<uint16_t>(lroundf(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint8_t ToUnorm8(float v)
+{
+    return static_cast<uint8_t>(lroundf(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+}
+
+XMSHORTN2 EncodeOctahedral(XMFLOAT3 const& v)
+{
+    XMSHORTN2   packed(int16_t(0), int16_t(0));
+    float const l1 = fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
+    if (l1 <= 0.0f) {
+        return packed;
+    }
+    float x = v.x / l1;
+    float y = v.y / l1;
+    if (v.z < 0.0f) {
+        float const foldedX = (1.0f - fabsf(y)) * SignNotZero(x);
+        float const foldedY = (1.0f - fabsf(x)) * SignNotZero(y);
+        x                   = foldedX;
+        y                   = foldedY;
+    }
+    packed.x = ToSnorm16(x);
+    packed.y = ToSnorm16(y);
+    return packed;
+}
+
+XMFLOAT3 DecodeOctahedral(XMSHORTN2 const& packed)
+{
+    XMFLOAT3    v(FromSnorm16(packed.x), FromSnorm16(packed.y), 0.0f);
+    v.z           = 1.0f - fabsf(v.x) - fabsf(v.y);
+    float const t = std::max(-v.z, 0.0f);
+    v.x += v.x >= 0.0f ? -t : t;
+    v.y += v.y >= 0.0f ? -t : t;
+    float const length = Length(v);
+    return XMFLOAT3(v.x / length, v.y / length, v.z / length);
+}
+
+//! Angle between a vector and its decoded direction; zero vectors carry no direction.
+float AngleErrorDegrees(XMFLOAT3 const& source, XMSHORTN2 const& packed)
+{
+    float const length = Length(source);
+    if (length <= 0.0f) {
+        return 0.0f;
+    }
+    //! atan2 keeps its precision for the tiny angles acos loses in float.
+    XMFLOAT3 const decoded = DecodeOctahedral(packed);
+    XMFLOAT3 const cross(source.y * decoded.z - source.z * decoded.y, source.z * decoded.x - source.x * decoded.z,
+                         source.x * decoded.y - source.y * decoded.x);
+    return atan2f(Length(cross), Dot(source, decoded)) * kRadiansToDegrees;
+}
+
+XMHALF2 PackTexcoord(XMFLOAT2 const& uv)
+{
+    return XMHALF2(XMConvertFloatToHalf(uv.x), XMConvertFloatToHalf(uv.y));
+}
+
+XMUBYTEN4 PackColor(XMFLOAT4 const& color)
+{
+    XMUBYTEN4 packed;
+    packed.x = ToUnorm8(color.x);
+    packed.y = ToUnorm8(color.y);
+    packed.z = ToUnorm8(color.z);
+    packed.w = ToUnorm8(color.w);
+    return packed;
+}
+
+float MaxComponentError(XMFLOAT3 const& a, XMFLOAT3 const& b)
+{
+    return std::max({ fabsf(a.x - b.x), fabsf(a.y - b.y), fabsf(a.z - b.z) });
+}
+
+float TexcoordError(XMFLOAT2 const& source, XMHALF2 const& packed)
+{
+    return std::max(fabsf(source.x - XMConvertHalfToFloat(packed.x)), fabsf(source.y - XMConvertHalfToFloat(packed.y)));
+}
+
+float ColorError(XMFLOAT4 const& source, XMUBYTEN4 const& packed)
+{
+    return std::max({ fabsf(source.x - packed.x / 255.0f), fabsf(source.y - packed.y / 255.0f),
+                      fabsf(source.z - packed.z / 255.0f), fabsf(source.w - packed.w / 255.0f) });
+}
+
+}  // namespace
+
+template <typename Vertex>
+PackedMeshData<Vertex> PackMeshData(MeshData const& mesh, PackingReport* report)
+{
+    constexpr bool kQuantized = std::is_same_v<Vertex, QuantizedVertex>;
+    static_assert(kQuantized || std::is_same_v<Vertex, PackedVertex>, "PackMeshData supports PackedVertex and QuantizedVertex");
+
+    PackedMeshData<Vertex> packed;
+    packed.vertices.resize(mesh.VertexCount());
+    packed.indices.assign(mesh.indices.begin(), mesh.indices.end());
+
+    if constexpr (kQuantized) {
+        //! Unorm16 over the bounds; a flat axis keeps a scale of 1 so it decodes exactly.
+        if (mesh.VertexCount() > 0) {
+            XMFLOAT3 lower = mesh.vertices[0].position;
+            XMFLOAT3 upper = lower;
+            for (VertexData const& vertex : mesh.vertices) {
+                lower = XMFLOAT3(std::min(lower.x, vertex.position.x), std::min(lower.y, vertex.position.y),
+                                 std::min(lower.z, vertex.position.z));
+                upper = XMFLOAT3(std::max(upper.x, vertex.position.x), std::max(upper.y, vertex.position.y),
+                                 std::max(upper.z, vertex.position.z));
+            }
+            packed.positionBias  = lower;
+            packed.positionScale = XMFLOAT3(upper.x > lower.x ? upper.x - lower.x : 1.0f,
+                                            upper.y > lower.y ? upper.y - lower.y : 1.0f,
+                                            upper.z > lower.z ? upper.z - lower.z : 1.0f);
+        }
+    }
+
+    XMFLOAT3 const& scale = packed.positionScale;
+    XMFLOAT3 const& bias  = packed.positionBias;
+
+    PackingReport stats;
+    stats.vertexCount = mesh.VertexCount();
+    stats.sourceBytes = mesh.VertexBufferSize();
+    stats.packedBytes = packed.VertexBufferSize();
+
+    for (size_t ii = 0; ii < mesh.VertexCount(); ++ii) {
+        VertexData const& source = mesh.vertices[ii];
+        Vertex&           target = packed.vertices[ii];
+
+        XMFLOAT3 decodedPosition = source.position;
+        if constexpr (kQuantized) {
+            target.position.x = ToUnorm16((source.position.x - bias.x) / scale.x);
+            target.position.y = ToUnorm16((source.position.y - bias.y) / scale.y);
+            target.position.z = ToUnorm16((source.position.z - bias.z) / scale.z);
+            target.position.w = 0;
+            decodedPosition   = XMFLOAT3(bias.x + scale.x * (target.position.x / 65535.0f),
+                                         bias.y + scale.y * (target.position.y / 65535.0f),
+                                         bias.z + scale.z * (target.position.z / 65535.0f));
+        } else {
+            target.position = source.position;
+        }
+        target.normal   = EncodeOctahedral(source.normal);
+        target.tangent  = EncodeOctahedral(source.tangent);
+        target.texcoord = PackTexcoord(source.texcoord);
+        target.color    = PackColor(source.color);
+
+        float const normalError  = AngleErrorDegrees(source.normal, target.normal);
+        float const tangentError = AngleErrorDegrees(source.tangent, target.tangent);
+
+        stats.maxPositionError       = std::max(stats.maxPositionError, MaxComponentError(source.position, decodedPosition));
+        stats.maxNormalErrorDegrees  = std::max(stats.maxNormalErrorDegrees, normalError);
+        stats.maxTangentErrorDegrees = std::max(stats.maxTangentErrorDegrees, tangentError);
+        stats.maxTexcoordError       = std::max(stats.maxTexcoordError, TexcoordError(source.texcoord, target.texcoord));
+        stats.maxColorError          = std::max(stats.maxColorError, ColorError(source.color, target.color));
+    }
+
+    if (report) {
+        *report = stats;
+    }
+    return packed;
+}
+
+template PackedMeshData<PackedVertex>    PackMeshData<PackedVertex>(MeshData const& mesh, PackingReport* report);
+template PackedMeshData<QuantizedVertex> PackMeshData<QuantizedVertex>(MeshData const& mesh, PackingReport* report);
+
+void LogPackingReport(char const* meshName, PackingReport const& report)
+{
+    PHI_LOG_INFO(kRenderer,
+                 "Packed %s: %zu vertices, %.1f KiB -> %.1f KiB (%.2fx); max error position %g, normal %.4f deg, "
+                 "tangent %.4f deg, texcoord %g, color %.4f",
+                 meshName, report.vertexCount, report.sourceBytes / 1024.0, report.packedBytes / 1024.0,
+                 report.CompressionRatio(), report.maxPositionError, report.maxNormalErrorDegrees,
+                 report.maxTangentErrorDegrees, report.maxTexcoordError, report.maxColorError);
+}
+
+}  // namespace physika::renderer
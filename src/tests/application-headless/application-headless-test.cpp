@@ -0,0 +1,84 @@
+#include "core/application.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+class RecordingApp : public ApplicationHeadless
+{
+public:
+    RecordingApp() : ApplicationHeadless("recording-app", 640, 480) {}
+
+    void OnUpdate() override
+    {
+        mUpdates += 1;
+        if (mQuitAfter > 0 && mUpdates == mQuitAfter) {
+            RequestQuit();
+        }
+    }
+
+    void OnResize(int width, int height) override
+    {
+        mResizes.push_back(width);
+        mResizes.push_back(height);
+    }
+
+    int         mUpdates   = 0;
+    int         mQuitAfter = 0;
+    vector<int> mResizes;
+};
+
+TEST(ApplicationHeadlessTest, IsTheApplicationOffWindows)
+{
+#ifndef _WIN32
+    EXPECT_TRUE((is_same<Application, ApplicationHeadless>::value));
+#endif
+    ApplicationHeadless app("app", 1, 1);
+    EXPECT_EQ(nullptr, app.WindowHandle());
+    EXPECT_EQ(nullptr, app.ApplicationHandle());
+}
+
+TEST(ApplicationHeadlessTest, RunsFrameLimit)
+{
+    RecordingApp app;
+    ASSERT_TRUE(app.Initialize());
+    EXPECT_EQ((vector<int>{ 640, 480 }), app.mResizes);
+
+    app.SetFrameLimit(25);
+    app.Run();
+    EXPECT_EQ(25, app.mUpdates);
+    EXPECT_EQ(25u, app.FrameCount());
+    EXPECT_TRUE(app.Shutdown());
+}
+
+TEST(ApplicationHeadlessTest, RunsDurationLimitAtTargetRate)
+{
+    RecordingApp app;
+    ASSERT_TRUE(app.Initialize());
+    app.SetTargetFrameRate(200.0);
+    app.SetDurationLimit(0.1);
+    app.Run();
+
+    //! Pacing never runs frames short, so at most the 20 frames the rate allows plus the
+    //! unpaced first one. A loaded machine may run fewer, so only require that it ran.
+    EXPECT_GE(app.mUpdates, 1);
+    EXPECT_LE(app.mUpdates, 22);
+    EXPECT_TRUE(app.Shutdown());
+}
+
+TEST(ApplicationHeadlessTest, RequestQuitEndsRun)
+{
+    RecordingApp app;
+    app.mQuitAfter = 3;
+    ASSERT_TRUE(app.Initialize());
+    app.Run();
+    EXPECT_EQ(3, app.mUpdates);
+}
+
+}  // namespace
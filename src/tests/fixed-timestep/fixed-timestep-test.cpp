@@ -0,0 +1,66 @@
+#include "core/fixed-timestep.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(FixedTimestepTest, RunsWholeStepsAndKeepsRemainder)
+{
+    FixedTimestep clock(0.010, 8);
+    EXPECT_DOUBLE_EQ(0.010, clock.StepSeconds());
+
+    EXPECT_EQ(0u, clock.Advance(0.004));
+    EXPECT_NEAR(0.4, clock.Alpha(), 1e-9);
+
+    EXPECT_EQ(1u, clock.Advance(0.008));
+    EXPECT_NEAR(0.2, clock.Alpha(), 1e-9);
+
+    EXPECT_EQ(3u, clock.Advance(0.030));
+    EXPECT_NEAR(0.2, clock.Alpha(), 1e-9);
+    EXPECT_EQ(4u, clock.TotalSteps());
+}
+
+TEST(FixedTimestepTest, SimulationRateIsIndependentOfFrameRate)
+{
+    FixedTimestep fast(1.0 / 60.0);
+    FixedTimestep slow(1.0 / 60.0);
+
+    //! One simulated minute at 240 Hz and 30 Hz rendering.
+    for (int ii = 0; ii < 240 * 60; ++ii) {
+        fast.Advance(1.0 / 240.0);
+    }
+    for (int ii = 0; ii < 30 * 60; ++ii) {
+        slow.Advance(1.0 / 30.0);
+    }
+    EXPECT_NEAR(3600.0, static_cast<double>(fast.TotalSteps()), 1.0);
+    EXPECT_NEAR(3600.0, static_cast<double>(slow.TotalSteps()), 1.0);
+}
+
+TEST(FixedTimestepTest, CapsSubstepsAfterLongFrame)
+{
+    FixedTimestep clock(0.010, 4);
+    EXPECT_EQ(4u, clock.Advance(0.105));
+    EXPECT_EQ(6u, clock.DroppedSteps());
+    EXPECT_NEAR(0.5, clock.Alpha(), 1e-9);
+
+    //! The backlog is gone, so the next frame is back to normal.
+    EXPECT_EQ(1u, clock.Advance(0.010));
+    EXPECT_EQ(5u, clock.TotalSteps());
+
+    clock.Reset();
+    EXPECT_EQ(0u, clock.TotalSteps());
+    EXPECT_EQ(0u, clock.DroppedSteps());
+    EXPECT_DOUBLE_EQ(0.0, clock.Alpha());
+}
+
+TEST(FixedTimestepTest, IgnoresNegativeFrameTime)
+{
+    FixedTimestep clock(0.010);
+    EXPECT_EQ(0u, clock.Advance(-1.0));
+    EXPECT_DOUBLE_EQ(0.0, clock.Alpha());
+}
+
+}  // namespace
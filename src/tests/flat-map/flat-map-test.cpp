@@ -0,0 +1,92 @@
+#include "core/flat-map.h"
+
+#include <string>
+#include <unordered_map>
+
+#include "core/string-id.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(FlatMapTest, InsertFindErase)
+{
+    FlatMap<StringId, int> map;
+    EXPECT_EQ(nullptr, map.Find("cube"));
+
+    map["cube"] = 24;
+    map["grid"] = 16384;
+    EXPECT_EQ(2u, map.Size());
+    ASSERT_NE(nullptr, map.Find("cube"));
+    EXPECT_EQ(24, *map.Find("cube"));
+    EXPECT_TRUE(map.Contains("grid"));
+
+    auto const [value, inserted] = map.TryEmplace("cube", 7);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(24, *value);
+
+    EXPECT_TRUE(map.Erase("cube"));
+    EXPECT_FALSE(map.Erase("cube"));
+    EXPECT_FALSE(map.Contains("cube"));
+    EXPECT_EQ(16384, map["grid"]);
+    EXPECT_EQ(1u, map.Size());
+}
+
+//! All keys land in the same home slot, so every operation walks the probe run.
+struct CollidingHash
+{
+    size_t operator()(int /*key*/) const
+    {
+        return 3;
+    }
+};
+
+TEST(FlatMapTest, EraseKeepsProbeRunsIntact)
+{
+    FlatMap<int, int, CollidingHash> map;
+    for (int ii = 0; ii < 5; ++ii) {
+        map[ii] = ii * 10;
+    }
+    EXPECT_TRUE(map.Erase(1));
+    EXPECT_TRUE(map.Erase(3));
+    for (int ii : { 0, 2, 4 }) {
+        ASSERT_NE(nullptr, map.Find(ii));
+        EXPECT_EQ(ii * 10, *map.Find(ii));
+    }
+    EXPECT_EQ(nullptr, map.Find(1));
+}
+
+TEST(FlatMapTest, MatchesUnorderedMapUnderChurn)
+{
+    FlatMap<int, int>       map;
+    unordered_map<int, int> reference;
+    uint32_t                state = 12345;
+    for (int ii = 0; ii < 20000; ++ii) {
+        state         = state * 1664525u + 1013904223u;
+        int const key = static_cast<int>((state >> 8) % 512);
+        if (state & 1) {
+            map[key]       = ii;
+            reference[key] = ii;
+        } else {
+            EXPECT_EQ(reference.erase(key) == 1, map.Erase(key));
+        }
+    }
+
+    EXPECT_EQ(reference.size(), map.Size());
+    size_t visited = 0;
+    for (auto const& [key, value] : map) {
+        ASSERT_EQ(1u, reference.count(key));
+        EXPECT_EQ(reference[key], value);
+        ++visited;
+    }
+    EXPECT_EQ(reference.size(), visited);
+    EXPECT_LE(map.Size() * 4, map.Capacity() * 3);
+
+    map.Clear();
+    EXPECT_TRUE(map.Empty());
+    EXPECT_EQ(nullptr, map.Find(0));
+}
+
+}  // namespace
@@ -0,0 +1,168 @@
+#include "core/frame-arena.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>  // unique_ptr
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(FrameArenaTest, AllocationsAreAlignedAndDistinct)
+{
+    FrameArena arena(2, 1024);
+    arena.BeginFrame(0);
+
+    char* a = static_cast<char*>(arena.Allocate(3, 1));
+    char* b = static_cast<char*>(arena.Allocate(16, 16));
+    char* c = static_cast<char*>(arena.Allocate(8, 64));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 16);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(c) % 64);
+    EXPECT_LE(a + 3, b);
+    EXPECT_LE(b + 16, c);
+
+    //! Larger than a page: gets a page of its own.
+    char* big = static_cast<char*>(arena.Allocate(4096, 16));
+    memset(big, 0xAB, 4096);
+    EXPECT_EQ(3u + 16u + 8u + 4096u, arena.Stats().frameBytes);
+    EXPECT_EQ(2u, arena.Stats().pageAllocations);
+}
+
+TEST(FrameArenaTest, FrameIsReusedOnlyWhenItComesRoundAgain)
+{
+    FrameArena arena(2, 256);
+
+    arena.BeginFrame(0);
+    int* first = arena.New<int>(7);
+    arena.BeginFrame(1);
+    int* second = arena.New<int>(8);
+    //! Frame 0 is still in flight while frame 1 records.
+    EXPECT_EQ(7, *first);
+    EXPECT_NE(first, second);
+
+    arena.BeginFrame(2);
+    int* third = arena.New<int>(9);
+    EXPECT_EQ(first, third);
+    EXPECT_EQ(8, *second);
+}
+
+TEST(FrameArenaTest, SteadyStateDoesNotAllocatePages)
+{
+    FrameArena arena(2, 4096);
+    for (uint64_t frame = 0; frame < 4; ++frame) {
+        arena.BeginFrame(frame);
+        for (int ii = 0; ii < 100; ++ii) {
+            arena.NewArray<float>(64);
+        }
+    }
+    FrameArenaStats const warm = arena.Stats();
+    for (uint64_t frame = 4; frame < 100; ++frame) {
+        arena.BeginFrame(frame);
+        for (int ii = 0; ii < 100; ++ii) {
+            arena.NewArray<float>(64);
+        }
+    }
+    FrameArenaStats const stats = arena.Stats();
+    EXPECT_EQ(warm.pageAllocations, stats.pageAllocations);
+    EXPECT_EQ(warm.reservedBytes, stats.reservedBytes);
+    EXPECT_EQ(100u * 64u * sizeof(float), stats.peakFrameBytes);
+}
+
+TEST(FrameArenaTest, AlternatingArenasKeepTheirPages)
+{
+    //! More arenas than a thread keeps cached, so some lookups go through the arena.
+    int const kArenas = 12;
+
+    vector<unique_ptr<FrameArena>> arenas;
+    for (int aa = 0; aa < kArenas; ++aa) {
+        arenas.push_back(make_unique<FrameArena>(2, 4096));
+    }
+    auto runFrames = [&](uint64_t first, uint64_t last) {
+        for (uint64_t frame = first; frame < last; ++frame) {
+            for (auto& arena : arenas) {
+                arena->BeginFrame(frame);
+            }
+            for (int ii = 0; ii < 10; ++ii) {
+                for (auto& arena : arenas) {
+                    arena->NewArray<float>(64);
+                }
+            }
+        }
+    };
+
+    runFrames(0, 4);
+    vector<FrameArenaStats> warm;
+    for (auto const& arena : arenas) {
+        warm.push_back(arena->Stats());
+    }
+    runFrames(4, 50);
+    for (int aa = 0; aa < kArenas; ++aa) {
+        FrameArenaStats const stats = arenas[aa]->Stats();
+        EXPECT_EQ(warm[aa].pageAllocations, stats.pageAllocations);
+        EXPECT_EQ(warm[aa].reservedBytes, stats.reservedBytes);
+        EXPECT_EQ(10u * 64u * sizeof(float), stats.frameBytes);
+    }
+}
+
+TEST(FrameArenaTest, ThreadsAllocateFromTheirOwnPages)
+{
+    int const kThreads     = 4;
+    int const kAllocations = 1000;
+
+    FrameArena arena(2, 1024);
+    arena.BeginFrame(0);
+
+    vector<vector<uint32_t*>> blocks(kThreads);
+    vector<thread>            threads;
+    for (int tt = 0; tt < kThreads; ++tt) {
+        threads.emplace_back([&, tt]() {
+            for (int ii = 0; ii < kAllocations; ++ii) {
+                uint32_t* block = arena.NewArray<uint32_t>(4);
+                for (int jj = 0; jj < 4; ++jj) {
+                    block[jj] = static_cast<uint32_t>(tt * kAllocations + ii);
+                }
+                blocks[tt].push_back(block);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int tt = 0; tt < kThreads; ++tt) {
+        for (int ii = 0; ii < kAllocations; ++ii) {
+            for (int jj = 0; jj < 4; ++jj) {
+                ASSERT_EQ(static_cast<uint32_t>(tt * kAllocations + ii), blocks[tt][ii][jj]);
+            }
+        }
+    }
+    EXPECT_EQ(static_cast<uint64_t>(kThreads * kAllocations * 4 * sizeof(uint32_t)), arena.Stats().frameBytes);
+}
+
+TEST(FrameArenaTest, FrameVectorUsesTheArena)
+{
+    FrameArena arena(2, 4096);
+    arena.BeginFrame(0);
+
+    FrameVector<int> values{ FrameAllocator<int>(arena) };
+    for (int ii = 0; ii < 100; ++ii) {
+        values.push_back(ii);
+    }
+    EXPECT_EQ(4950, [&]() {
+        int sum = 0;
+        for (int value : values) {
+            sum += value;
+        }
+        return sum;
+    }());
+    EXPECT_GE(arena.Stats().frameBytes, 100u * sizeof(int));
+    EXPECT_TRUE(FrameAllocator<int>(arena) == FrameAllocator<double>(arena));
+}
+
+}  // namespace
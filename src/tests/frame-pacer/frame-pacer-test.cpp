@@ -0,0 +1,81 @@
+#include "core/frame-pacer.h"
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(FramePacerTest, DisabledPacerReturnsImmediately)
+{
+    FramePacer pacer;
+    EXPECT_DOUBLE_EQ(0.0, pacer.TargetPeriod());
+
+    Timer timer;
+    timer.Start();
+    for (int ii = 0; ii < 1000; ++ii) {
+        pacer.WaitForNextFrame();
+    }
+    timer.Tick();
+    //! Generous so a loaded machine does not fail it; a paced call would take seconds.
+    EXPECT_LT(timer.TotalRunningTimeSeconds(), 0.1);
+    EXPECT_EQ(0u, pacer.Stats().frames);
+}
+
+TEST(FramePacerTest, HoldsTargetPeriod)
+{
+    double const kPeriod = 0.005;
+    int const    kFrames = 100;
+
+    FramePacer pacer(kPeriod);
+    EXPECT_NEAR(kPeriod, pacer.TargetPeriod(), 1e-6);
+
+    //! The first call only starts the schedule.
+    pacer.WaitForNextFrame();
+    Timer timer;
+    timer.Start();
+    for (int ii = 0; ii < kFrames; ++ii) {
+        //! Half a frame of work.
+        this_thread::sleep_for(chrono::microseconds(2500));
+        pacer.WaitForNextFrame();
+    }
+    timer.Tick();
+
+    //! Frames are scheduled against absolute deadlines, so they never run short. A loaded
+    //! machine (e.g. a parallel build running this test) can make them run long, so the
+    //! upper bound only catches a pacer that is badly off.
+    double const elapsed = timer.TotalRunningTimeSeconds();
+    EXPECT_GE(elapsed, kPeriod * kFrames * 0.99);
+    EXPECT_LT(elapsed, kPeriod * kFrames * 4.0);
+
+    FramePacerStats const stats = pacer.Stats();
+    EXPECT_EQ(static_cast<uint64_t>(kFrames), stats.frames);
+    EXPECT_GE(stats.maxErrorMs, 0.0);
+    EXPECT_GE(stats.sleepFraction, 0.0);
+    EXPECT_LE(stats.sleepFraction, 1.0);
+}
+
+TEST(FramePacerTest, LongFrameRestartsSchedule)
+{
+    FramePacer pacer(0.002);
+    pacer.WaitForNextFrame();
+    this_thread::sleep_for(chrono::milliseconds(10));
+    pacer.WaitForNextFrame();
+    EXPECT_EQ(1u, pacer.Stats().missedFrames);
+
+    //! No burst of zero-length frames to catch up afterwards.
+    Timer timer;
+    timer.Start();
+    pacer.WaitForNextFrame();
+    timer.Tick();
+    EXPECT_GT(timer.DeltaSeconds(), 0.001);
+
+    pacer.SetTargetPeriod(0.0);
+    EXPECT_EQ(0u, pacer.Stats().missedFrames);
+}
+
+}  // namespace
@@ -0,0 +1,79 @@
+#include "core/frame-statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+//! Histogram buckets are accurate to better than 1%.
+double const kRelativeError = 0.01;
+
+TEST(FrameStatisticsTest, EmptyStatisticsAreZero)
+{
+    FrameStatistics statistics(16);
+    FrameTimeSummary const summary = statistics.Window();
+    EXPECT_EQ(0u, summary.frames);
+    EXPECT_DOUBLE_EQ(0.0, summary.p99Ms);
+    EXPECT_DOUBLE_EQ(0.0, statistics.Lifetime().maxMs);
+}
+
+TEST(FrameStatisticsTest, PercentilesOfUniformFrameTimes)
+{
+    FrameStatistics statistics(1000);
+    //! 1 ms .. 1000 ms in 1 ms steps
+    for (int ii = 1; ii <= 1000; ++ii) {
+        statistics.AddFrame(ii * 0.001);
+    }
+    FrameTimeSummary const summary = statistics.Window();
+    EXPECT_EQ(1000u, summary.frames);
+    EXPECT_NEAR(500.5, summary.meanMs, 1e-9);
+    EXPECT_NEAR(500.0, summary.p50Ms, 500.0 * kRelativeError);
+    EXPECT_NEAR(900.0, summary.p90Ms, 900.0 * kRelativeError);
+    EXPECT_NEAR(990.0, summary.p99Ms, 990.0 * kRelativeError);
+    EXPECT_NEAR(999.0, summary.p999Ms, 999.0 * kRelativeError);
+    EXPECT_DOUBLE_EQ(1000.0, summary.maxMs);
+    EXPECT_NEAR(1.0, summary.jitterMs, 1e-9);
+}
+
+TEST(FrameStatisticsTest, WindowForgetsOldFrames)
+{
+    FrameStatistics statistics(100);
+    statistics.AddFrame(0.5);
+    for (int ii = 0; ii < 100; ++ii) {
+        statistics.AddFrame(0.016);
+    }
+
+    FrameTimeSummary const window = statistics.Window();
+    EXPECT_EQ(100u, window.frames);
+    EXPECT_NEAR(16.0, window.maxMs, 1e-9);
+    EXPECT_NEAR(16.0, window.p999Ms, 16.0 * kRelativeError);
+    //! The step from 500 ms down to 16 ms is still inside the window.
+    EXPECT_NEAR(484.0 / 100.0, window.jitterMs, 1e-9);
+
+    FrameTimeSummary const lifetime = statistics.Lifetime();
+    EXPECT_EQ(101u, lifetime.frames);
+    EXPECT_NEAR(500.0, lifetime.maxMs, 1e-9);
+    EXPECT_NEAR(16.0, lifetime.p99Ms, 16.0 * kRelativeError);
+    EXPECT_NEAR(500.0, lifetime.p999Ms, 500.0 * kRelativeError);
+}
+
+TEST(FrameStatisticsTest, SpikesShowInTailPercentiles)
+{
+    FrameStatistics statistics(1000);
+    for (int ii = 0; ii < 1000; ++ii) {
+        statistics.AddFrame(ii % 50 == 0 ? 0.050 : 0.008);
+    }
+    FrameTimeSummary const summary = statistics.Window();
+    EXPECT_NEAR(8.0, summary.p50Ms, 8.0 * kRelativeError);
+    EXPECT_NEAR(8.0, summary.p90Ms, 8.0 * kRelativeError);
+    EXPECT_NEAR(50.0, summary.p99Ms, 50.0 * kRelativeError);
+    EXPECT_NEAR(50.0, summary.maxMs, 1e-9);
+
+    statistics.Reset();
+    EXPECT_EQ(0u, statistics.Window().frames);
+    EXPECT_EQ(0u, statistics.Lifetime().frames);
+}
+
+}  // namespace
@@ -0,0 +1,103 @@
+#include "renderer/index-buffer.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "renderer/types.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::renderer;
+
+//! Index ii of a buffer written in format, widened back to 32 bits.
+uint32_t ReadIndex(vector<uint8_t> const& buffer, DXGI_FORMAT format, size_t ii)
+{
+    if (format == DXGI_FORMAT_R16_UINT) {
+        uint16_t index;
+        memcpy(&index, buffer.data() + ii * sizeof(uint16_t), sizeof(index));
+        return index;
+    }
+    uint32_t index;
+    memcpy(&index, buffer.data() + ii * sizeof(uint32_t), sizeof(index));
+    return index;
+}
+
+vector<uint8_t> WriteBuffer(IndexBufferBuilder const& builder)
+{
+    vector<uint8_t> buffer(builder.ByteSize());
+    builder.Write(buffer.data());
+    return buffer;
+}
+
+TEST(IndexBufferTest, FormatSwitchesPast65536Vertices)
+{
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, IndexFormatForVertexCount(65536));
+    EXPECT_EQ(DXGI_FORMAT_R32_UINT, IndexFormatForVertexCount(65537));
+    EXPECT_EQ(2u, IndexFormatSize(IndexFormatForVertexCount(65536)));
+    EXPECT_EQ(4u, IndexFormatSize(IndexFormatForVertexCount(65537)));
+
+    BasicMeshData<PositionVertex> mesh;
+    mesh.vertices.resize(65536);
+    mesh.indices = { 0, 1, 65535 };
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, mesh.IndexFormat());
+    EXPECT_EQ(3u * sizeof(uint16_t), mesh.IndexBufferSize());
+
+    mesh.vertices.resize(65537);
+    mesh.indices = { 0, 1, 65536 };
+    EXPECT_EQ(DXGI_FORMAT_R32_UINT, mesh.IndexFormat());
+    EXPECT_EQ(3u * sizeof(uint32_t), mesh.IndexBufferSize());
+}
+
+TEST(IndexBufferTest, RebasedSubmeshesRoundTripThroughTheirBaseVertex)
+{
+    //! Both submeshes sit far past 16-bit range in the merged vertex buffer but span few vertices.
+    vector<uint32_t> const first  = { 70000, 70002, 70001, 70001, 70002, 70003 };
+    vector<uint32_t> const second = { 12, 10, 11 };
+
+    IndexBufferBuilder builder;
+    Submesh const      a = builder.Add(first, 0);
+    Submesh const      b = builder.Add(second, 200000);
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, builder.Format());
+    EXPECT_EQ(first.size() + second.size(), builder.IndexCount());
+    EXPECT_EQ(70000u, a.vertexStartLocation);
+    EXPECT_EQ(200010u, b.vertexStartLocation);
+    EXPECT_EQ(first.size(), b.indexStartLocation);
+
+    vector<uint8_t> const buffer = WriteBuffer(builder);
+    for (uint32_t ii = 0; ii < a.indexCount; ++ii) {
+        EXPECT_EQ(first[ii], a.vertexStartLocation + ReadIndex(buffer, builder.Format(), a.indexStartLocation + ii));
+    }
+    for (uint32_t ii = 0; ii < b.indexCount; ++ii) {
+        EXPECT_EQ(200000u + second[ii],
+                  b.vertexStartLocation + ReadIndex(buffer, builder.Format(), b.indexStartLocation + ii));
+    }
+}
+
+TEST(IndexBufferTest, SubmeshSpanningMoreThan65536VerticesNeeds32Bit)
+{
+    vector<uint32_t> const small = { 0, 1, 2 };
+    vector<uint32_t> const wide  = { 5, 6, 5 + 65536 };
+
+    IndexBufferBuilder builder;
+    builder.Add(small, 0);
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, builder.Format());
+    Submesh const submesh = builder.Add(wide, 100);
+    EXPECT_EQ(DXGI_FORMAT_R32_UINT, builder.Format());
+    EXPECT_EQ(6u * sizeof(uint32_t), builder.ByteSize());
+
+    //! The whole merged buffer switches, and the wide submesh keeps its full range.
+    vector<uint8_t> const buffer = WriteBuffer(builder);
+    for (uint32_t ii = 0; ii < small.size(); ++ii) {
+        EXPECT_EQ(small[ii], ReadIndex(buffer, builder.Format(), ii));
+    }
+    for (uint32_t ii = 0; ii < submesh.indexCount; ++ii) {
+        EXPECT_EQ(100u + wide[ii],
+                  submesh.vertexStartLocation + ReadIndex(buffer, builder.Format(), submesh.indexStartLocation + ii));
+    }
+}
+
+}  // namespace
@@ -0,0 +1,143 @@
+#include "core/input-queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "core/application-headless.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+InputEvent MakeEvent(InputEventType type, int code, int x = 0, int y = 0)
+{
+    InputEvent event;
+    event.type = type;
+    event.code = code;
+    event.x    = x;
+    event.y    = y;
+    return event;
+}
+
+TEST(InputQueueTest, StateTracksHeldKeysAndFrameEdges)
+{
+    InputState state;
+    state.BeginFrame();
+    state.Apply(MakeEvent(InputEventType::kKeyDown, kW));
+    state.Apply(MakeEvent(InputEventType::kKeyDown, kW));
+    state.Apply(MakeEvent(InputEventType::kMouseDown, kMouseLeft, 10, 10));
+    state.Apply(MakeEvent(InputEventType::kMouseMove, 0, 15, 8));
+    state.Apply(MakeEvent(InputEventType::kMouseMove, 0, 20, 5));
+    state.Apply(MakeEvent(InputEventType::kMouseWheel, 120));
+    EXPECT_TRUE(state.keyDown[kW]);
+    EXPECT_TRUE(state.keyPressed[kW]);
+    EXPECT_EQ(kMouseLeft, state.mouseButtons);
+    //! Measured from where the button went down.
+    EXPECT_EQ(10, state.mouseDeltaX);
+    EXPECT_EQ(-5, state.mouseDeltaY);
+    EXPECT_EQ(120, state.wheelDelta);
+    EXPECT_EQ(6u, state.events);
+
+    state.BeginFrame();
+    EXPECT_TRUE(state.keyDown[kW]);
+    EXPECT_FALSE(state.keyPressed[kW]);
+    EXPECT_EQ(0, state.mouseDeltaX);
+    EXPECT_EQ(0, state.wheelDelta);
+
+    state.Apply(MakeEvent(InputEventType::kKeyUp, kW));
+    state.Apply(MakeEvent(InputEventType::kMouseUp, kMouseLeft, 20, 5));
+    EXPECT_FALSE(state.keyDown[kW]);
+    EXPECT_TRUE(state.keyReleased[kW]);
+    EXPECT_EQ(kMouseNone, state.mouseButtons);
+}
+
+TEST(InputQueueTest, ReleasingOneButtonKeepsTheOthersHeld)
+{
+    InputState state;
+    state.BeginFrame();
+    state.Apply(MakeEvent(InputEventType::kMouseDown, kMouseRight, 100, 50));
+    state.Apply(MakeEvent(InputEventType::kMouseDown, kMouseLeft | kMouseRight, 100, 50));
+    EXPECT_EQ(kMouseLeft | kMouseRight, state.mouseButtons);
+
+    state.Apply(MakeEvent(InputEventType::kMouseUp, kMouseLeft, 104, 52));
+    EXPECT_EQ(kMouseRight, state.mouseButtons);
+    state.Apply(MakeEvent(InputEventType::kMouseMove, 0, 110, 60));
+    EXPECT_EQ(6, state.mouseDeltaX);
+    EXPECT_EQ(8, state.mouseDeltaY);
+
+    state.Apply(MakeEvent(InputEventType::kMouseUp, kMouseRight, 110, 60));
+    EXPECT_EQ(kMouseNone, state.mouseButtons);
+}
+
+TEST(InputQueueTest, DrainsInOrderAndCountsDrops)
+{
+    InputQueue queue(4);
+    for (int ii = 0; ii < 6; ++ii) {
+        queue.Post(MakeEvent(InputEventType::kMouseWheel, ii));
+    }
+    int expected = 0;
+    EXPECT_EQ(4u, queue.Drain([&expected](InputEvent const& event) { EXPECT_EQ(expected++, event.code); }));
+    EXPECT_EQ(0u, queue.Drain([](InputEvent const&) {}));
+
+    InputLatencyStats const latency = queue.Latency();
+    EXPECT_EQ(4u, latency.events);
+    EXPECT_EQ(2u, latency.dropped);
+    EXPECT_GE(latency.maxMs, latency.meanMs);
+}
+
+TEST(InputQueueTest, LatencyCoversTimeUntilDrain)
+{
+    InputQueue queue;
+    queue.Post(MakeEvent(InputEventType::kKeyDown, kA));
+    this_thread::sleep_for(chrono::milliseconds(5));
+    queue.Drain([](InputEvent const&) {});
+    EXPECT_GE(queue.Latency().lastDrainMaxMs, 4.0);
+    EXPECT_GE(queue.Latency().maxMs, 4.0);
+}
+
+TEST(InputQueueTest, ApplicationConsumesEventsPostedFromAnotherThread)
+{
+    //! Fits in the default queue, so nothing is dropped however the threads interleave.
+    int const kEvents = 1000;
+
+    class CountingApp : public ApplicationHeadless
+    {
+    public:
+        CountingApp() : ApplicationHeadless("counting", 1, 1) {}
+
+        void OnUpdate() override
+        {
+            mWheel += Input().wheelDelta;
+            if (mWheel == kEvents) {
+                RequestQuit();
+            }
+        }
+
+        void OnMouseWheel(int delta) override
+        {
+            mCallbackWheel += delta;
+        }
+
+        int mWheel         = 0;
+        int mCallbackWheel = 0;
+    };
+
+    CountingApp app;
+    app.SetDurationLimit(10.0);
+    thread producer([&app]() {
+        for (int ii = 0; ii < kEvents; ++ii) {
+            app.PostInputEvent(MakeEvent(InputEventType::kMouseWheel, 1));
+        }
+    });
+    app.Run();
+    producer.join();
+
+    EXPECT_EQ(kEvents, app.mWheel);
+    EXPECT_EQ(kEvents, app.mCallbackWheel);
+    EXPECT_EQ(static_cast<uint64_t>(kEvents), app.InputLatency().events);
+}
+
+}  // namespace
@@ -0,0 +1,157 @@
+#include "core/input-recorder.h"
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "core/application-headless.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+InputEvent MakeEvent(InputEventType type, int code, int x = 0, int y = 0)
+{
+    InputEvent event;
+    event.type = type;
+    event.code = code;
+    event.x    = x;
+    event.y    = y;
+    return event;
+}
+
+bool operator==(InputEvent const& left, InputEvent const& right)
+{
+    return left.type == right.type && left.code == right.code && left.x == right.x && left.y == right.y;
+}
+
+//! Logs every callback as an InputEvent tagged with the frame it arrived in.
+class EventLogApp : public ApplicationHeadless
+{
+public:
+    EventLogApp() : ApplicationHeadless("event-log", 64, 64) {}
+
+    void OnUpdate() override
+    {
+        if (mScript) {
+            for (auto const& [frame, event] : *mScript) {
+                if (frame == FrameCount()) {
+                    DispatchInputEvent(event);
+                }
+            }
+        }
+    }
+    void OnKeyDown(Keycode key) override
+    {
+        Log(MakeEvent(InputEventType::kKeyDown, key));
+    }
+    void OnKeyUp(Keycode key) override
+    {
+        Log(MakeEvent(InputEventType::kKeyUp, key));
+    }
+    void OnMouseDown(MouseButton button, int x, int y) override
+    {
+        Log(MakeEvent(InputEventType::kMouseDown, button, x, y));
+    }
+    void OnMouseUp(MouseButton button, int x, int y) override
+    {
+        Log(MakeEvent(InputEventType::kMouseUp, button, x, y));
+    }
+    void OnMouseMove(int x, int y) override
+    {
+        Log(MakeEvent(InputEventType::kMouseMove, 0, x, y));
+    }
+    void OnMouseWheel(int delta) override
+    {
+        Log(MakeEvent(InputEventType::kMouseWheel, delta));
+    }
+
+    void Log(InputEvent const& event)
+    {
+        mLog.push_back({ FrameCount(), event });
+    }
+
+    vector<pair<uint64_t, InputEvent>> const* mScript = nullptr;
+    vector<pair<uint64_t, InputEvent>>        mLog;
+};
+
+vector<pair<uint64_t, InputEvent>> const kScript = {
+    { 0, MakeEvent(InputEventType::kKeyDown, kW) },
+    { 0, MakeEvent(InputEventType::kMouseMove, 0, 320, 240) },
+    { 3, MakeEvent(InputEventType::kMouseDown, kMouseLeft, 321, 238) },
+    { 3, MakeEvent(InputEventType::kMouseMove, 0, 300, 250) },
+    { 4, MakeEvent(InputEventType::kMouseUp, kMouseLeft, 290, 260) },
+    { 7, MakeEvent(InputEventType::kMouseWheel, -120) },
+    { 9, MakeEvent(InputEventType::kKeyUp, kW) },
+};
+
+TEST(InputRecorderTest, RoundTripsEveryEventType)
+{
+    InputRecorder recorder;
+    for (auto const& [frame, event] : kScript) {
+        recorder.Record(frame, event);
+    }
+    recorder.Finish(12);
+    EXPECT_EQ(kScript.size(), recorder.EventCount());
+    //! Header plus a few bytes per event.
+    EXPECT_LT(recorder.Data().size(), 5 + kScript.size() * 8);
+
+    InputReplay replay;
+    ASSERT_TRUE(replay.Load(recorder.Data()));
+    EXPECT_EQ(12u, replay.EndFrame());
+    ASSERT_EQ(kScript.size(), replay.Events().size());
+    uint64_t lastTime = 0;
+    for (size_t ii = 0; ii < kScript.size(); ++ii) {
+        EXPECT_EQ(kScript[ii].first, replay.Events()[ii].frame);
+        EXPECT_TRUE(kScript[ii].second == replay.Events()[ii].event);
+        EXPECT_GE(replay.Events()[ii].timeUs, lastTime);
+        lastTime = replay.Events()[ii].timeUs;
+    }
+}
+
+TEST(InputRecorderTest, ReplayMatchesRecordedSession)
+{
+    char const* kPath = "input-recorder-test.bin";
+
+    InputRecorder recorder;
+    EventLogApp   live;
+    live.mScript = &kScript;
+    live.SetInputRecorder(&recorder);
+    live.SetFrameLimit(12);
+    live.Run();
+    ASSERT_EQ(kScript.size(), live.mLog.size());
+    ASSERT_TRUE(recorder.Save(kPath));
+
+    InputReplay replay;
+    ASSERT_TRUE(replay.Load(kPath));
+    remove(kPath);
+
+    EventLogApp replayed;
+    replayed.SetInputReplay(&replay);
+    EXPECT_TRUE(replayed.IsReplayingInput());
+    replayed.Run();
+    EXPECT_EQ(12u, replayed.FrameCount());
+    ASSERT_EQ(live.mLog.size(), replayed.mLog.size());
+    for (size_t ii = 0; ii < live.mLog.size(); ++ii) {
+        EXPECT_EQ(live.mLog[ii].first, replayed.mLog[ii].first);
+        EXPECT_TRUE(live.mLog[ii].second == replayed.mLog[ii].second);
+    }
+}
+
+TEST(InputRecorderTest, RejectsInvalidStreams)
+{
+    InputReplay replay;
+    EXPECT_FALSE(replay.Load(vector<uint8_t>{ 'n', 'o', 'p', 'e', 1 }));
+    EXPECT_FALSE(replay.Load("input-recorder-test-missing.bin"));
+
+    InputRecorder recorder;
+    recorder.Record(2, MakeEvent(InputEventType::kMouseMove, 0, 1000, 1000));
+    vector<uint8_t> truncated = recorder.Data();
+    truncated.pop_back();
+    EXPECT_FALSE(replay.Load(truncated));
+    EXPECT_TRUE(replay.Events().empty());
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+#include "core/job-system.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/work-stealing-queue.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(JobSystemTest, WorkStealingQueueHandsOutEachValueOnce)
+{
+    int const kValues  = 100000;
+    int const kThieves = 3;
+
+    WorkStealingQueue<int>    queue(256);
+    vector<atomic<int>>       seen(kValues);
+    atomic<bool>              done{ false };
+    vector<thread>            thieves;
+    for (int ii = 0; ii < kThieves; ++ii) {
+        thieves.emplace_back([&]() {
+            int value = 0;
+            while (!done.load()) {
+                if (queue.Steal(value)) {
+                    seen[value].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int value = 0;
+    for (int ii = 0; ii < kValues; ++ii) {
+        while (!queue.Push(ii)) {
+            if (queue.Pop(value)) {
+                seen[value].fetch_add(1);
+            }
+        }
+        if (ii % 3 == 0 && queue.Pop(value)) {
+            seen[value].fetch_add(1);
+        }
+    }
+    while (queue.Pop(value)) {
+        seen[value].fetch_add(1);
+    }
+    //! Let the thieves finish any steal already in progress.
+    while (queue.Size() > 0) {
+        this_thread::yield();
+    }
+    done.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int ii = 0; ii < kValues; ++ii) {
+        ASSERT_EQ(1, seen[ii].load()) << "value " << ii;
+    }
+}
+
+TEST(JobSystemTest, RunsEveryJobAndSignalsCounter)
+{
+    JobSystem   jobs(3);
+    JobCounter  counter;
+    atomic<int> sum{ 0 };
+    for (int ii = 1; ii <= 1000; ++ii) {
+        jobs.Run([&sum, ii]() { sum.fetch_add(ii); }, &counter);
+    }
+    jobs.Wait(counter);
+    EXPECT_TRUE(counter.Done());
+    EXPECT_EQ(500500, sum.load());
+    EXPECT_EQ(4u, jobs.ThreadCount());
+    EXPECT_GE(jobs.Stats().executed + jobs.Stats().inlined, 1000u);
+}
+
+TEST(JobSystemTest, JobsCanWaitOnNestedJobs)
+{
+    JobSystem   jobs(2);
+    JobCounter  outer;
+    atomic<int> leaves{ 0 };
+    for (int ii = 0; ii < 16; ++ii) {
+        jobs.Run(
+            [&jobs, &leaves]() {
+                //! Waiting inside a job runs other jobs instead of blocking a worker.
+                JobCounter inner;
+                for (int jj = 0; jj < 16; ++jj) {
+                    jobs.Run([&leaves]() { leaves.fetch_add(1); }, &inner);
+                }
+                jobs.Wait(inner);
+            },
+            &outer);
+    }
+    jobs.Wait(outer);
+    EXPECT_EQ(256, leaves.load());
+}
+
+TEST(JobSystemTest, ParallelForCoversRangeOnce)
+{
+    JobSystem jobs(3);
+    for (uint32_t const count : { 1u, 7u, 1000u, 100003u }) {
+        for (uint32_t const grain : { 0u, 1u, 64u, 1000000u }) {
+            vector<atomic<int>> hits(count);
+            jobs.ParallelFor(
+                count,
+                [&hits](uint32_t begin, uint32_t end) {
+                    for (uint32_t ii = begin; ii < end; ++ii) {
+                        hits[ii].fetch_add(1);
+                    }
+                },
+                grain);
+            for (uint32_t ii = 0; ii < count; ++ii) {
+                ASSERT_EQ(1, hits[ii].load()) << "count " << count << " grain " << grain << " index " << ii;
+            }
+        }
+    }
+    jobs.ParallelFor(0, [](uint32_t, uint32_t) { FAIL(); });
+}
+
+TEST(JobSystemTest, AcceptsJobsFromOtherThreads)
+{
+    JobSystem   jobs(2);
+    atomic<int> ran{ 0 };
+    thread      outsider([&]() {
+        JobCounter counter;
+        for (int ii = 0; ii < 100; ++ii) {
+            jobs.Run([&ran]() { ran.fetch_add(1); }, &counter);
+        }
+        jobs.Wait(counter);
+    });
+    outsider.join();
+    EXPECT_EQ(100, ran.load());
+}
+
+TEST(JobSystemTest, WorksWithoutWorkerThreads)
+{
+    JobSystem jobs(0);
+    uint64_t  sum = 0;
+    jobs.ParallelFor(1000, [&sum](uint32_t begin, uint32_t end) {
+        for (uint32_t ii = begin; ii < end; ++ii) {
+            sum += ii;
+        }
+    });
+    EXPECT_EQ(499500u, sum);
+}
+
+}  // namespace
@@ -0,0 +1,487 @@
+#include "core/logger.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/log-sinks.h"
+#include "core/spsc-queue.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+string ReadFile(string const& path)
+{
+    string text;
+    FILE*  file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return text;
+    }
+    char   buffer[4096];
+    size_t read = 0;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    fclose(file);
+    return text;
+}
+
+size_t CountOccurrences(string const& haystack, string const& needle)
+{
+    size_t count = 0;
+    for (size_t pos = haystack.find(needle); pos != string::npos; pos = haystack.find(needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+//! Occurrences of a message logged count times at level, which
+//! PHYSIKA_LOG_MIN_LEVEL may have compiled out.
+size_t CompiledCount(logger::LogLevel level, size_t count)
+{
+    return logger::IsCompiledIn(level) ? count : 0;
+}
+
+size_t InfoCount(size_t count)
+{
+    return CompiledCount(logger::LogLevel::kInfo, count);
+}
+
+TEST(SpscQueueTest, PushPopPreservesOrder)
+{
+    SpscQueue<int> queue(4);
+    EXPECT_EQ(4u, queue.Capacity());
+    EXPECT_TRUE(queue.Empty());
+
+    for (int ii = 0; ii < 4; ++ii) {
+        EXPECT_TRUE(queue.TryPush(ii));
+    }
+    EXPECT_FALSE(queue.TryPush(4));
+
+    for (int ii = 0; ii < 4; ++ii) {
+        int value = -1;
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(ii, value);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(SpscQueueTest, ConcurrentProducerConsumer)
+{
+    int const      kCount = 100000;
+    SpscQueue<int> queue(64);
+
+    thread producer([&queue]() {
+        for (int ii = 0; ii < kCount; ++ii) {
+            while (!queue.TryPush(ii)) {
+                this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < kCount) {
+        int value = -1;
+        if (queue.TryPop(value)) {
+            ASSERT_EQ(expected, value);
+            ++expected;
+        } else {
+            this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(LoggerTest, LevelMaskFiltersLowerLevels)
+{
+    logger::SetLoggingLevel(logger::LogLevel::kWarn);
+    EXPECT_FALSE(logger::IsLevelEnabled(logger::LogLevel::kTrace));
+    EXPECT_FALSE(logger::IsLevelEnabled(logger::LogLevel::kInfo));
+    EXPECT_TRUE(logger::IsLevelEnabled(logger::LogLevel::kWarn));
+    EXPECT_TRUE(logger::IsLevelEnabled(logger::LogLevel::kFatal));
+
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+    EXPECT_TRUE(logger::IsLevelEnabled(logger::LogLevel::kTrace));
+}
+
+TEST(LoggerTest, DisabledCategorySkipsArgumentEvaluation)
+{
+    int  evaluations = 0;
+    auto argument    = [&evaluations]() {
+        ++evaluations;
+        return 7;
+    };
+
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+    logger::SetCategoryEnabled(logger::LogCategory::kRenderer, false);
+    EXPECT_FALSE(logger::IsEnabled(logger::LogLevel::kInfo, logger::LogCategory::kRenderer));
+    EXPECT_TRUE(logger::IsEnabled(logger::LogLevel::kInfo, logger::LogCategory::kCore));
+
+    testing::internal::CaptureStdout();
+    PHI_LOG_INFO(kRenderer, "renderer %d", argument());
+    PHI_LOG_INFO(kCore, "core %d", argument());
+    string const output = testing::internal::GetCapturedStdout();
+
+    //! Compiled out calls do not evaluate their arguments either.
+    EXPECT_EQ(int(InfoCount(1)), evaluations);
+    EXPECT_EQ(0u, CountOccurrences(output, "renderer"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(output, "[INFO]: core 7"));
+
+    logger::SetCategoryEnabled(logger::LogCategory::kRenderer, true);
+    logger::SetLoggingLevel(logger::LogLevel::kError);
+    testing::internal::CaptureStdout();
+    PHI_LOG_WARN(kRenderer, "warn %d", argument());
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(int(InfoCount(1)), evaluations);
+}
+
+TEST(LoggerTest, CompiledLevelMatchesConfiguration)
+{
+    static_assert(logger::IsCompiledIn(logger::LogLevel::kFatal), "Fatal messages are always compiled in");
+    EXPECT_EQ(logger::IsCompiledIn(logger::LogLevel::kTrace), logger::kMinCompiledLevel == logger::LogLevel::kTrace);
+}
+
+TEST(LoggerTest, AsyncBlockingModeWritesEveryMessage)
+{
+    int const kThreads  = 4;
+    int const kMessages = 500;
+
+    logger::SetApplicationName("logger-test");
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+
+    logger::AsyncOptions options;
+    options.queueCapacity  = 16;
+    options.overflowPolicy = logger::OverflowPolicy::kBlock;
+    options.flushTimeoutMs = 5000;
+
+    testing::internal::CaptureStdout();
+    logger::EnableAsyncLogging(options);
+    EXPECT_TRUE(logger::IsAsyncLoggingEnabled());
+
+    vector<thread> producers;
+    for (int tt = 0; tt < kThreads; ++tt) {
+        producers.emplace_back([]() {
+            for (int ii = 0; ii < kMessages; ++ii) {
+                logger::LOG_INFO("async message %d", ii);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    logger::DisableAsyncLogging();
+    string const output = testing::internal::GetCapturedStdout();
+
+    EXPECT_FALSE(logger::IsAsyncLoggingEnabled());
+    EXPECT_EQ(InfoCount(kThreads * kMessages), CountOccurrences(output, "async message"));
+    EXPECT_EQ(0u, CountOccurrences(output, "dropped"));
+}
+
+TEST(LoggerTest, AsyncModeRespectsLogLevel)
+{
+    logger::SetLoggingLevel(logger::LogLevel::kWarn);
+
+    testing::internal::CaptureStdout();
+    logger::EnableAsyncLogging();
+    logger::LOG_INFO("filtered");
+    logger::LOG_ERROR("kept");
+    logger::DisableAsyncLogging();
+    string const output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(0u, CountOccurrences(output, "filtered"));
+    EXPECT_EQ(CompiledCount(logger::LogLevel::kError, 1), CountOccurrences(output, "[ERROR]: kept"));
+}
+
+TEST(LoggerTest, AsyncModeFormatsCapturedArguments)
+{
+    logger::SetApplicationName("logger-test");
+    logger::SetLoggingLevel(logger::LogLevel::kTrace);
+
+    char name[16] = "before";
+    testing::internal::CaptureStdout();
+    logger::EnableAsyncLogging();
+    logger::LOG_INFO("deferred %s %d %.1f %u%%", name, -3, 2.5, 42u);
+    //! The worker formats later, from the copy taken by the call.
+    snprintf(name, sizeof(name), "after");
+    logger::LogMessage(logger::LogLevel::kWarn, "direct %d", 7);
+    logger::DisableAsyncLogging();
+    string const output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(InfoCount(1), CountOccurrences(output, "[logger-test] [INFO]: deferred before -3 2.5 42%\n"));
+    EXPECT_EQ(1u, CountOccurrences(output, "[logger-test] [WARN]: direct 7\n"));
+}
+
+TEST(LoggerTest, BinaryLogRoundTrip)
+{
+    char const* kLogPath = "logger-test.binlog";
+    char const* kName    = "mesh";
+
+    logger::SetApplicationName("logger-test");
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+    ASSERT_TRUE(logger::EnableBinaryLogging(kLogPath, 1 << 20));
+    EXPECT_TRUE(logger::IsBinaryLoggingEnabled());
+
+    for (int ii = 0; ii < 3; ++ii) {
+        logger::LOG_INFO("frame %d %s took %.2f ms (%llu bytes) %c", ii, kName, 1.5 * ii, uint64_t(1) << 40, 'x');
+    }
+    logger::LOG_DEBUG("filtered %d", 1);
+    logger::LOG_WARN("negative %d short %hd %u%%", -7, short(-3), 42u);
+    logger::DisableBinaryLogging();
+    EXPECT_FALSE(logger::IsBinaryLoggingEnabled());
+
+    FILE* output = tmpfile();
+    ASSERT_NE(nullptr, output);
+    ASSERT_TRUE(logger::DecodeBinaryLog(kLogPath, output));
+
+    string text(4096, '\0');
+    rewind(output);
+    text.resize(fread(&text[0], 1, text.size(), output));
+    fclose(output);
+    remove(kLogPath);
+
+    EXPECT_EQ(InfoCount(1),
+              CountOccurrences(text, "[logger-test] [INFO]: frame 0 mesh took 0.00 ms (1099511627776 bytes) x\n"));
+    EXPECT_EQ(InfoCount(1),
+              CountOccurrences(text, "[logger-test] [INFO]: frame 2 mesh took 3.00 ms (1099511627776 bytes) x\n"));
+    EXPECT_EQ(0u, CountOccurrences(text, "filtered"));
+    EXPECT_EQ(CompiledCount(logger::LogLevel::kWarn, 1),
+              CountOccurrences(text, "[logger-test] [WARN]: negative -7 short -3 42%\n"));
+}
+
+TEST(LoggerTest, BinaryLogDropsRecordsWhenFull)
+{
+    char const* kLogPath = "logger-test-full.binlog";
+
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+    ASSERT_TRUE(logger::EnableBinaryLogging(kLogPath, 512));
+    for (int ii = 0; ii < 100; ++ii) {
+        logger::LOG_INFO("record %d", ii);
+    }
+    testing::internal::CaptureStdout();
+    logger::DisableBinaryLogging();
+    string const warning = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(InfoCount(1), CountOccurrences(warning, "dropped"));
+
+    FILE* output = tmpfile();
+    ASSERT_TRUE(logger::DecodeBinaryLog(kLogPath, output));
+    string text(4096, '\0');
+    rewind(output);
+    text.resize(fread(&text[0], 1, text.size(), output));
+    fclose(output);
+    remove(kLogPath);
+
+    EXPECT_EQ(InfoCount(1), CountOccurrences(text, "record 0\n"));
+    EXPECT_EQ(0u, CountOccurrences(text, "record 99\n"));
+}
+
+TEST(LoggerTest, BinaryLogCountsRecordsWithoutFormatIds)
+{
+    char const* kLogPath = "logger-test-formats.binlog";
+
+    //! More distinct format strings than the format table holds.
+    vector<string> formats;
+    for (int ii = 0; ii < 5000; ++ii) {
+        formats.push_back("format " + to_string(ii) + " %d");
+    }
+
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+    ASSERT_TRUE(logger::EnableBinaryLogging(kLogPath, 1 << 20));
+    for (auto const& format : formats) {
+        logger::LOG_INFO(format.c_str(), 1);
+    }
+    testing::internal::CaptureStdout();
+    logger::DisableBinaryLogging();
+    string const warning = testing::internal::GetCapturedStdout();
+    remove(kLogPath);
+
+    EXPECT_EQ(InfoCount(1), CountOccurrences(warning, "dropped 904 records"));
+}
+
+TEST(LoggerTest, UnsupportedArgumentsAreFormattedOnTheCaller)
+{
+    char const* kLogPath = "logger-test-text.binlog";
+
+    char expected[64];
+    snprintf(expected, sizeof(expected), "null %p %d\n", static_cast<void*>(nullptr), 5);
+
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+    ASSERT_TRUE(logger::EnableBinaryLogging(kLogPath, 1 << 16));
+    logger::LOG_INFO("null %p %d", nullptr, 5);
+    logger::DisableBinaryLogging();
+
+    FILE* output = tmpfile();
+    ASSERT_TRUE(logger::DecodeBinaryLog(kLogPath, output));
+    string text(4096, '\0');
+    rewind(output);
+    text.resize(fread(&text[0], 1, text.size(), output));
+    fclose(output);
+    remove(kLogPath);
+    EXPECT_EQ(InfoCount(1), CountOccurrences(text, expected));
+
+    testing::internal::CaptureStdout();
+    logger::EnableAsyncLogging();
+    logger::LOG_INFO("null %p %d", nullptr, 5);
+    logger::DisableAsyncLogging();
+    EXPECT_EQ(InfoCount(1), CountOccurrences(testing::internal::GetCapturedStdout(), expected));
+}
+
+class CollectingSink : public logger::LogSink
+{
+public:
+    void Write(logger::LogLevel /*level*/, char const* line, size_t length) override
+    {
+        text.append(line, length);
+    }
+
+    string text;
+};
+
+TEST(LoggerTest, SinksReceiveFormattedLines)
+{
+    logger::SetApplicationName("logger-test");
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+
+    auto sink = make_shared<CollectingSink>();
+    logger::AddSink(sink);
+    testing::internal::CaptureStdout();
+    logger::LOG_INFO("to sink %d", 1);
+    logger::RemoveSink(sink);
+    logger::LOG_INFO("to console only");
+    string const console = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(InfoCount(1) ? "[logger-test] [INFO]: to sink 1\n" : "", sink->text);
+    EXPECT_EQ(InfoCount(1), CountOccurrences(console, "to sink 1"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(console, "to console only"));
+}
+
+TEST(LoggerTest, MappedFileSinkRotatesSegments)
+{
+    logger::MappedFileSinkOptions options;
+    options.basePath    = "logger-test-sink";
+    options.segmentSize = 64;
+    options.maxSegments = 2;
+
+    string         written;
+    vector<string> paths;
+    {
+        logger::MappedFileSink sink(options);
+        ASSERT_TRUE(sink.IsOpen());
+        for (int ii = 0; ii < 10; ++ii) {
+            string const line = "line " + to_string(ii) + " of the rotating sink\n";
+            sink.Write(logger::LogLevel::kInfo, line.data(), line.size());
+            written += line;
+        }
+        //! Two lines fit in a segment.
+        EXPECT_EQ(4u, sink.CurrentSegment());
+        for (uint32_t ii = 0; ii <= sink.CurrentSegment(); ++ii) {
+            paths.push_back(sink.SegmentPath(ii));
+        }
+    }
+
+    //! Only the newest maxSegments segments are kept, trimmed to their contents.
+    EXPECT_TRUE(ReadFile(paths[2]).empty());
+    string const kept = ReadFile(paths[3]) + ReadFile(paths[4]);
+    EXPECT_EQ(written.substr(written.size() - kept.size()), kept);
+    EXPECT_EQ(4u, CountOccurrences(kept, "of the rotating sink\n"));
+
+    for (auto const& path : paths) {
+        remove(path.c_str());
+    }
+}
+
+TEST(LoggerTest, MappedFileSinkTrimsUnusedSpace)
+{
+    logger::MappedFileSinkOptions options;
+    options.basePath    = "logger-test-trim";
+    options.segmentSize = 64;
+
+    string const path = options.basePath + ".0.log";
+    {
+        logger::MappedFileSink sink(options);
+        ASSERT_TRUE(sink.IsOpen());
+    }
+    FILE* file = fopen(path.c_str(), "rb");
+    ASSERT_NE(nullptr, file);
+    fclose(file);
+    EXPECT_TRUE(ReadFile(path).empty());
+
+    //! A line longer than a segment is truncated rather than rotating away an empty segment.
+    string const line(100, 'x');
+    {
+        logger::MappedFileSink sink(options);
+        sink.Write(logger::LogLevel::kInfo, line.data(), line.size());
+        EXPECT_EQ(0u, sink.CurrentSegment());
+    }
+    EXPECT_EQ(line.substr(0, options.segmentSize), ReadFile(path));
+    remove(path.c_str());
+}
+
+TEST(LoggerTest, RateLimitedMacrosSuppressAndSummarise)
+{
+    logger::SetApplicationName("logger-test");
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+
+    auto sink = make_shared<CollectingSink>();
+    logger::ClearSinks();
+    logger::AddSink(sink);
+    for (int ii = 0; ii < 10; ++ii) {
+        PHI_LOG_INFO_EVERY_N(kCore, 4, "every n %d", ii);
+        PHI_LOG_INFO_FIRST_N(kCore, 2, "first n %d", ii);
+        PHI_LOG_INFO_EVERY_MS(kCore, 60000, "every ms %d", ii);
+        PHI_LOG_DEBUG_EVERY_N(kCore, 1, "filtered %d", ii);
+    }
+    logger::LogRateLimitSummary();
+    string const first = sink->text;
+    sink->text.clear();
+    logger::LogRateLimitSummary();
+    logger::ClearSinks();
+    logger::AddSink(make_shared<logger::ConsoleSink>());
+
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "every n 0\n"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "every n 4\n"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "every n 8\n"));
+    EXPECT_EQ(InfoCount(3), CountOccurrences(first, "every n"));
+    EXPECT_EQ(InfoCount(2), CountOccurrences(first, "first n"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "every ms 0\n"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "every ms"));
+    EXPECT_EQ(0u, CountOccurrences(first, "filtered"));
+
+    //! One summary line per site: 7, 8 and 9 suppressed calls.
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "suppressed 7 messages (7 total)"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "suppressed 8 messages (8 total)"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(first, "suppressed 9 messages (9 total)"));
+    EXPECT_EQ(InfoCount(3), CountOccurrences(first, "logger-test.cpp:"));
+    EXPECT_TRUE(sink->text.empty());
+}
+
+TEST(LoggerTest, EveryMsCountsManySuppressedCalls)
+{
+    uint64_t const kSuppressed = (uint64_t(1) << 24) + 9;
+
+    logger::SetLoggingLevel(logger::LogLevel::kInfo);
+    auto sink = make_shared<CollectingSink>();
+    logger::ClearSinks();
+    logger::AddSink(sink);
+    //! Suppressed calls compare against the coarse clock instead of reading steady_clock.
+    logger::UpdateLogClock();
+    for (uint64_t ii = 0; ii <= kSuppressed; ++ii) {
+        PHI_LOG_INFO_EVERY_MS(kCore, 60000, "every ms %llu", static_cast<unsigned long long>(ii));
+    }
+    logger::ResetLogClock();
+    logger::LogRateLimitSummary();
+    logger::ClearSinks();
+    logger::AddSink(make_shared<logger::ConsoleSink>());
+
+    EXPECT_EQ(InfoCount(1), CountOccurrences(sink->text, "every ms 0\n"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(sink->text, "every ms"));
+    EXPECT_EQ(InfoCount(1), CountOccurrences(sink->text, "suppressed 16777225 messages (16777225 total)"));
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+#include "core/memory-tracker.h"
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include "core/frame-arena.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+using namespace physika::core::memory;
+
+//! What a counter should have grown by; tracking compiled out leaves every counter at zero.
+uint64_t Tracked(uint64_t count)
+{
+    return PHYSIKA_MEMORY_TRACKING_ENABLED ? count : 0;
+}
+
+TEST(MemoryTrackerTest, TrackedVectorCountsLiveAndPeakBytes)
+{
+    TagStats const before = Stats(MemoryTag::kMesh);
+    {
+        TrackedVector<float, MemoryTag::kMesh> values;
+        values.reserve(1000);
+        TagStats const during = Stats(MemoryTag::kMesh);
+        EXPECT_EQ(before.liveBytes + Tracked(1000 * sizeof(float)), during.liveBytes);
+        EXPECT_GE(during.peakBytes, during.liveBytes);
+        EXPECT_EQ(before.allocations + Tracked(1), during.allocations);
+        EXPECT_STREQ("mesh", during.name);
+    }
+    TagStats const after = Stats(MemoryTag::kMesh);
+    EXPECT_EQ(before.liveBytes, after.liveBytes);
+    EXPECT_GE(after.peakBytes, before.liveBytes + Tracked(1000 * sizeof(float)));
+    EXPECT_EQ(before.frees + Tracked(1), after.frees);
+    EXPECT_EQ(before.totalBytes + Tracked(1000 * sizeof(float)), after.totalBytes);
+    EXPECT_EQ(PHYSIKA_MEMORY_TRACKING_ENABLED != 0, after.allocationsPerSecond > 0.0);
+}
+
+TEST(MemoryTrackerTest, TagsAreIndependent)
+{
+    TagStats const staging  = Stats(MemoryTag::kStaging);
+    TagStats const material = Stats(MemoryTag::kMaterial);
+
+    TrackAllocation(MemoryTag::kStaging, 4096);
+    EXPECT_EQ(staging.liveBytes + Tracked(4096), Stats(MemoryTag::kStaging).liveBytes);
+    EXPECT_EQ(material.liveBytes, Stats(MemoryTag::kMaterial).liveBytes);
+    TrackFree(MemoryTag::kStaging, 4096);
+    EXPECT_EQ(staging.liveBytes, Stats(MemoryTag::kStaging).liveBytes);
+}
+
+TEST(MemoryTrackerTest, ConcurrentTrackingBalances)
+{
+    TagStats const before = Stats(MemoryTag::kGeneral);
+
+    vector<thread> threads;
+    for (int tt = 0; tt < 4; ++tt) {
+        threads.emplace_back([]() {
+            for (int ii = 0; ii < 10000; ++ii) {
+                TrackAllocation(MemoryTag::kGeneral, 64);
+                TrackFree(MemoryTag::kGeneral, 64);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TagStats const after = Stats(MemoryTag::kGeneral);
+    EXPECT_EQ(before.liveBytes, after.liveBytes);
+    EXPECT_EQ(before.allocations + Tracked(40000), after.allocations);
+    EXPECT_LE(after.peakBytes, before.liveBytes + 4 * 64);
+}
+
+TEST(MemoryTrackerTest, FrameArenaPagesAreAccountedToFrame)
+{
+    TagStats const before = Stats(MemoryTag::kFrame);
+    {
+        FrameArena arena(2, 4096);
+        arena.BeginFrame(0);
+        arena.Allocate(100);
+        EXPECT_EQ(before.liveBytes + Tracked(4096), Stats(MemoryTag::kFrame).liveBytes);
+    }
+    EXPECT_EQ(before.liveBytes, Stats(MemoryTag::kFrame).liveBytes);
+}
+
+}  // namespace
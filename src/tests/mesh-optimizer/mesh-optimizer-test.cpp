@@ -0,0 +1,353 @@
+#include "renderer/mesh-optimizer.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::renderer;
+
+struct Float3
+{
+    float x;
+    float y;
+    float z;
+};
+
+//! The parts of the MeshData interface the optimizer templates use, without Direct3D.
+struct TestMesh
+{
+    vector<Float3>   positions;
+    vector<uint32_t> indices;
+
+    constexpr static size_t PositionStride()
+    {
+        return sizeof(Float3);
+    }
+
+    size_t VertexCount() const
+    {
+        return positions.size();
+    }
+
+    size_t VertexBufferSize() const
+    {
+        return positions.size() * sizeof(Float3);
+    }
+
+    Float3 const& PositionAt(size_t index) const
+    {
+        return positions[index];
+    }
+
+    void RemapVertices(uint32_t const* remap)
+    {
+        vector<Float3> remapped(positions.size());
+        for (size_t ii = 0; ii < positions.size(); ++ii) {
+            remapped[remap[ii]] = positions[ii];
+        }
+        positions.swap(remapped);
+    }
+};
+
+using Triangle = array<uint32_t, 3>;
+
+//! A cells x cells grid in the XZ plane, triangles in row-major order like CreateUniformGrid.
+TestMesh CreateGrid(uint32_t cells)
+{
+    TestMesh       mesh;
+    uint32_t const pointsPerRow = cells + 1;
+    for (uint32_t zz = 0; zz < pointsPerRow; ++zz) {
+        for (uint32_t xx = 0; xx < pointsPerRow; ++xx) {
+            mesh.positions.push_back({ float(xx), 0.0f, float(zz) });
+        }
+    }
+    for (uint32_t zz = 0; zz < cells; ++zz) {
+        for (uint32_t xx = 0; xx < cells; ++xx) {
+            uint32_t const v00 = zz * pointsPerRow + xx;
+            uint32_t const v01 = v00 + 1;
+            uint32_t const v10 = v00 + pointsPerRow;
+            uint32_t const v11 = v10 + 1;
+            mesh.indices.insert(mesh.indices.end(), { v00, v01, v10, v01, v11, v10 });
+        }
+    }
+    return mesh;
+}
+
+//! A UV sphere seen from outside; the pole rows are degenerate triangles.
+TestMesh CreateSphere(uint32_t rings, float radius)
+{
+    TestMesh       mesh;
+    uint32_t const segments      = rings * 2;
+    uint32_t const pointsPerRing = segments + 1;
+    float const    kPi           = 3.14159265f;
+    for (uint32_t rr = 0; rr <= rings; ++rr) {
+        float const theta = kPi * float(rr) / float(rings);
+        for (uint32_t ss = 0; ss <= segments; ++ss) {
+            float const phi  = 2.0f * kPi * float(ss) / float(segments);
+            float const ring = radius * sinf(theta);
+            mesh.positions.push_back({ ring * cosf(phi), radius * cosf(theta), ring * sinf(phi) });
+        }
+    }
+    for (uint32_t rr = 0; rr < rings; ++rr) {
+        for (uint32_t ss = 0; ss < segments; ++ss) {
+            uint32_t const v00 = rr * pointsPerRing + ss;
+            uint32_t const v01 = v00 + 1;
+            uint32_t const v10 = v00 + pointsPerRing;
+            uint32_t const v11 = v10 + 1;
+            mesh.indices.insert(mesh.indices.end(), { v00, v01, v10, v01, v11, v10 });
+        }
+    }
+    return mesh;
+}
+
+//! The inner sphere is drawn first, the worst order for the depth test from every side.
+TestMesh CreateNestedSpheres(uint32_t rings)
+{
+    TestMesh       mesh  = CreateSphere(rings, 0.5f);
+    TestMesh const outer = CreateSphere(rings, 1.0f);
+    uint32_t const base  = static_cast<uint32_t>(mesh.VertexCount());
+    mesh.positions.insert(mesh.positions.end(), outer.positions.begin(), outer.positions.end());
+    for (uint32_t index : outer.indices) {
+        mesh.indices.push_back(base + index);
+    }
+    return mesh;
+}
+
+void ShuffleTriangles(vector<uint32_t>& indices, uint32_t seed)
+{
+    vector<Triangle> triangles(indices.size() / 3);
+    for (size_t tt = 0; tt < triangles.size(); ++tt) {
+        triangles[tt] = { indices[tt * 3], indices[tt * 3 + 1], indices[tt * 3 + 2] };
+    }
+    shuffle(triangles.begin(), triangles.end(), mt19937(seed));
+    for (size_t tt = 0; tt < triangles.size(); ++tt) {
+        copy(triangles[tt].begin(), triangles[tt].end(), indices.begin() + tt * 3);
+    }
+}
+
+//! Triangles rotated to start at their smallest index, which keeps the winding, then sorted.
+vector<Triangle> SortedTriangles(uint32_t const* indices, size_t indexCount)
+{
+    vector<Triangle> triangles;
+    for (size_t ii = 0; ii + 2 < indexCount; ii += 3) {
+        Triangle triangle = { indices[ii], indices[ii + 1], indices[ii + 2] };
+        rotate(triangle.begin(), min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+vector<Triangle> SortedTriangles(vector<uint32_t> const& indices)
+{
+    return SortedTriangles(indices.data(), indices.size());
+}
+
+//! Triangles by corner positions, so the set survives vertices being renumbered. Each triangle
+//! takes its smallest rotation, which stays unique when corners share a position.
+vector<array<float, 9>> SortedTrianglePositions(TestMesh const& mesh)
+{
+    vector<array<float, 9>> triangles;
+    for (size_t ii = 0; ii + 2 < mesh.indices.size(); ii += 3) {
+        array<float, 9> smallest;
+        for (int first = 0; first < 3; ++first) {
+            array<float, 9> rotated;
+            for (int cc = 0; cc < 3; ++cc) {
+                Float3 const& p     = mesh.PositionAt(mesh.indices[ii + (first + cc) % 3]);
+                rotated[cc * 3]     = p.x;
+                rotated[cc * 3 + 1] = p.y;
+                rotated[cc * 3 + 2] = p.z;
+            }
+            smallest = first == 0 ? rotated : min(smallest, rotated);
+        }
+        triangles.push_back(smallest);
+    }
+    sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+OverdrawStats MeshOverdraw(TestMesh const& mesh)
+{
+    return AnalyzeOverdraw(mesh.indices.data(), mesh.indices.size(), &mesh.PositionAt(0).x, mesh.VertexCount(),
+                           TestMesh::PositionStride());
+}
+
+bool IsPermutation(vector<uint32_t> values)
+{
+    sort(values.begin(), values.end());
+    for (size_t ii = 0; ii < values.size(); ++ii) {
+        if (values[ii] != ii) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(MeshOptimizerTest, AcmrOfKnownMeshes)
+{
+    //! Every triangle misses all three vertices of the first; the second shares an edge.
+    vector<uint32_t> const quad = { 0, 1, 2, 1, 3, 2 };
+    EXPECT_FLOAT_EQ(3.0f, AnalyzeVertexCache(quad.data(), 3, 4).acmr);
+    EXPECT_FLOAT_EQ(2.0f, AnalyzeVertexCache(quad.data(), quad.size(), 4).acmr);
+    EXPECT_FLOAT_EQ(1.0f, AnalyzeVertexCache(quad.data(), quad.size(), 4).atvr);
+
+    //! A 17 vertex row does not fit a 16 entry FIFO, so each row of quads reloads both of its rows.
+    TestMesh const         grid   = CreateGrid(16);
+    VertexCacheStats const before = AnalyzeVertexCache(grid);
+    EXPECT_EQ(16u * 34u, before.transformedVertices);
+    EXPECT_FLOAT_EQ(544.0f / 512.0f, before.acmr);
+}
+
+TEST(MeshOptimizerTest, OptimizeVertexCacheImprovesGridAcmr)
+{
+    TestMesh grid = CreateGrid(16);
+    OptimizeVertexCache(grid);
+    VertexCacheStats const optimized = AnalyzeVertexCache(grid);
+    //! 0.5 is the limit for an infinite grid; Forsyth lands near 0.69 with a 16 entry FIFO.
+    EXPECT_LT(optimized.acmr, 0.75f);
+    EXPECT_GE(optimized.acmr, 0.5f);
+
+    TestMesh shuffled = CreateGrid(16);
+    ShuffleTriangles(shuffled.indices, 12345);
+    EXPECT_GT(AnalyzeVertexCache(shuffled).acmr, 2.0f);
+    OptimizeVertexCache(shuffled);
+    EXPECT_LT(AnalyzeVertexCache(shuffled).acmr, 0.75f);
+}
+
+TEST(MeshOptimizerTest, OptimizeVertexCacheReordersTrianglesOnly)
+{
+    TestMesh mesh = CreateGrid(24);
+    ShuffleTriangles(mesh.indices, 777);
+    vector<Triangle> const expected = SortedTriangles(mesh.indices);
+
+    vector<uint32_t> separate(mesh.indices.size());
+    OptimizeVertexCache(separate.data(), mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+    EXPECT_EQ(expected, SortedTriangles(separate));
+
+    //! In place, the input is copied before the output overwrites it.
+    vector<uint32_t> aliased = mesh.indices;
+    OptimizeVertexCache(aliased.data(), aliased.data(), aliased.size(), mesh.VertexCount());
+    EXPECT_EQ(expected, SortedTriangles(aliased));
+    EXPECT_EQ(separate, aliased);
+}
+
+TEST(MeshOptimizerTest, VertexFetchRemapIsAPermutation)
+{
+    TestMesh mesh = CreateGrid(12);
+    ShuffleTriangles(mesh.indices, 99);
+    //! Vertices no triangle uses are numbered after the used ones.
+    mesh.positions.resize(mesh.VertexCount() + 5, Float3{ -1.0f, -1.0f, -1.0f });
+
+    vector<uint32_t> remap(mesh.VertexCount());
+    BuildVertexFetchRemap(remap.data(), mesh.indices.data(), mesh.indices.size(), mesh.VertexCount());
+    EXPECT_TRUE(IsPermutation(remap));
+    EXPECT_EQ(0u, remap[mesh.indices[0]]);
+    for (size_t ii = mesh.VertexCount() - 5; ii < mesh.VertexCount(); ++ii) {
+        EXPECT_GE(remap[ii], mesh.VertexCount() - 5);
+    }
+
+    //! Remapped indices walk the vertex buffer in order: each new vertex is the next one.
+    TestMesh const original = mesh;
+    OptimizeVertexFetch(mesh);
+    uint32_t next = 0;
+    for (size_t ii = 0; ii < mesh.indices.size(); ++ii) {
+        ASSERT_LE(mesh.indices[ii], next);
+        next = max(next, mesh.indices[ii] + 1);
+        EXPECT_EQ(original.PositionAt(original.indices[ii]).x, mesh.PositionAt(mesh.indices[ii]).x);
+        EXPECT_EQ(original.PositionAt(original.indices[ii]).z, mesh.PositionAt(mesh.indices[ii]).z);
+    }
+}
+
+TEST(MeshOptimizerTest, EmptyInputsAreLeftAlone)
+{
+    EXPECT_EQ(0u, AnalyzeVertexCache(nullptr, 0, 0).transformedVertices);
+    EXPECT_FLOAT_EQ(0.0f, AnalyzeVertexCache(nullptr, 0, 10).acmr);
+    EXPECT_FLOAT_EQ(0.0f, AnalyzeVertexFetch(nullptr, 0, 0, 12).overfetch);
+    EXPECT_FLOAT_EQ(0.0f, AnalyzeOverdraw(nullptr, 0, nullptr, 0, 12).overdraw);
+
+    OptimizeVertexCache(nullptr, nullptr, 0, 0);
+    OptimizeOverdraw(nullptr, nullptr, 0, nullptr, 0, 12);
+    BuildVertexFetchRemap(nullptr, nullptr, 0, 0);
+
+    TestMesh                     empty;
+    MeshOptimizationReport const report = OptimizeMesh(empty);
+    EXPECT_TRUE(empty.indices.empty());
+    EXPECT_FLOAT_EQ(0.0f, report.after.vertexCache.acmr);
+
+    //! Vertices but no triangles: the remap keeps the vertex order.
+    vector<uint32_t> remap(4);
+    BuildVertexFetchRemap(remap.data(), nullptr, 0, remap.size());
+    EXPECT_EQ((vector<uint32_t>{ 0, 1, 2, 3 }), remap);
+}
+
+TEST(MeshOptimizerTest, DegenerateTrianglesSurvive)
+{
+    //! Repeated corners, a triangle of one vertex and a zero-area sliver among real triangles.
+    TestMesh mesh;
+    mesh.positions = { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 2, 0, 0 } };
+    mesh.indices   = { 0, 1, 2, 0, 0, 1, 3, 3, 3, 1, 3, 2, 0, 1, 4, 2, 2, 2 };
+    vector<Triangle> const expected = SortedTriangles(mesh.indices);
+
+    OptimizeVertexCache(mesh);
+    EXPECT_EQ(expected, SortedTriangles(mesh.indices));
+    OptimizeOverdraw(mesh);
+    EXPECT_EQ(expected, SortedTriangles(mesh.indices));
+
+    OptimizeMesh(mesh);
+    EXPECT_EQ(expected.size() * 3, mesh.indices.size());
+    EXPECT_LE(AnalyzeVertexCache(mesh).acmr, 3.0f);
+}
+
+TEST(MeshOptimizerTest, OptimizeOverdrawDrawsTheOuterLayerFirst)
+{
+    TestMesh mesh = CreateNestedSpheres(16);
+    OptimizeVertexCache(mesh);
+    OverdrawStats const before = MeshOverdraw(mesh);
+    EXPECT_GT(before.overdraw, 1.2f);
+
+    vector<Triangle> const expected = SortedTriangles(mesh.indices);
+    OptimizeOverdraw(mesh);
+    OverdrawStats const after = MeshOverdraw(mesh);
+    EXPECT_LE(after.overdraw, before.overdraw);
+    EXPECT_LT(after.overdraw, 1.01f);
+    EXPECT_EQ(before.coveredPixels, after.coveredPixels);
+    EXPECT_EQ(expected, SortedTriangles(mesh.indices));
+}
+
+TEST(MeshOptimizerTest, OptimizeMeshKeepsTheTriangles)
+{
+    TestMesh mesh = CreateNestedSpheres(12);
+    ShuffleTriangles(mesh.indices, 4);
+    vector<array<float, 9>> const expected = SortedTrianglePositions(mesh);
+
+    OptimizeMesh(mesh);
+    EXPECT_EQ(expected, SortedTrianglePositions(mesh));
+}
+
+TEST(MeshOptimizerTest, OptimizeMeshStaysNearCacheOnlyAcmr)
+{
+    //! Overdraw clusters may cost up to the threshold in ACMR; vertex fetch only renames vertices.
+    vector<TestMesh> meshes = { CreateGrid(32), CreateSphere(16, 1.0f), CreateSphere(32, 1.0f), CreateNestedSpheres(16) };
+    ShuffleTriangles(meshes[3].indices, 9);
+    for (TestMesh& mesh : meshes) {
+        TestMesh cacheOnly = mesh;
+        OptimizeVertexCache(cacheOnly);
+        float const cacheOnlyAcmr = AnalyzeVertexCache(cacheOnly).acmr;
+
+        MeshOptimizationReport const report = OptimizeMesh(mesh);
+        EXPECT_FLOAT_EQ(report.after.vertexCache.acmr, AnalyzeVertexCache(mesh).acmr);
+        EXPECT_LE(report.after.vertexCache.acmr, cacheOnlyAcmr * kDefaultOverdrawThreshold)
+            << mesh.VertexCount() << " vertices";
+    }
+}
+
+}  // namespace
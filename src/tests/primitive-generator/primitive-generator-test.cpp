@@ -0,0 +1,59 @@
+#include "renderer/primitive-generator.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::renderer;
+
+using SplitMesh = SplitMeshData<ShadingAttributes>;
+
+void ExpectSameFloat3(DirectX::XMFLOAT3 const& expected, DirectX::XMFLOAT3 const& actual, size_t vertex)
+{
+    EXPECT_FLOAT_EQ(expected.x, actual.x) << "vertex " << vertex;
+    EXPECT_FLOAT_EQ(expected.y, actual.y) << "vertex " << vertex;
+    EXPECT_FLOAT_EQ(expected.z, actual.z) << "vertex " << vertex;
+}
+
+//! The split layout stores the same geometry as the interleaved one, only in two streams.
+void ExpectSameGeometry(MeshData& interleaved, SplitMesh& split)
+{
+    ASSERT_EQ(interleaved.VertexCount(), split.VertexCount());
+    ASSERT_EQ(interleaved.VertexCount(), split.attributes.size());
+    for (size_t ii = 0; ii < interleaved.VertexCount(); ++ii) {
+        ExpectSameFloat3(interleaved.PositionAt(ii), split.PositionAt(ii), ii);
+        ExpectSameFloat3(interleaved.NormalAt(ii), split.NormalAt(ii), ii);
+    }
+    ASSERT_EQ(interleaved.indices.size(), split.indices.size());
+    for (size_t ii = 0; ii < interleaved.indices.size(); ++ii) {
+        EXPECT_EQ(interleaved.indices[ii], split.indices[ii]) << "index " << ii;
+    }
+    EXPECT_EQ(interleaved.IndexFormat(), split.IndexFormat());
+}
+
+TEST(PrimitiveGeneratorTest, SplitTriangleMatchesInterleaved)
+{
+    MeshData  interleaved = CreateEquilateralTriangle<MeshData>(2.0f);
+    SplitMesh split       = CreateEquilateralTriangle<SplitMesh>(2.0f);
+    ExpectSameGeometry(interleaved, split);
+}
+
+TEST(PrimitiveGeneratorTest, SplitCubeMatchesInterleaved)
+{
+    MeshData  interleaved = CreateCube<MeshData>(1.5f);
+    SplitMesh split       = CreateCube<SplitMesh>(1.5f);
+    EXPECT_EQ(24u, split.VertexCount());
+    ExpectSameGeometry(interleaved, split);
+}
+
+TEST(PrimitiveGeneratorTest, SplitGridMatchesInterleaved)
+{
+    //! Grid normals are accumulated through NormalAt, so this also covers the split normal stream.
+    MeshData  interleaved = CreateUniformGrid<MeshData>(16, 2);
+    SplitMesh split       = CreateUniformGrid<SplitMesh>(16, 2);
+    EXPECT_EQ(81u, split.VertexCount());
+    ExpectSameGeometry(interleaved, split);
+}
+
+}  // namespace
@@ -0,0 +1,131 @@
+#include "core/profiler.h"
+
+#include <stdio.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+#if PHYSIKA_PROFILER_ENABLED
+profiler::ProfileNode const* FindNode(profiler::FrameProfile const& frame, string const& name)
+{
+    for (auto const& node : frame.nodes) {
+        if (name == node.name) {
+            return &node;
+        }
+    }
+    return nullptr;
+}
+#endif
+
+void Child()
+{
+    PROFILE_SCOPE("Child");
+    this_thread::sleep_for(chrono::milliseconds(2));
+}
+
+TEST(ProfilerTest, AggregatesNestedScopesPerFrame)
+{
+    profiler::EndFrame();
+    {
+        PROFILE_SCOPE("Frame");
+        Child();
+        Child();
+        {
+            PROFILE_SCOPE("Sibling");
+        }
+    }
+    profiler::EndFrame();
+
+    auto const& frame = profiler::LastFrame();
+#if !PHYSIKA_PROFILER_ENABLED
+    //! PROFILE_SCOPE compiles to nothing.
+    EXPECT_TRUE(frame.nodes.empty());
+#else
+    ASSERT_EQ(3u, frame.nodes.size());
+    auto const* root    = FindNode(frame, "Frame");
+    auto const* child   = FindNode(frame, "Child");
+    auto const* sibling = FindNode(frame, "Sibling");
+    ASSERT_TRUE(root && child && sibling);
+
+    EXPECT_EQ(profiler::kNoParent, root->parent);
+    EXPECT_EQ(0u, root->depth);
+    EXPECT_EQ(&frame.nodes[child->parent], root);
+    EXPECT_EQ(&frame.nodes[sibling->parent], root);
+    EXPECT_EQ(1u, child->depth);
+    EXPECT_EQ(2u, child->calls);
+    EXPECT_GE(child->totalMs, 4.0);
+    EXPECT_GE(root->totalMs, child->totalMs + sibling->totalMs);
+    EXPECT_NEAR(root->totalMs - child->totalMs - sibling->totalMs, root->selfMs, 1e-9);
+    EXPECT_GE(frame.frameMs, root->totalMs);
+    EXPECT_EQ(0u, frame.droppedScopes);
+
+    profiler::EndFrame();
+    EXPECT_TRUE(profiler::LastFrame().nodes.empty());
+#endif
+}
+
+TEST(ProfilerTest, CollectsScopesFromOtherThreads)
+{
+    profiler::EndFrame();
+    thread worker([]() {
+        profiler::SetThreadName("worker");
+        PROFILE_SCOPE("WorkerJob");
+    });
+    worker.join();
+    {
+        PROFILE_SCOPE("MainJob");
+    }
+    profiler::EndFrame();
+
+    auto const& frame = profiler::LastFrame();
+#if !PHYSIKA_PROFILER_ENABLED
+    EXPECT_TRUE(frame.nodes.empty());
+#else
+    auto const* job     = FindNode(frame, "WorkerJob");
+    auto const* mainJob = FindNode(frame, "MainJob");
+    ASSERT_TRUE(job && mainJob);
+    EXPECT_NE(job->thread, mainJob->thread);
+    EXPECT_EQ(profiler::kNoParent, job->parent);
+#endif
+}
+
+TEST(ProfilerTest, ExportsChromeTrace)
+{
+    char const* kTracePath = "profiler-test.json";
+
+    profiler::SetThreadName("main");
+    profiler::EndFrame();
+    EXPECT_FALSE(profiler::StopCapture(kTracePath));
+    profiler::StartCapture();
+    EXPECT_TRUE(profiler::IsCapturing());
+    {
+        PROFILE_SCOPE("Traced \"scope\"");
+    }
+    profiler::EndFrame();
+    ASSERT_TRUE(profiler::StopCapture(kTracePath));
+    EXPECT_FALSE(profiler::IsCapturing());
+
+    string text(8192, '\0');
+    FILE*  file = fopen(kTracePath, "r");
+    ASSERT_NE(nullptr, file);
+    text.resize(fread(&text[0], 1, text.size(), file));
+    fclose(file);
+    remove(kTracePath);
+
+    //! Without the profiler the trace is still written, with no scopes in it.
+    EXPECT_EQ(0u, text.find("{\"traceEvents\":["));
+    EXPECT_EQ(PHYSIKA_PROFILER_ENABLED != 0,
+              string::npos != text.find("\"name\":\"Traced \\\"scope\\\"\",\"ph\":\"X\""));
+    EXPECT_NE(string::npos, text.find("\"args\":{\"name\":\"main\"}"));
+    EXPECT_NE(string::npos, text.find("],\"displayTimeUnit\":\"ms\"}"));
+}
+
+}  // namespace
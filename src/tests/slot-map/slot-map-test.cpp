@@ -0,0 +1,74 @@
+#include "core/slot-map.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(SlotMapTest, InsertGetRemove)
+{
+    SlotMap<string> names;
+    auto const      a = names.Insert("a");
+    auto const      b = names.Emplace(3, 'b');
+    EXPECT_EQ(2u, names.Size());
+    EXPECT_EQ("a", names[a]);
+    EXPECT_EQ("bbb", *names.Get(b));
+
+    EXPECT_TRUE(names.Remove(a));
+    EXPECT_FALSE(names.Remove(a));
+    EXPECT_EQ(1u, names.Size());
+    EXPECT_EQ(nullptr, names.Get(a));
+    EXPECT_FALSE(names.Contains(a));
+    //! The survivor moved into the hole; its handle still resolves.
+    EXPECT_EQ("bbb", names[b]);
+    EXPECT_FALSE(names.Contains(Handle<string>{}));
+}
+
+TEST(SlotMapTest, ReusedSlotsRejectStaleHandles)
+{
+    SlotMap<int> values;
+    auto const   first = values.Insert(1);
+    values.Remove(first);
+    auto const second = values.Insert(2);
+
+    EXPECT_EQ(first.index, second.index);
+    EXPECT_NE(first.generation, second.generation);
+    EXPECT_EQ(nullptr, values.Get(first));
+    EXPECT_EQ(2, values[second]);
+}
+
+TEST(SlotMapTest, ValuesStayDenseUnderChurn)
+{
+    SlotMap<int>        values;
+    vector<Handle<int>> handles;
+    for (int ii = 0; ii < 100; ++ii) {
+        handles.push_back(values.Insert(ii));
+    }
+    for (int ii = 0; ii < 100; ii += 2) {
+        values.Remove(handles[ii]);
+    }
+    EXPECT_EQ(50u, values.Size());
+
+    int sum = 0;
+    for (int value : values) {
+        sum += value;
+    }
+    EXPECT_EQ(2500, sum);
+    for (int ii = 1; ii < 100; ii += 2) {
+        EXPECT_EQ(ii, values[handles[ii]]);
+    }
+    for (size_t ii = 0; ii < values.Size(); ++ii) {
+        EXPECT_EQ(values.Data()[ii], values[values.HandleAt(ii)]);
+    }
+
+    values.Clear();
+    EXPECT_TRUE(values.Empty());
+    EXPECT_EQ(nullptr, values.Get(handles[1]));
+}
+
+}  // namespace
@@ -0,0 +1,45 @@
+#include "core/string-id.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(StringIdTest, LiteralsHashAtCompileTime)
+{
+    constexpr StringId kCube = "cube";
+    static_assert(kCube.Hash() == Fnv1a64("cube", 4), "Literal ids are constant expressions");
+    static_assert(kCube != StringId("grid"), "Different names give different ids");
+
+    //! Published FNV-1a 64 test vectors.
+    static_assert(Fnv1a64("", 0) == 0xcbf29ce484222325ull, "FNV offset basis");
+    static_assert(Fnv1a64("a", 1) == 0xaf63dc4c8601ec8cull, "FNV-1a of 'a'");
+    EXPECT_EQ(StringId(), StringId::FromHash(0));
+}
+
+TEST(StringIdTest, RuntimeStringsMatchLiterals)
+{
+    string const   name = string("prim") + "itives";
+    StringId const id(name);
+    EXPECT_EQ(StringId("primitives"), id);
+    EXPECT_EQ(hash<StringId>{}(id), static_cast<size_t>(id.Hash()));
+}
+
+TEST(StringIdTest, RuntimeStringsAreInterned)
+{
+    StringId const id(string_view("steel"));
+#if PHYSIKA_STRING_ID_NAMES
+    EXPECT_STREQ("steel", id.Name());
+    //! A literal id finds the name interned by the runtime id.
+    EXPECT_STREQ("steel", StringId("steel").Name());
+#else
+    EXPECT_STREQ("<unnamed>", id.Name());
+#endif
+    EXPECT_STREQ("<unnamed>", StringId("never interned").Name());
+}
+
+}  // namespace
@@ -0,0 +1,113 @@
+#include "core/task-graph.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+using TaskId = TaskGraph::TaskId;
+
+TEST(TaskGraphTest, DependenciesFollowResourceHazards)
+{
+    JobSystem jobs(1);
+    TaskGraph graph(jobs);
+
+    auto const camera    = graph.AddResource("Camera");
+    auto const constants = graph.AddResource("Constants");
+    auto const lights    = graph.AddResource("Lights");
+
+    TaskId const simulate = graph.AddTask("Simulate", []() {}, {}, { camera });
+    TaskId const copy     = graph.AddTask("CopyLights", []() {}, {}, { lights });
+    TaskId const pass     = graph.AddTask("PassConstants", []() {}, { camera, lights }, { constants });
+    TaskId const move     = graph.AddTask("MoveCamera", []() {}, {}, { camera });
+    TaskId const draw     = graph.AddTask("Draw", []() {}, { constants }, {});
+    graph.Compile();
+
+    EXPECT_TRUE(graph.Dependencies(simulate).empty());
+    EXPECT_TRUE(graph.Dependencies(copy).empty());
+    //! Read after write
+    EXPECT_EQ((vector<TaskId>{ simulate, copy }), graph.Dependencies(pass));
+    //! Write after write and write after read
+    EXPECT_EQ((vector<TaskId>{ simulate, pass }), graph.Dependencies(move));
+    EXPECT_EQ((vector<TaskId>{ pass }), graph.Dependencies(draw));
+    EXPECT_EQ(5u, graph.TaskCount());
+}
+
+TEST(TaskGraphTest, ExecuteRespectsDependencies)
+{
+    JobSystem jobs(3);
+    TaskGraph graph(jobs);
+
+    auto const data   = graph.AddResource("Data");
+    auto const result = graph.AddResource("Result");
+
+    atomic<int> sequence{ 0 };
+    int         order[4] = {};
+    graph.AddTask("Produce", [&]() { order[0] = sequence.fetch_add(1); }, {}, { data });
+    graph.AddTask("ReadA", [&]() { order[1] = sequence.fetch_add(1); }, { data }, {});
+    graph.AddTask("ReadB", [&]() { order[2] = sequence.fetch_add(1); }, { data }, {});
+    graph.AddTask("Combine", [&]() { order[3] = sequence.fetch_add(1); }, { data }, { result, data });
+
+    for (int frame = 0; frame < 200; ++frame) {
+        sequence.store(0);
+        graph.Execute();
+        ASSERT_EQ(4, sequence.load());
+        EXPECT_EQ(0, order[0]);
+        EXPECT_LT(order[1], order[3]);
+        EXPECT_LT(order[2], order[3]);
+        EXPECT_EQ(3, order[3]);
+    }
+}
+
+TEST(TaskGraphTest, IndependentTasksOverlap)
+{
+    JobSystem jobs(3);
+    TaskGraph graph(jobs);
+
+    auto const sleep = []() { this_thread::sleep_for(chrono::milliseconds(20)); };
+    for (int ii = 0; ii < 4; ++ii) {
+        graph.AddTask("Sleep", sleep, {}, { graph.AddResource("Independent") });
+    }
+    graph.Execute();
+
+    TaskGraphTimings const& timings = graph.LastTimings();
+    ASSERT_EQ(4u, timings.tasks.size());
+    //! Four threads sleep side by side; run serially it would take 80 ms.
+    EXPECT_LT(timings.frameMs, 70.0);
+    EXPECT_GE(timings.frameMs, 20.0);
+}
+
+TEST(TaskGraphTest, CriticalPathIsLongestChain)
+{
+    JobSystem jobs(2);
+    TaskGraph graph(jobs);
+
+    auto const sleep = [](int ms) { return [ms]() { this_thread::sleep_for(chrono::milliseconds(ms)); }; };
+    auto const a     = graph.AddResource("A");
+    auto const b     = graph.AddResource("B");
+    auto const c     = graph.AddResource("C");
+
+    TaskId const shortRoot = graph.AddTask("ShortRoot", sleep(1), {}, { a });
+    TaskId const longRoot  = graph.AddTask("LongRoot", sleep(30), {}, { b });
+    TaskId const join      = graph.AddTask("Join", sleep(5), { a, b }, { c });
+    TaskId const side      = graph.AddTask("Side", sleep(1), { a }, {});
+    graph.Execute();
+
+    TaskGraphTimings const& timings = graph.LastTimings();
+    EXPECT_FALSE(timings.tasks[shortRoot].critical);
+    EXPECT_TRUE(timings.tasks[longRoot].critical);
+    EXPECT_TRUE(timings.tasks[join].critical);
+    EXPECT_FALSE(timings.tasks[side].critical);
+    EXPECT_NEAR(timings.tasks[longRoot].durationMs + timings.tasks[join].durationMs, timings.criticalPathMs, 1e-9);
+    EXPECT_GE(timings.tasks[join].startMs, timings.tasks[longRoot].startMs + timings.tasks[longRoot].durationMs);
+    EXPECT_LE(timings.criticalPathMs, timings.frameMs);
+}
+
+}  // namespace
@@ -167,4 +167,36 @@ TEST(TimerTest, CallStartStopStartStop)
     ASSERT_FLOAT_EQ(0.0f, timer.TotalRunningTime());
 }
 
+TEST(TimerTest, EveryAvailableBackendMeasuresSleep)
+{
+    TimerBackend const backends[] = { TimerBackend::kDefault, TimerBackend::kQueryPerformanceCounter,
+                                      TimerBackend::kMonotonicRaw, TimerBackend::kSteadyClock,
+                                      TimerBackend::kInvariantTsc };
+    for (TimerBackend backend : backends) {
+        Timer timer(backend);
+        EXPECT_EQ(ResolveTimerBackend(backend), timer.Backend());
+        if (IsTimerBackendAvailable(backend) && backend != TimerBackend::kDefault) {
+            EXPECT_EQ(backend, timer.Backend());
+        }
+        EXPECT_GT(TicksPerSecond(timer.Backend()), 0);
+
+        timer.Start();
+        this_thread::sleep_for(chrono::milliseconds(200));
+        timer.Tick();
+        EXPECT_NEAR(0.2, timer.DeltaSeconds(), kEpsilon);
+        EXPECT_DOUBLE_EQ(timer.DeltaSeconds(), timer.TotalRunningTimeSeconds());
+    }
+}
+
+TEST(TimerTest, ReadTicksIsMonotonic)
+{
+    TimerBackend const backend  = ResolveTimerBackend(TimerBackend::kDefault);
+    int64_t            previous = ReadTicks(backend);
+    for (int ii = 0; ii < 1000; ++ii) {
+        int64_t const current = ReadTicks(backend);
+        ASSERT_GE(current, previous);
+        previous = current;
+    }
+}
+
 }  // namespace
\ No newline at end of file
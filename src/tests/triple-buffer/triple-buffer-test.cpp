@@ -0,0 +1,130 @@
+#include "core/triple-buffer.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "core/application-headless.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::core;
+
+TEST(TripleBufferTest, ReaderSeesNewestPublishedSnapshot)
+{
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Acquire());
+
+    buffer.WriteBuffer() = 1;
+    buffer.Publish();
+    buffer.WriteBuffer() = 2;
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Acquire());
+    EXPECT_EQ(2, buffer.ReadBuffer());
+
+    //! Nothing new: the reader keeps its snapshot.
+    EXPECT_FALSE(buffer.Acquire());
+    EXPECT_EQ(2, buffer.ReadBuffer());
+
+    buffer.WriteBuffer() = 3;
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Acquire());
+    EXPECT_EQ(3, buffer.ReadBuffer());
+}
+
+struct Snapshot
+{
+    uint64_t sequence = 0;
+    uint64_t check    = 0;
+};
+
+TEST(TripleBufferTest, SnapshotsStayWholeAcrossThreads)
+{
+    uint64_t const kSnapshots = 200000;
+
+    TripleBuffer<Snapshot> buffer;
+    thread                 writer([&buffer, kSnapshots]() {
+        for (uint64_t ii = 1; ii <= kSnapshots; ++ii) {
+            Snapshot& snapshot = buffer.WriteBuffer();
+            snapshot.sequence  = ii;
+            snapshot.check     = ii * 7919;
+            buffer.Publish();
+        }
+    });
+
+    uint64_t last = 0;
+    while (last < kSnapshots) {
+        if (buffer.Acquire()) {
+            Snapshot const& snapshot = buffer.ReadBuffer();
+            ASSERT_EQ(snapshot.sequence * 7919, snapshot.check);
+            ASSERT_GT(snapshot.sequence, last);
+            last = snapshot.sequence;
+        } else {
+            this_thread::yield();
+        }
+    }
+    writer.join();
+}
+
+class SplitApp : public ApplicationHeadless
+{
+public:
+    SplitApp() : ApplicationHeadless("split", 1, 1) {}
+
+    void OnSimulate() override
+    {
+        mSimulationThread = this_thread::get_id();
+        mTicks += 1;
+        mSnapshots.WriteBuffer() = mTicks;
+        mSnapshots.Publish();
+    }
+
+    void OnRender() override
+    {
+        mRenderThread = this_thread::get_id();
+        if (mSnapshots.Acquire()) {
+            EXPECT_GE(mSnapshots.ReadBuffer(), mLastRendered);
+            mLastRendered = mSnapshots.ReadBuffer();
+        }
+    }
+
+    TripleBuffer<uint64_t> mSnapshots;
+    uint64_t               mTicks        = 0;
+    uint64_t               mLastRendered = 0;
+    thread::id             mSimulationThread;
+    thread::id             mRenderThread;
+};
+
+TEST(TripleBufferTest, SplitUpdateRunsSimulationOnItsOwnThread)
+{
+    SplitApp app;
+    app.SetSplitUpdate(true);
+    app.SetTargetFrameRate(500.0);
+    app.SetSimulationRate(1000.0);
+    app.SetFrameLimit(50);
+    app.Run();
+
+    EXPECT_EQ(50u, app.FrameCount());
+    EXPECT_EQ(app.mTicks, app.SimulationCount());
+    EXPECT_GT(app.mTicks, 0u);
+    EXPECT_GT(app.mLastRendered, 0u);
+    EXPECT_NE(app.mSimulationThread, app.mRenderThread);
+    EXPECT_EQ(this_thread::get_id(), app.mRenderThread);
+}
+
+TEST(TripleBufferTest, WithoutSplitUpdateBothRunOnTheFrameThread)
+{
+    SplitApp app;
+    app.SetFrameLimit(10);
+    app.Run();
+
+    EXPECT_EQ(10u, app.mTicks);
+    EXPECT_EQ(10u, app.mLastRendered);
+    EXPECT_EQ(this_thread::get_id(), app.mSimulationThread);
+    EXPECT_EQ(app.mSimulationThread, app.mRenderThread);
+}
+
+}  // namespace
@@ -0,0 +1,72 @@
+#include "renderer/vertex-packing.h"
+
+#include <math.h>
+#include <stdlib.h>  // abs
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace std;
+using namespace physika::renderer;
+using DirectX::XMFLOAT2;
+using DirectX::XMFLOAT3;
+using DirectX::XMFLOAT4;
+
+//! The six axes, the twelve edge diagonals and the eight corner diagonals, as both normal and tangent.
+MeshData CreateAxesAndDiagonals()
+{
+    MeshData mesh;
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int z = -1; z <= 1; ++z) {
+                if (x == 0 && y == 0 && z == 0) {
+                    continue;
+                }
+                float const    length = sqrtf(float(x * x + y * y + z * z));
+                XMFLOAT3 const direction(x / length, y / length, z / length);
+                mesh.AddVertex(direction, direction, direction, XMFLOAT2(0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+            }
+        }
+    }
+    return mesh;
+}
+
+TEST(VertexPackingTest, OctahedralErrorOfAxesAndDiagonalsIsWithinBound)
+{
+    MeshData const mesh = CreateAxesAndDiagonals();
+    ASSERT_EQ(26u, mesh.VertexCount());
+
+    PackingReport                      report;
+    PackedMeshData<PackedVertex> const packed = PackMeshData<PackedVertex>(mesh, &report);
+    ASSERT_EQ(mesh.VertexCount(), packed.VertexCount());
+    EXPECT_LE(report.maxNormalErrorDegrees, kMaxOctahedralErrorDegrees);
+    EXPECT_LE(report.maxTangentErrorDegrees, kMaxOctahedralErrorDegrees);
+
+    PackMeshData<QuantizedVertex>(mesh, &report);
+    EXPECT_LE(report.maxNormalErrorDegrees, kMaxOctahedralErrorDegrees);
+    EXPECT_LE(report.maxTangentErrorDegrees, kMaxOctahedralErrorDegrees);
+}
+
+TEST(VertexPackingTest, AxesLandOnOctahedronCorners)
+{
+    MeshData mesh;
+    mesh.AddVertex(XMFLOAT3(), XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT2(), XMFLOAT4());
+    mesh.AddVertex(XMFLOAT3(), XMFLOAT3(0.0f, -1.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, -1.0f), XMFLOAT2(), XMFLOAT4());
+
+    PackingReport                      report;
+    PackedMeshData<PackedVertex> const packed = PackMeshData<PackedVertex>(mesh, &report);
+    //! +z is the center, the equator the diamond's edge and -z its folded corners.
+    EXPECT_EQ(0, packed.vertices[0].normal.x);
+    EXPECT_EQ(0, packed.vertices[0].normal.y);
+    EXPECT_EQ(32767, packed.vertices[0].tangent.x);
+    EXPECT_EQ(0, packed.vertices[0].tangent.y);
+    EXPECT_EQ(0, packed.vertices[1].normal.x);
+    EXPECT_EQ(-32767, packed.vertices[1].normal.y);
+    EXPECT_EQ(32767, abs(packed.vertices[1].tangent.x));
+    EXPECT_EQ(32767, abs(packed.vertices[1].tangent.y));
+    EXPECT_FLOAT_EQ(0.0f, report.maxNormalErrorDegrees);
+    EXPECT_FLOAT_EQ(0.0f, report.maxTangentErrorDegrees);
+}
+
+}  // namespace
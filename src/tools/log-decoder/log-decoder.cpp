@@ -0,0 +1,61 @@
+// Converts a binary log written by logger::EnableBinaryLogging to text.
+//
+// Usage: log-decoder [--timestamps] <binary-log> [output.txt]
+// Text goes to stdout when no output file is given.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/logger.h"
+
+namespace {
+
+void PrintUsage()
+{
+    fprintf(stderr, "Usage: log-decoder [--timestamps] <binary-log> [output.txt]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bool        printTimestamps = false;
+    char const* inputPath       = nullptr;
+    char const* outputPath      = nullptr;
+
+    for (int ii = 1; ii < argc; ++ii) {
+        if (strcmp(argv[ii], "--timestamps") == 0) {
+            printTimestamps = true;
+        } else if (!inputPath) {
+            inputPath = argv[ii];
+        } else if (!outputPath) {
+            outputPath = argv[ii];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (!inputPath) {
+        PrintUsage();
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if (outputPath) {
+        output = fopen(outputPath, "w");
+        if (!output) {
+            fprintf(stderr, "Could not open %s for writing\n", outputPath);
+            return 1;
+        }
+    }
+
+    bool const decoded = physika::core::logger::DecodeBinaryLog(inputPath, output, printTimestamps);
+    if (output != stdout) {
+        fclose(output);
+    }
+    if (!decoded) {
+        fprintf(stderr, "Could not decode %s\n", inputPath);
+        return 1;
+    }
+    return 0;
+}